@@ -15,7 +15,8 @@ class CatalogManager {
   ~CatalogManager();
 
   // Create table: allocate page, create heap, register
-  TableInfo* CreateTable(const std::string& name, const Schema& schema);
+  TableInfo* CreateTable(const std::string& name, const Schema& schema,
+                         TableLayout layout = TableLayout::ROW);
 
   // Get table
   TableInfo* GetTable(const std::string& name);
@@ -29,8 +30,15 @@ class CatalogManager {
   std::vector<std::string> GetTableNames() const;
 
   BufferPoolManager* GetBPM() const { return bpm_; }
+  DiskManager* GetDiskManager() const { return disk_manager_; }
+
+  // Persist catalog (e.g. table stats changed by DML)
+  bool Flush();
 
  private:
+  // Load (or create) the dictionary page chains of the table's encoded columns
+  bool AttachDictionaries(table_id_t table_id, const Schema& schema);
+
   BufferPoolManager* bpm_;
   DiskManager* disk_manager_;
   CatalogMeta* catalog_meta_;
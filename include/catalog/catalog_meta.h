@@ -35,7 +35,8 @@ class CatalogMeta {
   std::unordered_map<table_id_t, std::unique_ptr<TableInfo>> tid2tbinfo_;
   std::unordered_map<std::string, table_id_t> tname2tid_;
   table_id_t next_table_id_{0};
-  static constexpr uint32_t CATALOG_VERSION = 1;
+  // 3: 增加表统计信息  4: 字典编码列  5: 字典移到表文件的字典页里
+  static constexpr uint32_t CATALOG_VERSION = 5;
 };
 
 }  // namespace bustub
\ No newline at end of file
@@ -6,11 +6,14 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include "type/type_id.h"
 
 namespace bustub {
+class Dictionary;
+
 class Column {
   friend class Schema;
 
@@ -25,12 +28,29 @@ class Column {
   std::string GetName() const { return name_; }
   TypeId GetType() const { return type_; }
   uint32_t GetStorageSize() const { return storage_size_; }
-  uint32_t GetOffset() const { return column_offset_; }   
+  uint32_t GetOffset() const { return column_offset_; }
+  uint32_t GetFixedLength() const { return fixed_length_; }
+
+  // 是否定长：定长列的值直接放在定长区，变长列在定长区只放一个偏移
+  // 字典编码的 VARCHAR 在定长区放 4 字节编码，也算定长
+  bool IsInlined() const {
+    return type_ != TypeId::VARCHAR || dictionary_ != nullptr;
+  }
+
+  // 字典编码：只对 VARCHAR 有效，必须在构造 Schema 之前设置
+  void SetDictionary(std::shared_ptr<Dictionary> dictionary) {
+    dictionary_ = std::move(dictionary);
+  }
+  Dictionary* GetDictionary() const { return dictionary_.get(); }
+  bool IsDictEncoded() const { return dictionary_ != nullptr; }
 
  private:
   std::string name_;
   TypeId type_;
-  uint32_t column_offset_;
-  uint32_t storage_size_; // 列在tuple中的偏移
+  uint32_t column_offset_;  // 列在 tuple 定长区中的偏移
+  uint32_t storage_size_;   // 定长列为值宽度，变长列为声明的最大长度
+  uint32_t fixed_length_;   // 列在定长区占用的字节数
+  // 字典编码列的字典，Schema 拷贝之间共享同一个字典
+  std::shared_ptr<Dictionary> dictionary_;
 };
 }  // namespace bustub
\ No newline at end of file
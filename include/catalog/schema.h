@@ -28,7 +28,7 @@ class Schema {
     return static_cast<uint32_t>(columns_.size());
   }
 
-  // 获取总大小
+  // 获取定长区总大小 (变长列只计其偏移槽)
   uint32_t GetStorageSize() const { return storage_size_; }
 
   // 是否全定长
@@ -40,7 +40,7 @@ class Schema {
  private:
   std::string name_;
   std::vector<Column> columns_;
-  uint32_t storage_size_;  // 需要的总大小
+  uint32_t storage_size_;  // 定长区的总大小
   bool is_inlined_;        // 是否全为定长列
 };
 
@@ -3,21 +3,26 @@
 
 #include "catalog/schema.h"
 #include "common/config.h"
+#include "storage/table/table_stats.h"
 
 namespace bustub {
 class TableInfo {
  public:
   TableInfo(table_id_t tid, std::string name, Schema schema,
-            page_id_t first_page_id);
+            page_id_t directory_page_id);
   table_id_t GetId() const;
   const std::string& GetName() const;
   const Schema& GetSchema() const;
-  page_id_t GetFirstPageId() const;
+  // 页目录链首，TableHeap 据此打开表
+  page_id_t GetDirectoryPageId() const;
+  // 统计信息，打开 TableHeap 时传进去由它增量维护
+  TableStats* GetStats() { return &stats_; }
 
  private:
   table_id_t tid_;
   std::string name_;
   Schema schema_;
-  page_id_t first_page_id_;
+  page_id_t directory_page_id_;
+  TableStats stats_;
 };
 }  // namespace bustub
\ No newline at end of file
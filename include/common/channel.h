@@ -1,11 +1,14 @@
 /*
   线程安全阻塞队列
+  capacity 不为 0 时是有界队列：队列满了 Put 阻塞，生产者跑得再快也只能领先消费者
+  capacity 个元素 (反压)。消费者提前不读了就 Close，阻塞的和之后的 Put 都返回 false。
 */
 
 
 #pragma once
 
 #include <condition_variable>
+#include <cstddef>
 #include <mutex>
 #include <queue>
 #include <utility>
@@ -13,11 +16,20 @@ namespace bustub {
 template <typename Tp_>
 class Channel {
  public:
-  // producer
-  void Put(Tp_ elem) {
+  explicit Channel(std::size_t capacity = 0) : capacity_(capacity) {}
+
+  // producer，通道已关闭时丢掉 elem 返回 false
+  bool Put(Tp_ elem) {
     std::unique_lock<std::mutex> lock(mutex_);  // lock the queue
-    queue_.push(std::move(elem));               // some class could not copy
+    not_full_.wait(lock, [&]() {
+      return closed_ || capacity_ == 0 || queue_.size() < capacity_;
+    });
+    if (closed_) {
+      return false;
+    }
+    queue_.push(std::move(elem));  // some class could not copy
     cv_.notify_one();
+    return true;
   }
   // consummer
   Tp_ Get() {
@@ -25,12 +37,22 @@ class Channel {
     cv_.wait(lock, [&]() { return !queue_.empty(); });  // wait until true
     Tp_ elem = std::move(queue_.front());
     queue_.pop();
+    not_full_.notify_one();
     return elem;  // auto move / NRVO
   }
+  // 消费者不再读了：唤醒阻塞的生产者，之后的 Put 都失败
+  void Close() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_full_.notify_all();
+  }
 
  private:
   std::queue<Tp_> queue_;
   std::mutex mutex_;
   std::condition_variable cv_;
+  std::condition_variable not_full_;
+  std::size_t capacity_;
+  bool closed_ = false;
 };
-}  // namespace bustub
\ No newline at end of file
+}  // namespace bustub
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace bustub {
@@ -41,4 +42,18 @@ static constexpr uint32_t INVALID_OFFSET = -1;
 // 起始页 id
 static constexpr page_id_t HEADER_PAGE_ID = 0;
 
+// tuple 超过该大小时，把最长的变长值挪到溢出页 (TOAST)
+static constexpr uint32_t TUPLE_TOAST_THRESHOLD = PAGE_SIZE / 4;
+
+// 会溢出的算子 (hash join / 排序 / 聚合) 默认可用的内存，超过后溢出到临时文件
+static constexpr std::size_t OPERATOR_MEMORY_LIMIT = 64 * 1024 * 1024;
+// 并行执行的默认线程数，0 表示用 CPU 核数
+static constexpr uint32_t DEFAULT_PARALLELISM = 0;
+// 并行扫描时每个 morsel (一个任务) 的数据页数
+static constexpr std::size_t MORSEL_PAGES = 16;
+// exchange 每个通道最多缓存的批数，满了生产者阻塞
+static constexpr std::size_t EXCHANGE_QUEUE_BATCHES = 8;
+// 表的页格式：ROW 为行式 slotted page，PAX 为页内按列分组 (只支持全定长列)
+enum class TableLayout : uint32_t { ROW = 0, PAX = 1 };
+
 }  // namespace bustub
\ No newline at end of file
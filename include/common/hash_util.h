@@ -0,0 +1,75 @@
+/*
+  哈希工具：64 位混合函数、字节串哈希、多列哈希的组合
+  哈希 join / 聚合 / DISTINCT / 哈希索引共用，不持久化，换算法不影响磁盘格式。
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace bustub {
+
+class HashUtil {
+ public:
+  // NULL 的哈希值 (所有类型共用)
+  static constexpr uint64_t NULL_HASH = 0x6A09E667F3BCC909ULL;
+
+  // splitmix64 的终结函数：每个输入位都会影响全部输出位
+  static inline uint64_t Mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+  }
+
+  // 128 位乘法后高低位异或 (wyhash 的 mum)
+  static inline uint64_t MulFold(uint64_t a, uint64_t b) {
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+  }
+
+  // 整数统一按 int64 哈希，INTEGER / BIGINT / DATE 的同一个数哈希相同
+  static inline uint64_t HashInt(int64_t val) {
+    return Mix64(static_cast<uint64_t>(val));
+  }
+
+  static inline uint64_t HashDouble(double val) {
+    if (val == 0) val = 0;  // -0.0 和 0.0 相等，哈希也要相等
+    uint64_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return Mix64(bits ^ 0x3C6EF372FE94F82BULL);
+  }
+
+  // 字节串：每次吃 8 字节，结尾不足 8 字节的补 0，长度参与混合
+  static inline uint64_t HashBytes(const char *data, std::size_t len) {
+    uint64_t h = MulFold(len ^ K0, K1);
+    while (len >= 8) {
+      uint64_t word;
+      std::memcpy(&word, data, sizeof(word));
+      h = MulFold(h ^ word, K1);
+      data += 8;
+      len -= 8;
+    }
+    if (len > 0) {
+      uint64_t word = 0;
+      std::memcpy(&word, data, len);
+      h = MulFold(h ^ word, K1);
+    }
+    return Mix64(h);
+  }
+
+  // 多列 key：逐列把新列的哈希组合进去 (与顺序有关)
+  static inline uint64_t CombineHashes(uint64_t left, uint64_t right) {
+    return MulFold(left ^ K0, right ^ K1);
+  }
+
+ private:
+  static constexpr uint64_t K0 = 0xA0761D6478BD642FULL;
+  static constexpr uint64_t K1 = 0xE7037ED1A0B428DBULL;
+};
+
+}  // namespace bustub
@@ -0,0 +1,69 @@
+/*
+  work-stealing 线程池
+
+  每个 worker 有自己的任务双端队列：自己从队尾取 (后进先出，刚放进去的数据还在缓存里)，
+  自己的队列空了就从别的 worker 的队头偷 (先进先出，偷走最早、通常最大的一块活)。
+  任务按轮转分到各个队列，哪个 worker 先干完就去帮别人，不用事先把活分匀。
+  队列用各自的互斥锁保护，任务粒度是一个 morsel (几十页)，锁的开销可以忽略。
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  // num_threads 为 0 时用 CPU 核数
+  explicit ThreadPool(uint32_t num_threads);
+  ~ThreadPool();
+  DISALLOW_COPY_AND_MOVE(ThreadPool);
+
+  uint32_t GetThreadCount() const {
+    return static_cast<uint32_t>(workers_.size());
+  }
+
+  // 当前线程在池里的编号 (0 .. 线程数-1)，不是池里的线程返回 -1
+  static int CurrentWorker();
+
+  /**
+   * 执行一组任务并等它们全部完成，任务里抛出的第一个异常在这里重新抛出。
+   * 任务可以用 CurrentWorker() 找到自己的线程局部状态。
+   * 不能在池里的线程上调用 (会等自己)。
+   */
+  void RunAll(std::vector<Task> tasks);
+
+ private:
+  struct WorkQueue {
+    std::mutex latch_;
+    std::deque<Task> tasks_;
+  };
+
+  void WorkerLoop(uint32_t index);
+  bool PopLocal(uint32_t index, Task* task);
+  bool Steal(uint32_t index, Task* task);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  // 空闲的 worker 在这里等新任务
+  std::mutex idle_latch_;
+  std::condition_variable idle_cv_;
+  std::atomic<uint64_t> queued_{0};  // 还在队列里的任务数
+  bool stop_ = false;
+};
+
+}  // namespace bustub
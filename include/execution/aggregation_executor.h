@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/executor.h"
+#include "execution/expression.h"
+#include "execution/spill_file.h"
+#include "execution/table_scan_executor.h"
+#include "type/value.h"
+
+namespace hsql {
+struct Expr;
+}
+
+namespace bustub {
+
+enum class AggregationType { COUNT_STAR, COUNT, SUM, MIN, MAX, AVG };
+
+/**
+ * AggregationExecutor 实现 GROUP BY 和聚合函数 COUNT(*) / COUNT / SUM / MIN / MAX / AVG。
+ * SELECT 列表的每一项要么是一个聚合函数 (参数是任意表达式)，要么是只引用
+ * GROUP BY 列的表达式；输出 schema 就是 SELECT 列表。
+ * 分组用开放寻址 (线性探测) 的哈希表，key 是 GROUP BY 表达式的规范化编码
+ * (NULL 自成一组)，每组存一行代表行 (求非聚合的输出项) 和各聚合的状态。
+ * 哈希表超过 ExecutionContext::memory_limit_ 后不再建新组：已有的组继续在内存里累加，
+ * 其余行按 key 的哈希写进 NUM_PARTITIONS 个分区，内存里的组输出完再逐个分区聚合
+ * (分区仍然放不下时同样处理，最多 MAX_PARTITION_DEPTH 层)。
+ * 没有 GROUP BY 时总是输出一行 (空输入 COUNT 为 0，其余为 NULL)。
+ *
+ * 给了并行数据源且 ExecutionContext 有多个线程时按 morsel 并行聚合：表按 MORSEL_PAGES
+ * 页切成 morsel，最多 页数 / MORSEL_PAGES 个线程各用自己的一份扫描流水线和局部哈希表
+ * (内存预算按线程数均分) 轮流领取 morsel，全部完成后把局部表合并进全局表
+ * (不到两个 morsel 的表仍然串行)；
+ * 局部表溢出的行在合并之后按串行的方式重新聚合一遍。
+ */
+class AggregationExecutor : public Executor {
+ public:
+  static constexpr uint32_t NUM_PARTITIONS = 32;
+  static constexpr uint32_t MAX_PARTITION_DEPTH = 3;
+
+  // 新建一份 "表扫描 -> ... -> 本算子的输入" 的流水线，scan 返回其中的表扫描
+  using PipelineFactory =
+      std::function<std::unique_ptr<Executor>(TableScanExecutor** scan)>;
+
+  /**
+   * @param select_list SELECT 列表
+   * @param group_by GROUP BY 列表，没有时为 nullptr
+   * @param input_schema 子执行器的输出 schema
+   */
+  AggregationExecutor(std::unique_ptr<Executor> child,
+                      const std::vector<hsql::Expr*>& select_list,
+                      const std::vector<hsql::Expr*>* group_by,
+                      const Schema* input_schema);
+
+  // SELECT 列表里有没有聚合函数
+  static bool HasAggregate(const std::vector<hsql::Expr*>& select_list);
+
+  /**
+   * HAVING 条件，要在 Init 之前设置。列名按输出列解析；其中的聚合函数
+   * 用 SELECT 列表里相同的聚合，没有的另外算一份 (不输出)。
+   */
+  void SetHaving(const hsql::Expr* having);
+
+  const Schema& GetOutputSchema() const { return *output_schema_; }
+
+  // 没有 GROUP BY、聚合全是 COUNT(*)：结果只取决于行数
+  bool IsCountStarOnly() const;
+  // 直接给出输入行数 (表统计)，Init 时不再扫描子执行器
+  void SetInputRowCount(uint64_t rows) { input_rows_ = rows; }
+
+  /**
+   * 并行数据源：每个线程用 factory 建一份和子执行器等价的流水线，
+   * 各自扫描分到的页范围。没有线程池时仍然只用子执行器。
+   */
+  void SetParallelSource(PipelineFactory factory) {
+    pipeline_factory_ = std::move(factory);
+  }
+
+  void Init(ExecutionContext* exec_ctx) override;
+
+  bool Next(Tuple* tuple) override;
+
+  // push 执行：子树的流水线以本算子为终点，收完以后本算子是下一条流水线的数据源
+  // (push 方式不走并行数据源)
+  void BuildPipeline(PipelineBuilder* builder, const Schema* schema) override;
+  void OpenSink(ExecutionContext* exec_ctx) override;
+  void Sink(const DataChunk& chunk) override;
+  void FinishSink() override;
+  bool PushInputColumns(bool partial,
+                        std::vector<uint32_t>* cols) const override {
+    *cols = input_columns_;
+    return true;
+  }
+
+  // 执行统计：是否溢出、聚合过的分区数 (含再分区后的子分区)
+  bool IsSpilled() const { return spilled_; }
+  uint32_t GetAggregatedPartitions() const { return aggregated_partitions_; }
+
+ private:
+  struct Aggregate {
+    AggregationType type_;
+    std::unique_ptr<CompiledExpr> arg_;  // COUNT(*) 没有参数
+  };
+
+  // SELECT 列表的一项：第 index_ 个聚合，或者在代表行上求值的表达式
+  struct OutputItem {
+    bool is_aggregate_;
+    uint32_t index_;
+    std::unique_ptr<CompiledExpr> expr_;
+  };
+
+  struct AggState {
+    int64_t count_ = 0;  // 参与的行数 (COUNT(*) 是全部行，其余是非 NULL 的行)
+    int64_t int_sum_ = 0;
+    double double_sum_ = 0;
+    Value extreme_{TypeId::INVALID};  // MIN / MAX
+  };
+
+  // 开放寻址表的一个槽，group_ 为 NO_GROUP 表示空
+  struct Slot {
+    uint64_t hash_;
+    uint32_t group_;
+  };
+
+  struct Group {
+    uint64_t hash_;
+    uint32_t key_offset_;  // key 在 key_arena_ 里的位置
+    uint32_t key_len_;
+    Tuple row_;  // 代表行，只有非聚合输出项需要时才保存
+  };
+
+  // 一张分组哈希表，串行时只有一张，并行时每个线程还有一张局部表
+  struct GroupTable {
+    std::vector<Slot> slots_;
+    uint64_t slot_mask_ = 0;
+    std::vector<Group> groups_;
+    std::vector<AggState> states_;  // 第 g 组的状态在 [g * 聚合数, (g + 1) * 聚合数)
+    std::string key_arena_;
+    std::string key_buffer_;  // 当前行的 key
+    std::size_t bytes_ = 0;
+    std::vector<std::unique_ptr<SpillFile>> spill_;  // 溢出后写出的分区
+
+    uint32_t Find(const char* key, std::size_t len, uint64_t hash) const;
+    uint32_t Insert(const char* key, std::size_t len, uint64_t hash, Tuple row,
+                    std::size_t num_aggregates);
+    void Grow();
+    void Clear();
+  };
+
+  // 并行聚合时一个线程的状态
+  struct WorkerState {
+    std::unique_ptr<Executor> pipeline_;
+    TableScanExecutor* scan_ = nullptr;
+    std::unique_ptr<DataChunk> input_;
+    GroupTable table_;
+  };
+
+  // 溢出后待聚合的分区
+  struct Partition {
+    std::unique_ptr<SpillFile> rows_;
+    uint32_t depth_;
+  };
+
+  void BindAggregate(const hsql::Expr* item, const Schema* input_schema);
+  // HAVING 里的聚合函数在 having_schema_ 里的列号，需要时新增一个聚合
+  uint32_t BindHavingAggregate(const hsql::Expr* call,
+                               std::vector<Column>* columns);
+  Column AggregateColumn(std::string name, const Aggregate& agg,
+                         const Schema* input_schema) const;
+
+  /**
+   * 一行输入：在 table 里找到 (或新建) 组并累加；组不在表里且正在溢出时写进分区。
+   * 表超过 budget 字节后开始溢出，分区按第 depth 层的哈希位划分。
+   * 只读本算子的成员，不同线程可以同时对各自的表调用。
+   */
+  template <typename MakeTuple>
+  void Accumulate(GroupTable* table, uint32_t depth, std::size_t budget,
+                  const ExprInput& input, MakeTuple make_tuple) const;
+  static void Update(AggState* state, const Aggregate& agg,
+                     const ExprInput& input);
+  // 把同一组的另一份部分结果并进 into
+  static void Merge(AggState* into, const AggState& from, const Aggregate& agg);
+  void InsertEmptyGroup();
+
+  void ConsumeChild();
+  void ConsumeParallel();
+  void MergeTable(GroupTable* local);
+  void FinishLevel();
+  bool NextPartition();
+  static uint32_t PartitionOf(uint64_t hash, uint32_t depth);
+
+  Value Finalize(const AggState& state, const Aggregate& agg) const;
+
+  std::unique_ptr<Executor> child_;
+  const Schema* input_schema_;
+  std::vector<std::unique_ptr<CompiledExpr>> group_by_;
+  std::vector<Aggregate> aggregates_;
+  std::vector<OutputItem> outputs_;
+  std::unique_ptr<Schema> output_schema_;
+  std::vector<const hsql::Expr*> aggregate_calls_;  // 每个聚合对应的函数调用
+  // HAVING：按 "输出列 + having_aggregates_ 的结果" 这一行求值
+  std::unique_ptr<CompiledExpr> having_;
+  std::unique_ptr<Schema> having_schema_;
+  std::vector<uint32_t> having_aggregates_;
+  std::vector<uint32_t> input_columns_;  // 需要从子执行器读出的列
+  bool keep_row_ = false;                // 有非聚合输出项，要保存代表行
+  uint64_t input_rows_ = UINT64_MAX;     // 表统计给出的行数
+  PipelineFactory pipeline_factory_;     // 并行数据源，可为空
+
+  GroupTable table_;
+  std::size_t output_pos_ = 0;
+
+  // 溢出
+  bool spilled_ = false;
+  uint32_t depth_ = 0;              // 当前这一层的分区深度
+  std::vector<Partition> pending_;  // 待聚合的分区 (栈)
+  uint32_t aggregated_partitions_ = 0;
+  std::unique_ptr<DataChunk> input_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class BufferPoolManager;
+class Dictionary;
+
+/**
+ * ColumnVector 是 DataChunk 里的一列：最多 BATCH_SIZE 个值连续存放。
+ * - 定长类型：值槽就是 tuple 里的存储格式 (可以直接交给 ColumnHasher::HashFixed)
+ * - 字典编码 VARCHAR：值槽是 4 字节编码，比较/分组不用解码
+ * - 其他 VARCHAR：值槽是 {offset, len}，字节放在本列的 heap_ 里
+ * 第 i 位为 1 表示第 i 个值是 NULL (和 tuple 的 null bitmap 同一约定)。
+ */
+class ColumnVector {
+ public:
+  void Init(const Column& col, uint32_t capacity);
+  void Reset();
+
+  TypeId GetType() const { return type_; }
+  uint32_t GetWidth() const { return width_; }
+  Dictionary* GetDictionary() const { return dictionary_; }
+
+  const char* GetData() const { return data_.data(); }
+  const uint8_t* GetNullBitmap() const { return nulls_.data(); }
+  bool IsNull(uint32_t row) const {
+    return (nulls_[row >> 3] & (1 << (row % 8))) != 0;
+  }
+
+  // 写入第 row 个值，row 从 0 开始连续写
+  void SetNull(uint32_t row);
+  // storage 是 tuple 里的存储格式 (字典列为编码)
+  void SetRaw(uint32_t row, const char* storage);
+  void SetString(uint32_t row, const char* data, uint32_t len);
+  // 拷贝 src 的第 src_row 个值 (同一列类型)
+  void CopyValue(const ColumnVector& src, uint32_t src_row, uint32_t row);
+
+  // VARCHAR 的值 (字典列会解码)，view 在下一次 Reset 前有效
+  std::string_view GetString(uint32_t row) const;
+  Value GetValue(uint32_t row) const;
+
+ private:
+  struct StringRef {
+    uint32_t offset_;
+    uint32_t len_;
+  };
+
+  TypeId type_ = TypeId::INVALID;
+  uint32_t width_ = 0;
+  Dictionary* dictionary_ = nullptr;
+  std::vector<char> data_;
+  std::vector<uint8_t> nulls_;
+  std::string heap_;
+};
+
+/**
+ * DataChunk 是向量化执行 (NextBatch) 在算子之间传递的一批行，按列存放。
+ * 选择向量：过滤不搬数据，只把仍然有效的行号写进 selection_，
+ * 下游按 GetSelectedCount / GetSelectedRow 遍历。没有选择向量时全部行有效。
+ */
+class DataChunk {
+ public:
+  static constexpr uint32_t BATCH_SIZE = 1024;
+
+  explicit DataChunk(const Schema* schema);
+
+  // 清空行和选择向量，列的内存保留复用
+  void Reset();
+
+  const Schema* GetSchema() const { return schema_; }
+  uint32_t GetSize() const { return size_; }
+  bool IsFull() const { return size_ == BATCH_SIZE; }
+  ColumnVector& GetColumn(uint32_t col_idx) { return columns_[col_idx]; }
+  const ColumnVector& GetColumn(uint32_t col_idx) const {
+    return columns_[col_idx];
+  }
+  RID GetRid(uint32_t row) const { return rids_[row]; }
+
+  // 行格式 -> 列：定长值直接拷贝字节，溢出列需要 bpm
+  // 只填需要的列 (见 SetNeededColumns)，其余列的值没有定义
+  void AppendTuple(const Tuple& tuple, BufferPoolManager* bpm);
+  // 直接按列写：追加一行 (值由调用方写进各列)，返回行号
+  uint32_t AppendRow(RID rid) {
+    rids_[size_] = rid;
+    return size_++;
+  }
+  // 从同一 schema 的另一批拷贝一行 (按列拷贝，不经过 Tuple)，返回行号
+  uint32_t AppendRowFrom(const DataChunk& src, uint32_t src_row);
+
+  // 延迟物化：消费者只声明它要读的列，上游算子再补上自己要读的列 (如过滤列)，
+  // 没有声明的列不解码、不拷贝。默认全部列都需要，Reset 不清除这个设置
+  void SetNeededColumns(const std::vector<uint32_t>& cols);
+  void MarkNeeded(uint32_t col_idx) { needed_[col_idx] = true; }
+  bool IsNeeded(uint32_t col_idx) const { return needed_[col_idx]; }
+
+  // 选择向量
+  bool HasSelection() const { return has_selection_; }
+  uint32_t GetSelectedCount() const {
+    return has_selection_ ? selected_count_ : size_;
+  }
+  uint32_t GetSelectedRow(uint32_t i) const {
+    return has_selection_ ? selection_[i] : i;
+  }
+  // 有选择向量时返回它，否则返回 nullptr (表示 0..size)
+  const uint32_t* GetSelection() const {
+    return has_selection_ ? selection_.data() : nullptr;
+  }
+  // 写新选择向量用的缓冲区，写完调用 SetSelection
+  uint32_t* GetSelectionBuffer() { return selection_buffer_.data(); }
+  void SetSelection(uint32_t count);
+
+  // 行接口适配：第 row 行的一列 / 整行 (按 schema 重新拼成 Tuple，没读出的列为 NULL)
+  Value GetValue(uint32_t col_idx, uint32_t row) const;
+  Tuple GetTuple(uint32_t row) const;
+
+ private:
+  const Schema* schema_;
+  std::vector<ColumnVector> columns_;
+  std::vector<RID> rids_;
+  uint32_t size_ = 0;
+  std::vector<bool> needed_;
+
+  bool has_selection_ = false;
+  uint32_t selected_count_ = 0;
+  std::vector<uint32_t> selection_;
+  std::vector<uint32_t> selection_buffer_;
+};
+
+}  // namespace bustub
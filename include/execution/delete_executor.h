@@ -1,28 +1,38 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+
+#include "execution/data_chunk.h"
 #include "execution/executor.h"
+#include "storage/table/table_heap.h"
 
 namespace bustub {
 
 /**
- * DeleteExecutor 删除表中满足 WHERE 条件的行。
- * 支持：
- * - DELETE FROM table          （删除所有行，无 WHERE）
- * - DELETE FROM table WHERE ... （删除符合条件的行）
- *
- * 简化版：暂时仅支持无条件删除（expr == nullptr）。
- * WHERE 条件解析需要完整的表达式求值器，后续实现。
+ * DeleteExecutor 删除子执行器产出的行 (按 RID 标记删除)。
+ * - DELETE FROM table          子执行器是全表扫描
+ * - DELETE FROM table WHERE ... 子执行器是扫描 + 过滤
+ * 按批从子执行器取行，删除只要 RID，不解码任何列 (过滤列由过滤自己补上)。
+ * Next 执行整条语句，只返回一次 true；删掉的行数见 GetAffectedRows。
  */
 class DeleteExecutor : public Executor {
  public:
-  explicit DeleteExecutor(table_id_t table_id) : table_id_(table_id) {}
+  DeleteExecutor(std::unique_ptr<Executor> child, table_id_t table_id)
+    : child_(std::move(child)), table_id_(table_id) {}
 
   void Init(ExecutionContext* exec_ctx) override;
 
   bool Next(Tuple* tuple) override;
 
+  uint64_t GetAffectedRows() const { return affected_rows_; }
+
  private:
+  std::unique_ptr<Executor> child_;
   table_id_t table_id_;
+  std::unique_ptr<TableHeap> table_heap_;
+  std::unique_ptr<DataChunk> input_;
+  uint64_t affected_rows_ = 0;
   bool deleted_ = false;
 };
 
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/channel.h"
+#include "common/macros.h"
+#include "execution/executor.h"
+#include "execution/expression.h"
+
+namespace hsql {
+struct Expr;
+}
+
+namespace bustub {
+
+enum class ExchangeType {
+  GATHER,       // 所有生产者的输出汇到一个消费者
+  REPARTITION,  // 按分区 key 的哈希把每一行发给其中一个消费者
+  BROADCAST,    // 每一批都发给所有消费者
+};
+
+/**
+ * Exchange 把几条跑在各自线程上的生产者流水线和若干个消费者连起来，
+ * 流水线里的算子不用知道自己在并行执行。
+ * 每个生产者一个线程，第一个消费者 Init 时启动 (在生产者线程里 Init 生产者)。
+ * 行按 DataChunk 整批传递，每个消费者一条有界通道 (EXCHANGE_QUEUE_BATCHES 批)，
+ * 通道满了生产者阻塞。GATHER 直接转交生产者的批，不拷贝行；
+ * REPARTITION / BROADCAST 把选中的行按列拷到发往各消费者的批里。
+ * 多个消费者时每个消费者要在自己的线程里读，否则一条通道满了会卡住所有生产者。
+ * 生产者抛出的异常在消费者读到时重新抛出；
+ * Exchange 析构时关闭通道、等生产者线程退出 (消费者可以提前不读，比如 LIMIT)。
+ */
+class Exchange {
+ public:
+  /**
+   * @param producers 生产者流水线，输出 schema 都是 schema
+   * @param num_consumers 消费者个数，GATHER 只能是 1
+   * @param partition_by REPARTITION 的分区 key，按 schema 编译 (未知列等抛异常)
+   */
+  Exchange(ExchangeType type, std::vector<std::unique_ptr<Executor>> producers,
+           const Schema* schema, uint32_t num_consumers = 1,
+           const std::vector<hsql::Expr*>* partition_by = nullptr);
+  ~Exchange();
+  DISALLOW_COPY_AND_MOVE(Exchange);
+
+  /**
+   * 消费者要读的列，要在第一个消费者 Init 之前设置，不设置时全部列都需要。
+   * 生产者的批只填这些列 (加上分区 key 和过滤这类算子自己补上的列)，
+   * REPARTITION / BROADCAST 也只拷贝这些列
+   */
+  void SetNeededColumns(std::vector<uint32_t> cols);
+
+  const Schema* GetSchema() const { return schema_; }
+  uint32_t GetConsumerCount() const {
+    return static_cast<uint32_t>(channels_.size());
+  }
+
+ private:
+  friend class ExchangeExecutor;
+  using BatchChannel = Channel<std::unique_ptr<DataChunk>>;
+
+  // 启动生产者线程，只有第一次调用生效
+  void Start(ExecutionContext* exec_ctx);
+  void Produce(uint32_t producer);
+  // 把 chunk 里选中的行拷到发往各消费者的批里，返回 false 表示通道已关闭
+  bool Route(const DataChunk& chunk,
+             std::vector<std::unique_ptr<DataChunk>>* outputs,
+             std::string* key);
+  bool Send(uint32_t consumer, std::unique_ptr<DataChunk> chunk);
+  // 按 cols 设置需要的列的空批 (partial_columns_ 为 false 时全部列)
+  std::unique_ptr<DataChunk> NewChunk(const std::vector<uint32_t>& cols) const;
+  // 第 consumer 个消费者的下一批，生产者全部结束时返回 nullptr
+  std::unique_ptr<DataChunk> Receive(uint32_t consumer);
+
+  ExchangeType type_;
+  std::vector<std::unique_ptr<Executor>> producers_;
+  const Schema* schema_;
+  std::vector<std::unique_ptr<CompiledExpr>> partition_by_;
+  bool partial_columns_ = false;
+  std::vector<uint32_t> needed_columns_;    // 发给消费者的批要有的列
+  std::vector<uint32_t> producer_columns_;  // 再加上分区 key 用到的列
+
+  // 每个消费者一条通道，nullptr 是某个生产者结束的标记
+  std::vector<std::unique_ptr<BatchChannel>> channels_;
+  std::vector<uint32_t> finished_;  // 每个消费者已经收到的结束标记数
+
+  std::mutex latch_;  // 保护 started_ 和 error_
+  bool started_ = false;
+  std::exception_ptr error_;
+  ExecutionContext* exec_ctx_ = nullptr;
+  std::vector<std::thread> threads_;
+};
+
+/**
+ * ExchangeExecutor 是 Exchange 的一个消费端，可以放在任何执行器下面当子执行器。
+ */
+class ExchangeExecutor : public Executor {
+ public:
+  explicit ExchangeExecutor(std::shared_ptr<Exchange> exchange,
+                            uint32_t consumer = 0)
+    : exchange_(std::move(exchange)), consumer_(consumer) {}
+
+  void Init(ExecutionContext* exec_ctx) override;
+
+  bool Next(Tuple* tuple) override;
+
+  // 收到的批直接换进 chunk，不拷贝
+  bool NextBatch(DataChunk* chunk) override;
+
+ private:
+  std::shared_ptr<Exchange> exchange_;
+  uint32_t consumer_;
+  std::unique_ptr<DataChunk> current_;  // 行接口正在读的批
+  uint32_t current_pos_ = 0;
+};
+
+}  // namespace bustub
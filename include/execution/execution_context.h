@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstddef>
+
 #include "catalog/catalog_manager.h"
+#include "common/config.h"
+#include "common/thread_pool.h"
 
 namespace bustub {
 
@@ -10,9 +14,13 @@ namespace bustub {
  *
  * 作用：
  * - catalog_: 库表元数据管理，用于获取表 schema、流水号等信息
+ * - memory_limit_: 每个会溢出的算子可用的内存 (字节)
+ * - thread_pool_: 并行执行用的线程池，为空时串行执行
  */
 struct ExecutionContext {
   CatalogManager* catalog_;
+  std::size_t memory_limit_{OPERATOR_MEMORY_LIMIT};
+  ThreadPool* thread_pool_{nullptr};
 
   explicit ExecutionContext(CatalogManager* catalog) : catalog_(catalog) {}
 };
@@ -1,15 +1,26 @@
 #pragma once
 
+#include <cstddef>
+#include <vector>
+
+#include "execution/data_chunk.h"
 #include "execution/execution_context.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
+class Pipeline;
+class PipelineBuilder;
+
 /**
  * Executor 是火山模型中所有算子的基类。
  * 每个算子实现一个Pull-based的流水线：
  *   Init() -> 初始化资源
  *   Next(tuple) -> 获取下一条记录（返回 true/false 表示是否有记录）
+ *   NextBatch(chunk) -> 向量化接口，一次获取一批记录 (按列存放 + 选择向量)
+ * 同一次执行里只用其中一种接口，不要混用。
+ * 另外也可以用 push 方式执行 (见 execution/pipeline.h)：算子按自己在流水线里的角色
+ * (中间算子 / 终点) 实现下面的 push 接口，没有实现的算子整个当作数据源。
  */
 class Executor {
  public:
@@ -27,6 +38,62 @@ class Executor {
    */
   virtual bool Next(Tuple* tuple) = 0;
 
+  /**
+   * 获取下一批记录，chunk 的 schema 必须是本算子的输出 schema。
+   * 默认实现是行接口的适配：反复调用 Next 攒满一批，
+   * 只实现了 Next 的算子也能接到向量化的上游/下游。
+   * @return true 表示 chunk 里至少有一行被选中，false 表示没有更多记录了
+   */
+  virtual bool NextBatch(DataChunk* chunk) {
+    chunk->Reset();
+    Tuple tuple;
+    while (!chunk->IsFull() && Next(&tuple)) {
+      chunk->AppendTuple(tuple, exec_ctx_->catalog_->GetBPM());
+    }
+    return chunk->GetSize() > 0;
+  }
+
+  // ============ push 执行 ============
+
+  /**
+   * 把以本算子为根的子树接进 builder 正在拼的流水线，schema 是本算子的输出 schema。
+   * 默认把整棵子树当作流水线的数据源 (Init 后按 NextBatch 拉数据)。
+   */
+  virtual void BuildPipeline(PipelineBuilder* builder, const Schema* schema);
+
+  /**
+   * 作为流水线中间的算子：OpenOperator 相当于不 Init 子执行器的 Init；
+   * PushBatch 处理一批，结果交给 pipeline->Push(..., next)，
+   * 返回 false 表示不再需要输入；FinishOperator 在输入结束后输出剩下的结果。
+   */
+  virtual void OpenOperator(ExecutionContext* exec_ctx) {
+    exec_ctx_ = exec_ctx;
+  }
+  virtual bool PushBatch(DataChunk* chunk, Pipeline* pipeline,
+                         std::size_t next);
+  virtual bool FinishOperator(Pipeline* pipeline, std::size_t next) {
+    return true;
+  }
+
+  /**
+   * 作为流水线的终点 (pipeline breaker)：OpenSink 准备状态，Sink 收一批，
+   * FinishSink 在输入结束后收尾；之后本算子作为下一条流水线的数据源，
+   * 不再 Init，直接用 Next / NextBatch 输出结果。
+   */
+  virtual void OpenSink(ExecutionContext* exec_ctx) { exec_ctx_ = exec_ctx; }
+  virtual void Sink(const DataChunk& chunk);
+  virtual void FinishSink() {}
+
+  /**
+   * 作为中间算子或终点时要从输入批里读的列 (决定数据源解码哪些列)。
+   * partial / cols 是下游的需要 (partial 为 false 表示全部列)，
+   * 返回本算子之前的批要有的列，同样用返回 false 表示全部列。
+   */
+  virtual bool PushInputColumns(bool partial,
+                                std::vector<uint32_t>* cols) const {
+    return false;
+  }
+
  protected:
   ExecutionContext* exec_ctx_ = nullptr;
 };
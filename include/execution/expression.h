@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "storage/table/tuple.h"
+#include "type/type_id.h"
+#include "type/type_kernels.h"
+#include "type/value.h"
+
+namespace hsql {
+struct Expr;
+}
+
+namespace bustub {
+
+class BufferPoolManager;
+class DataChunk;
+
+/**
+ * ExprInput 是表达式求值时的一行：行格式的 Tuple，或者 DataChunk 里的第 row 行。
+ */
+class ExprInput {
+ public:
+  ExprInput(const Tuple* tuple, const Schema* schema, BufferPoolManager* bpm)
+    : tuple_(tuple), schema_(schema), bpm_(bpm) {}
+  ExprInput(const DataChunk* chunk, uint32_t row) : chunk_(chunk), row_(row) {}
+
+  Value GetValue(uint32_t col_idx) const;
+
+ private:
+  const Tuple* tuple_ = nullptr;
+  const Schema* schema_ = nullptr;
+  BufferPoolManager* bpm_ = nullptr;
+  const DataChunk* chunk_ = nullptr;
+  uint32_t row_ = 0;
+};
+
+/**
+ * "列 op 常量" 形式的比较，常量已经是列的类型。
+ * 过滤器识别出这种形式后可以走按列类型特化的快速路径。
+ */
+struct SimpleComparison {
+  uint32_t col_idx_;
+  CompareOp op_;
+  Value constant_{0};
+};
+
+/**
+ * CompiledExpr 是编译好的表达式树。
+ * Init 时由 ExprCompiler 从 hsql::Expr 编译一次：列名解析成列号，字面量转成目标类型，
+ * 每个节点的结果类型在编译期确定，常量子树在编译期折叠。求值时不再看 hsql::Expr。
+ * 布尔结果是 BOOLEAN 的 Value，NULL 表示 UNKNOWN (三值逻辑)。
+ */
+class CompiledExpr {
+ public:
+  explicit CompiledExpr(TypeId return_type) : return_type_(return_type) {}
+  virtual ~CompiledExpr() = default;
+
+  virtual Value Evaluate(const ExprInput& input) const = 0;
+
+  // 结果类型，NULL 字面量为 INVALID
+  TypeId GetReturnType() const { return return_type_; }
+  // 编译期已经折叠成常量
+  virtual bool IsConstant() const { return false; }
+  // 是否为 "列 op 常量"
+  virtual bool AsSimpleComparison(SimpleComparison* out) const { return false; }
+  // 是否就是一个列引用
+  virtual bool AsColumnRef(uint32_t* col_idx) const { return false; }
+  // 把引用到的列号追加到 cols (可能重复)，用来只解码需要的列
+  virtual void CollectColumns(std::vector<uint32_t>* cols) const {}
+
+  // WHERE 语义：只有 TRUE 通过，FALSE 和 NULL 都不通过
+  bool EvaluatePredicate(const ExprInput& input) const {
+    Value result = Evaluate(input);
+    return !result.IsNull() && result.GetAsBoolean();
+  }
+
+ protected:
+  TypeId return_type_;
+};
+
+/**
+ * ExprCompiler 把 WHERE / SELECT 列表里的 hsql::Expr 编译成 CompiledExpr。
+ * 支持：列引用、字面量、比较、AND / OR / NOT、+ - * / % 和取负、
+ *       IS [NOT] NULL、[NOT] IN (常量列表)、BETWEEN。
+ * 类型规则：
+ * - 数值之间按 INTEGER < BIGINT < DOUBLE 提升，DATE 和 TIMESTAMP 比较时提升成 TIMESTAMP
+ * - 常量和列比较时常量先转成列的类型 (如 '2024-01-31' 转 DATE)，数值转换必须无损
+ * - 常量转不成列的类型时这个比较恒为 FALSE，没有行能匹配
+ * - 整数运算结果为 BIGINT，溢出抛 OUT_OF_RANGE，除以零抛 DIVIDE_BY_ZERO
+ * 列名可以写成 表.列；join 的输出列名是 "表.列"，不带表名时按唯一的列名匹配。
+ * 未知列、有歧义的列、不支持的表达式、无法比较的类型在编译时抛异常。
+ */
+class ExprCompiler {
+ public:
+  static std::unique_ptr<CompiledExpr> Compile(const hsql::Expr* expr,
+                                               const Schema* schema);
+  // 子表达式已经算在 schema 的某一列里时 bind 返回列号 (否则返回 -1)，
+  // 编译成对那一列的引用，如 HAVING 里的聚合函数对应聚合的输出列
+  using Binder = std::function<int(const hsql::Expr*)>;
+  static std::unique_ptr<CompiledExpr> Compile(const hsql::Expr* expr,
+                                               const Schema* schema,
+                                               const Binder& bind);
+  // 两个类型比较/运算时的公共类型，没有返回 INVALID
+  static TypeId CommonType(TypeId left, TypeId right);
+  // 第 col_idx 列的列引用 (SELECT * 展开用)
+  static std::unique_ptr<CompiledExpr> CompileColumn(uint32_t col_idx,
+                                                     const Schema* schema);
+  // 表达式作为输出列时的列定义：列引用保留原列的 VARCHAR 长度，
+  // 算出来的 VARCHAR (和没有类型的 NULL) 用 DEFAULT_VARCHAR_LENGTH
+  static Column OutputColumn(std::string name, const CompiledExpr& expr,
+                             const Schema* input_schema);
+
+  // 表达式算出来的 VARCHAR 没有声明长度，给一个足够的上限
+  static constexpr uint32_t DEFAULT_VARCHAR_LENGTH = 255;
+};
+
+}  // namespace bustub
@@ -1,8 +1,12 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "execution/executor.h"
+#include "execution/expression.h"
+#include "type/type_kernels.h"
+#include "type/value.h"
 
 namespace hsql {
 struct Expr;
@@ -12,8 +16,10 @@ namespace bustub {
 
 /**
  * FilterExecutor 对来自子执行器的行进行过滤。
- * 简化版：仅支持简单的比较条件（列 = 常数、列 < 常数等）
- * 暂不支持复杂的布尔操作（AND、OR）
+ * WHERE 在 Init 时由 ExprCompiler 编译一次 (AND / OR / NOT、算术、IS NULL、IN、BETWEEN)；
+ * 单个 "列 op 常量" 的比较走按列类型特化的快速路径，其余按编译好的表达式树逐行求值。
+ * 子执行器是表扫描、比较的是整数列 (或字典编码列的 = / !=) 时，比较下推给扫描在页上做。
+ * 表达式无法编译 (未知列、类型不匹配) 时 Init 抛异常。
  */
 class FilterExecutor : public Executor {
  public:
@@ -25,13 +31,57 @@ class FilterExecutor : public Executor {
 
   bool Next(Tuple* tuple) override;
 
+  // 向量化：对整列做比较，只收窄 chunk 的选择向量，不拷贝行
+  bool NextBatch(DataChunk* chunk) override;
+
+  // push 执行：流水线中间的算子，和 NextBatch 一样就地收窄选择向量
+  void BuildPipeline(PipelineBuilder* builder, const Schema* schema) override;
+  void OpenOperator(ExecutionContext* exec_ctx) override;
+  bool PushBatch(DataChunk* chunk, Pipeline* pipeline,
+                 std::size_t next) override;
+  bool PushInputColumns(bool partial,
+                        std::vector<uint32_t>* cols) const override;
+
  private:
+  // 计划阶段：编译 WHERE；是单个比较时定下列号、常量和该列类型的比较内核
+  void BindFilter();
+  // 把快速路径的比较下推给子表扫描，成功后本算子不再重复检查
+  void PushDownFilter();
+  // 过滤一批：收窄 chunk 的选择向量，返回是否还有选中的行
+  bool FilterBatch(DataChunk* chunk) const;
   // 评估过滤表达式对给定元组是否为真
   bool EvaluateFilter(const Tuple& tuple);
+  // 对 chunk 里当前选中的行求值，选中的行号写进 sel_out，返回行数
+  uint32_t SelectBatch(const DataChunk& chunk, uint32_t* sel_out) const;
+  // 定长列：T 是值在 tuple 里的存储格式
+  template <typename T>
+  uint32_t SelectFixed(const ColumnVector& vec, const uint32_t* sel_in,
+                       uint32_t count, uint32_t* sel_out) const;
+  // 按 op_ 选比较函数，get(row) 读出第 row 行的值
+  template <typename T, typename Get>
+  uint32_t SelectByOp(const uint8_t* nulls, const uint32_t* sel_in,
+                      uint32_t count, Get get, const T& rhs,
+                      uint32_t* sel_out) const;
 
   std::unique_ptr<Executor> child_;
   hsql::Expr* filter_expr_;  // WHERE 条件
   const Schema* schema_;
+
+  // BindFilter 的结果
+  bool accept_all_ = true;   // 没有 WHERE 或条件恒为 TRUE
+  bool reject_all_ = false;  // 条件恒不为 TRUE，没有行能匹配
+  std::unique_ptr<CompiledExpr> predicate_;
+  std::vector<uint32_t> filter_columns_;  // WHERE 引用的列
+  // 快速路径："列 op 常量"
+  bool simple_ = false;
+  int col_idx_ = -1;
+  CompareOp op_ = CompareOp::EQ;
+  Value compare_val_{0};
+  const ValueKernels* kernels_ = nullptr;
+  // 字典编码列上的 = / !=：直接比较 tuple 里的 4 字节编码，不解码
+  bool compare_code_ = false;
+  uint32_t compare_code_val_ = 0;
+  uint32_t code_offset_ = 0;  // 编码在 tuple 里的字节偏移
 };
 
 }  // namespace bustub
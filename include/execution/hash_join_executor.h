@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/data_chunk.h"
+#include "execution/executor.h"
+#include "execution/expression.h"
+#include "execution/spill_file.h"
+
+namespace hsql {
+struct Expr;
+}
+
+namespace bustub {
+
+enum class JoinType { INNER, LEFT };
+
+/**
+ * HashJoinExecutor 实现等值 join (INNER / LEFT OUTER)。
+ * ON 条件按 AND 拆开：一边只引用左侧、一边只引用右侧的 = 作为 hash key，
+ * 其余各项作为残余条件在拼好的行上求值。至少要有一个等值 key。
+ * build 侧全部读进内存建哈希表，probe 侧逐行探测：
+ * - INNER 用哪一侧 build 由调用方决定 (选较小的一侧)
+ * - LEFT 总是用右侧 build、左侧 probe，没有匹配的左行补 NULL 输出
+ * key 里有 NULL 的行不参与匹配。
+ * build 侧超过 ExecutionContext::memory_limit_ 时改走 grace hash join：
+ * 两侧都按 key 的哈希分成 NUM_PARTITIONS 份写进临时文件，再逐个分区 join；
+ * 某个分区仍然放不下时换一组哈希位再分 (最多 MAX_PARTITION_DEPTH 层，之后不管预算)。
+ * 输出列：左侧列 + 右侧列。
+ */
+class HashJoinExecutor : public Executor {
+ public:
+  static constexpr uint32_t NUM_PARTITIONS = 32;
+  static constexpr uint32_t MAX_PARTITION_DEPTH = 3;
+
+  /**
+   * @param left_name / right_name 输出列名的前缀 "表." (表名或别名)，
+   *        为空表示这一侧的列名已经带了前缀 (它本身是 join 的输出)
+   * @param build_left 用左侧建哈希表，只对 INNER 有效
+   */
+  HashJoinExecutor(std::unique_ptr<Executor> left, const Schema* left_schema,
+                   const char* left_name, std::unique_ptr<Executor> right,
+                   const Schema* right_schema, const char* right_name,
+                   JoinType join_type, const hsql::Expr* condition,
+                   bool build_left);
+
+  const Schema& GetOutputSchema() const { return *output_schema_; }
+
+  void Init(ExecutionContext* exec_ctx) override;
+
+  bool Next(Tuple* tuple) override;
+
+  /**
+   * push 执行：build 侧的流水线以本算子为终点 (建哈希表)，
+   * probe 侧的批作为中间算子推过本算子。溢出时 probe 行先写进分区，
+   * 输入结束后 (FinishOperator) 再逐个分区 join 输出。
+   */
+  void BuildPipeline(PipelineBuilder* builder, const Schema* schema) override;
+  void OpenOperator(ExecutionContext* exec_ctx) override;
+  bool PushBatch(DataChunk* chunk, Pipeline* pipeline,
+                 std::size_t next) override;
+  bool FinishOperator(Pipeline* pipeline, std::size_t next) override;
+  void OpenSink(ExecutionContext* exec_ctx) override;
+  void Sink(const DataChunk& chunk) override;
+  void FinishSink() override;
+
+  // 执行统计：是否溢出、实际 join 过的分区数 (含再分区后的子分区)
+  bool IsSpilled() const { return spilled_; }
+  uint32_t GetJoinedPartitions() const { return joined_partitions_; }
+
+ private:
+  struct Side {
+    std::unique_ptr<Executor> child_;
+    const Schema* schema_;
+    std::vector<std::unique_ptr<CompiledExpr>> keys_;
+  };
+
+  // 哈希表的一项，同一个桶的项用 next_ 串起来
+  struct Entry {
+    uint64_t hash_;
+    uint32_t key_offset_;  // key 在 key_arena_ 里的位置
+    uint32_t key_len_;
+    uint32_t next_;
+  };
+
+  // 溢出后待 join 的一对分区
+  struct Partition {
+    std::unique_ptr<SpillFile> build_;
+    std::unique_ptr<SpillFile> probe_;
+    uint32_t depth_;
+  };
+
+  // ON 条件 -> key 对 + 残余条件
+  void BindCondition(const hsql::Expr* condition);
+  // 规范化的 key 字节串，有 NULL 返回 false
+  bool EncodeKey(const Side& side, const Tuple& tuple, std::string* key) const;
+  static uint32_t PartitionOf(uint64_t hash, uint32_t depth);
+
+  // build 侧一行：放进哈希表，超出预算时开始分区
+  void AddBuild(const Tuple& tuple);
+
+  // 内存哈希表
+  void AddBuildRow(const Tuple& tuple, const std::string& key, uint64_t hash);
+  void BuildBuckets();
+  void ClearTable();
+
+  // grace hash join
+  std::vector<Partition> NewPartitions(uint32_t depth);
+  void StartSpilling();
+  void PartitionProbeSide();
+  void PartitionProbeRow(const Tuple& tuple);
+  void RewindPartitions();
+  void Repartition(Partition* part);
+  bool NextPartition();
+
+  bool NextProbeRow(Tuple* tuple);
+  // 用 probe_ 开始一次探测，INNER 且 key 有 NULL 时返回 false
+  bool StartProbe();
+  // 当前 probe 行的下一条输出
+  bool NextMatch(Tuple* tuple);
+  // push 执行：攒一行输出，批满了交给下游
+  bool Emit(const Tuple& tuple, Pipeline* pipeline, std::size_t next);
+  bool Flush(Pipeline* pipeline, std::size_t next);
+  Tuple MakeOutput(const Tuple* build) const;
+
+  Side& BuildSide() { return build_left_ ? left_ : right_; }
+  Side& ProbeSide() { return build_left_ ? right_ : left_; }
+
+  Side left_;
+  Side right_;
+  JoinType join_type_;
+  bool build_left_;
+  std::unique_ptr<Schema> output_schema_;
+  std::vector<TypeId> key_types_;  // 两侧 key 比较时的公共类型
+  std::vector<std::unique_ptr<CompiledExpr>> residual_;
+
+  // 哈希表
+  std::vector<Tuple> build_rows_;
+  std::vector<Entry> entries_;
+  std::string key_arena_;
+  std::vector<uint32_t> buckets_;
+  uint64_t bucket_mask_ = 0;
+  std::size_t table_bytes_ = 0;
+  std::string key_buffer_;  // build / 分区时的 key
+
+  // 溢出
+  bool spilled_ = false;
+  std::vector<Partition> pending_;  // 待 join 的分区 (栈)
+  Partition current_;               // 正在 join 的分区
+  uint32_t joined_partitions_ = 0;
+
+  // probe 状态
+  bool has_probe_ = false;
+  bool probe_matched_ = false;
+  Tuple probe_;
+  std::vector<Value> probe_values_;
+  std::string probe_key_;
+  uint64_t probe_hash_ = 0;
+  uint32_t chain_ = 0;
+  std::unique_ptr<DataChunk> out_;  // push 执行的输出批
+};
+
+}  // namespace bustub
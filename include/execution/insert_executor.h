@@ -1,5 +1,6 @@
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "execution/executor.h"
@@ -13,7 +14,7 @@ namespace bustub {
 class InsertExecutor : public Executor {
  public:
   InsertExecutor(table_id_t table_id, std::vector<Value> values)
-    : table_id_(table_id), values_(values) {}
+    : table_id_(table_id), values_(std::move(values)) {}
 
   void Init(ExecutionContext* exec_ctx) override;
 
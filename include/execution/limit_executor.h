@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "execution/executor.h"
+
+namespace bustub {
+
+/**
+ * LimitExecutor 实现 LIMIT / OFFSET：跳过前 offset 行，再输出至多 limit 行。
+ * 够数以后不再向子执行器要数据，下面的扫描随之停止。
+ * 向量化路径按批收窄选择向量，不拷贝行。
+ */
+class LimitExecutor : public Executor {
+ public:
+  // 没有 LIMIT 只有 OFFSET 时 limit 传 UINT64_MAX
+  LimitExecutor(std::unique_ptr<Executor> child, uint64_t limit,
+                uint64_t offset)
+    : child_(std::move(child)), limit_(limit), offset_(offset) {}
+
+  void Init(ExecutionContext* exec_ctx) override;
+
+  bool Next(Tuple* tuple) override;
+
+  bool NextBatch(DataChunk* chunk) override;
+
+  // push 执行：流水线中间的算子，够数后让数据源停下
+  void BuildPipeline(PipelineBuilder* builder, const Schema* schema) override;
+  void OpenOperator(ExecutionContext* exec_ctx) override;
+  bool PushBatch(DataChunk* chunk, Pipeline* pipeline,
+                 std::size_t next) override;
+  bool PushInputColumns(bool partial,
+                        std::vector<uint32_t>* cols) const override {
+    return partial;
+  }
+
+ private:
+  // 按 OFFSET / LIMIT 收窄一批的选择向量，返回留下的行数
+  uint32_t Narrow(DataChunk* chunk);
+
+  std::unique_ptr<Executor> child_;
+  uint64_t limit_;
+  uint64_t offset_;
+  uint64_t skipped_ = 0;  // 已经跳过的行数
+  uint64_t emitted_ = 0;  // 已经输出的行数
+};
+
+}  // namespace bustub
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/data_chunk.h"
+#include "execution/executor.h"
+
+namespace bustub {
+
+/**
+ * push 执行的一条流水线：数据源 -> 若干中间算子 -> 终点。
+ * 数据源按批产出，每一批在一个循环里依次推过各个算子 (过滤、投影、LIMIT、join 探测)
+ * 到达终点 (聚合、排序、join 建表等 pipeline breaker，或者查询结果)，
+ * 算子之间不再一层层调用 NextBatch。
+ * 数据源可以是叶子执行器 (表扫描等，Init 后按 NextBatch 取数)，
+ * 也可以是上一条流水线的终点 (已经收完输入，直接输出结果)。
+ */
+class Pipeline {
+ public:
+  using OutputFn = std::function<bool(const DataChunk&)>;
+
+  /**
+   * 把 chunk 交给第 op 个中间算子，op 等于算子个数时交给终点。
+   * 中间算子处理完一批后用 Push(结果, 自己的序号 + 1) 交给下游。
+   * @return false 表示下游不再需要数据 (LIMIT 够数了)
+   */
+  bool Push(DataChunk* chunk, std::size_t op);
+
+ private:
+  friend class PipelineBuilder;
+  friend class PipelineExecutor;
+
+  void Run(ExecutionContext* exec_ctx);
+
+  Executor* source_ = nullptr;
+  const Schema* source_schema_ = nullptr;
+  bool init_source_ = true;          // 叶子数据源要先 Init
+  std::vector<Executor*> operators_;  // 从数据源到终点的顺序
+  Executor* sink_ = nullptr;         // 为空时是最后一条流水线，结果交给 output_
+  const OutputFn* output_ = nullptr;
+};
+
+/**
+ * PipelineBuilder 从执行器树的根往下走 (Executor::BuildPipeline)，
+ * 在 pipeline breaker 处把树切成几条流水线，并按依赖排好执行顺序
+ * (一条流水线的终点是另一条的数据源时，前者先执行)。
+ */
+class PipelineBuilder {
+ public:
+  // 当前流水线的中间算子：从上往下走时调用，越靠近数据源越晚加入
+  void AddOperator(Executor* op);
+  // 当前流水线的数据源，init 为 false 表示它是已经执行过的流水线的终点
+  void SetSource(Executor* source, const Schema* schema, bool init);
+  /**
+   * 以 sink 为终点拼一条新流水线，数据来自 child (输出 schema 为 child_schema)，
+   * 它排在当前流水线之前执行。
+   */
+  void AddChildPipeline(Executor* sink, Executor* child,
+                        const Schema* child_schema);
+
+ private:
+  friend class PipelineExecutor;
+
+  Pipeline* current_ = nullptr;
+  std::vector<std::unique_ptr<Pipeline>> pipelines_;  // 执行顺序
+};
+
+/**
+ * PipelineExecutor 用 push 方式执行一棵执行器树：建好流水线后依次执行，
+ * 最后一条流水线的每一批结果交给 output。
+ * 和 Init + NextBatch 的拉取方式用同一批执行器对象，两种方式可以对照。
+ */
+class PipelineExecutor {
+ public:
+  /**
+   * @param root 执行器树的根 (不转移所有权)
+   * @param schema 根的输出 schema
+   */
+  PipelineExecutor(Executor* root, const Schema* schema);
+
+  // output 返回 false 时提前结束
+  void Execute(ExecutionContext* exec_ctx, const Pipeline::OutputFn& output);
+
+  std::size_t GetPipelineCount() const { return pipelines_.size(); }
+
+ private:
+  std::vector<std::unique_ptr<Pipeline>> pipelines_;
+};
+
+}  // namespace bustub
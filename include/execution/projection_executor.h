@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/executor.h"
+#include "execution/expression.h"
+
+namespace hsql {
+struct Expr;
+}
+
+namespace bustub {
+
+/**
+ * ProjectionExecutor 计算 SELECT 列表：列引用、表达式、*，输出 schema 由列表决定。
+ * 选择列表在构造时由 ExprCompiler 编译 (和 WHERE 相同的类型规则)，编译失败抛异常。
+ * 延迟物化：向量化路径只让下游 (扫描) 解码列表和过滤用到的列，
+ * 过滤之后只对选中的行求值；行路径也只从 tuple 里读出引用到的列。
+ */
+class ProjectionExecutor : public Executor {
+ public:
+  /**
+   * @param select_list SELECT 后面的表达式列表，可以含 *
+   * @param input_schema 子执行器的输出 schema
+   */
+  ProjectionExecutor(std::unique_ptr<Executor> child,
+                     const std::vector<hsql::Expr*>& select_list,
+                     const Schema* input_schema);
+
+  // 输出列：别名 > 列名 > "?column?"
+  const Schema& GetOutputSchema() const { return *output_schema_; }
+
+  void Init(ExecutionContext* exec_ctx) override;
+
+  bool Next(Tuple* tuple) override;
+
+  bool NextBatch(DataChunk* chunk) override;
+
+  // push 执行：流水线中间的算子，每一批投影到自己的输出批再往下推
+  void BuildPipeline(PipelineBuilder* builder, const Schema* schema) override;
+  void OpenOperator(ExecutionContext* exec_ctx) override;
+  bool PushBatch(DataChunk* chunk, Pipeline* pipeline,
+                 std::size_t next) override;
+  bool PushInputColumns(bool partial,
+                        std::vector<uint32_t>* cols) const override;
+
+ private:
+  // input 里选中的行按列求值写进 output (output 先清空)
+  void Project(const DataChunk& input, DataChunk* output) const;
+
+  std::unique_ptr<Executor> child_;
+  const Schema* input_schema_;
+  std::vector<std::unique_ptr<CompiledExpr>> exprs_;
+  std::unique_ptr<Schema> output_schema_;
+  std::vector<uint32_t> input_columns_;  // 表达式引用到的输入列
+  std::unique_ptr<DataChunk> input_;     // 向量化路径从子执行器取数的 chunk
+  std::unique_ptr<DataChunk> output_;    // push 执行的输出批
+};
+
+}  // namespace bustub
@@ -8,8 +8,8 @@ namespace bustub {
 
 /**
  * SelectExecutor 执行 SELECT 语句。
- * 简化版：仅支持 SELECT * FROM table [WHERE ...]
- * 使用 TableScanExecutor + FilterExecutor 的组合
+ * SELECT list FROM table [WHERE ...]
+ * 使用 TableScanExecutor + FilterExecutor (+ ProjectionExecutor) 的组合
  */
 class SelectExecutor : public Executor {
  public:
@@ -20,6 +20,8 @@ class SelectExecutor : public Executor {
 
   bool Next(Tuple* tuple) override;
 
+  bool NextBatch(DataChunk* chunk) override;
+
  private:
   std::unique_ptr<Executor> source_;  // TableScan 或 Filter 包装的执行器
 };
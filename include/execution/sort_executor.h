@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/executor.h"
+#include "execution/expression.h"
+#include "execution/spill_file.h"
+
+namespace hsql {
+struct OrderDescription;
+}
+
+namespace bustub {
+
+/**
+ * SortKey 把一行按 ORDER BY 列表编码成 KeyEncoder 的规范化 key，
+ * key 的 memcmp 顺序就是 ORDER BY 的顺序 (升序 NULL 在前，降序 NULL 在后)。
+ */
+class SortKey {
+ public:
+  // 表达式按 schema 编译，未知列等抛异常
+  SortKey(const std::vector<hsql::OrderDescription*>& order_by,
+          const Schema* schema);
+
+  // 追加到 key 后面
+  void Encode(const ExprInput& input, std::string* key) const;
+
+ private:
+  std::vector<std::unique_ptr<CompiledExpr>> keys_;
+  std::vector<bool> descending_;
+};
+
+/**
+ * SortExecutor 实现 ORDER BY。
+ * 每行先按 ORDER BY 表达式编码成 KeyEncoder 的规范化 key，之后的比较只做 memcmp
+ * (前 8 字节另存成整数，大多数比较不用碰 key 本身)。
+ * 升序 NULL 在前，降序 NULL 在后 (KeyEncoder 的顺序)；key 相同的行顺序不保证。
+ * 数据量在 ExecutionContext::memory_limit_ 以内时整体在内存排序；
+ * 超过预算就把排好的一批写成一个 run (临时文件)，最后用败者树做 k 路归并，
+ * run 太多时先分几趟归并到不超过 fan-in。
+ */
+class SortExecutor : public Executor {
+ public:
+  static constexpr uint32_t MAX_MERGE_FAN_IN = 128;
+
+  /**
+   * @param order_by ORDER BY 列表，表达式按 schema 编译 (未知列等抛异常)
+   * @param schema 子执行器的输出 schema，也是本算子的输出 schema
+   */
+  SortExecutor(std::unique_ptr<Executor> child,
+               const std::vector<hsql::OrderDescription*>& order_by,
+               const Schema* schema);
+
+  void Init(ExecutionContext* exec_ctx) override;
+
+  bool Next(Tuple* tuple) override;
+
+  // push 执行：子树的流水线以本算子为终点，排好后本算子是下一条流水线的数据源
+  void BuildPipeline(PipelineBuilder* builder, const Schema* schema) override;
+  void OpenSink(ExecutionContext* exec_ctx) override;
+  void Sink(const DataChunk& chunk) override;
+  void FinishSink() override;
+
+  // 执行统计：写出的 run 数 (0 表示内存排序)、归并的趟数
+  uint32_t GetRunCount() const { return run_count_; }
+  uint32_t GetMergePasses() const { return merge_passes_; }
+
+ private:
+  struct SortEntry {
+    uint64_t prefix_;  // key 前 8 字节 (大端，不足补 0)
+    uint32_t key_offset_;
+    uint32_t key_len_;
+    uint32_t row_;
+  };
+
+  // 败者树归并中的一路
+  struct RunCursor {
+    SpillFile* file_;
+    const char* key_ = nullptr;
+    uint32_t key_len_ = 0;
+    const char* tuple_ = nullptr;
+    uint32_t tuple_len_ = 0;
+    bool done_ = false;
+  };
+
+  // 一行输入，超出预算就把这一批写成 run
+  void AddRow(const ExprInput& input, Tuple&& tuple);
+
+  // run 里的一条记录：[uint32 key 长度][key][tuple 字节]
+  void SortBuffer();
+  void ClearBuffer();
+  void FlushRun();
+
+  // 败者树：tree_[0] 是当前最小的一路，tree_[1..k-1] 存各内部结点上的败者
+  void StartMerge(std::vector<SpillFile*> inputs);
+  void Advance(uint32_t run);
+  void Adjust(uint32_t run);
+  bool RunLess(uint32_t a, uint32_t b) const;
+  void MergeInto(std::vector<SpillFile*> inputs, SpillFile* output);
+
+  std::unique_ptr<Executor> child_;
+  const Schema* schema_;
+  SortKey sort_key_;
+
+  // 内存里的一批
+  std::vector<Tuple> rows_;
+  std::vector<SortEntry> entries_;
+  std::string key_arena_;
+  std::size_t buffer_bytes_ = 0;
+  std::size_t output_pos_ = 0;
+
+  // 外部排序
+  std::vector<std::unique_ptr<SpillFile>> runs_;
+  std::vector<RunCursor> cursors_;
+  std::vector<uint32_t> tree_;
+  std::vector<char> merge_buffer_;  // 拼 run 记录用
+  std::string key_buffer_;          // 当前行的 key
+  uint32_t run_count_ = 0;
+  uint32_t merge_passes_ = 0;
+};
+
+}  // namespace bustub
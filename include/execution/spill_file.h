@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/macros.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+class DiskManager;
+
+/**
+ * SpillFile 是算子内存不够时写出去的一串 tuple，放在 DiskManager 的临时文件里。
+ * 文件是按页切开的字节流：每个 tuple 写成 [uint32 size][bytes]，可以跨页。
+ * 用法：先 Append 全部写完，再 Rewind，之后用 Next 顺序读回 (不保存 RID)。
+ * 也可以直接存任意字节的记录 (排序的 run 存 key + tuple)，同一个文件里不要混用。
+ * 溢出列 (ExternalRef) 原样写出，读回后仍指向原表的溢出页。
+ */
+class SpillFile {
+ public:
+  explicit SpillFile(DiskManager* disk_manager);
+  ~SpillFile();
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  void Append(const Tuple& tuple);
+  void Append(const char* data, uint32_t size);
+  // 写完：刷出最后一页，读位置回到开头
+  void Rewind();
+  bool Next(Tuple* tuple);
+  // *data 指向内部缓冲，下一次 Next 之前有效
+  bool Next(const char** data, uint32_t* size);
+
+  uint64_t GetTupleCount() const { return tuple_count_; }
+  // 写出的字节数 (含每个 tuple 4 字节的长度)
+  uint64_t GetBytes() const { return bytes_; }
+
+ private:
+  void Write(const char* data, std::size_t len);
+  void Read(char* data, std::size_t len);
+
+  DiskManager* disk_manager_;
+  uint32_t file_id_;
+  std::vector<char> page_;  // 写时是未满的最后一页，读时是当前页
+  std::size_t page_no_{0};  // 写：下一个要写的页号；读：下一个要读的页号
+  std::size_t offset_{0};   // 在 page_ 里的位置
+  uint64_t tuple_count_{0};
+  uint64_t bytes_{0};
+  uint64_t read_bytes_{0};
+  std::vector<char> tuple_buffer_;
+};
+
+}  // namespace bustub
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <limits>
 #include <memory>
+#include <utility>
 
 #include "execution/executor.h"
+#include "storage/table/scan_predicate.h"
 #include "storage/table/table_heap.h"
 
 namespace bustub {
@@ -18,14 +22,39 @@ class TableScanExecutor : public Executor {
    */
   explicit TableScanExecutor(table_id_t table_id) : table_id_(table_id) {}
 
+  /**
+   * 下推 "整数列 op 常量" 的谓词 (在 Init 之前调用)：
+   * 扫描直接在页字节上批量比较这一列，只有匹配的行才拷贝成 Tuple。
+   */
+  void SetPredicate(std::unique_ptr<ScanPredicate> predicate) {
+    predicate_ = std::move(predicate);
+  }
+
+  /**
+   * 只扫描第 [begin, end) 个数据页 (按页目录的顺序，end 超出时截到表尾)。
+   * 并行扫描时每个 morsel 调一次；Init 之后调用会从 begin 页重新开始。
+   */
+  void SetPageRange(std::size_t begin, std::size_t end);
+
+  // 表的数据页数 (Init 之后有效)
+  std::size_t GetPageCount() const {
+    return table_heap_ == nullptr ? 0 : table_heap_->GetPageCount();
+  }
+
   void Init(ExecutionContext* exec_ctx) override;
 
   bool Next(Tuple* tuple) override;
 
+  // 直接把页里的 tuple 字节拆到列向量，不构造 Tuple
+  bool NextBatch(DataChunk* chunk) override;
+
  private:
   table_id_t table_id_;
   std::unique_ptr<TableHeap> table_heap_;
   std::unique_ptr<TableHeap::TableIterator> iter_;
+  std::unique_ptr<ScanPredicate> predicate_;  // 下推的谓词，可为空
+  std::size_t range_begin_ = 0;
+  std::size_t range_end_ = std::numeric_limits<std::size_t>::max();
 };
 
 }  // namespace bustub
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/executor.h"
+#include "execution/sort_executor.h"
+
+namespace hsql {
+struct OrderDescription;
+}
+
+namespace bustub {
+
+/**
+ * TopNExecutor 实现 ORDER BY ... LIMIT n：只保留最小的 n 行，不对全部输入排序。
+ * 用 n 个元素的大根堆 (按 SortKey 的规范化 key)：新行的 key 不比堆顶小就直接丢掉，
+ * 不拷贝 tuple；输入读完后把堆排好输出。内存只和 n 有关。
+ * OFFSET 由上面的 LimitExecutor 处理，这里的 n 是 LIMIT + OFFSET。
+ */
+class TopNExecutor : public Executor {
+ public:
+  // n 超过这个数时计划用 SortExecutor (能溢出) + LimitExecutor
+  static constexpr uint64_t MAX_HEAP_ROWS = 1 << 16;
+
+  TopNExecutor(std::unique_ptr<Executor> child,
+               const std::vector<hsql::OrderDescription*>& order_by,
+               const Schema* schema, uint64_t n);
+
+  void Init(ExecutionContext* exec_ctx) override;
+
+  bool Next(Tuple* tuple) override;
+
+  // push 执行：子树的流水线以本算子为终点
+  void BuildPipeline(PipelineBuilder* builder, const Schema* schema) override;
+  void OpenSink(ExecutionContext* exec_ctx) override;
+  void Sink(const DataChunk& chunk) override;
+  void FinishSink() override;
+
+ private:
+  struct HeapEntry {
+    std::string key_;
+    Tuple row_;
+  };
+
+  // 一行输入：key 比堆顶小 (或堆未满) 才调用 make_tuple 拷贝这一行
+  template <typename MakeTuple>
+  void Offer(const ExprInput& input, MakeTuple make_tuple);
+
+  std::unique_ptr<Executor> child_;
+  const Schema* schema_;
+  SortKey sort_key_;
+  uint64_t n_;
+  std::vector<HeapEntry> heap_;  // 输入阶段是大根堆，之后是升序
+  std::size_t output_pos_ = 0;
+  std::string key_buffer_;  // 当前行的 key
+};
+
+}  // namespace bustub
@@ -1,28 +1,61 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "execution/data_chunk.h"
 #include "execution/executor.h"
+#include "execution/expression.h"
+#include "storage/table/table_heap.h"
 #include "type/value.h"
 
+namespace hsql {
+struct UpdateClause;
+}
+
 namespace bustub {
 
 /**
- * UpdateExecutor 更新表中的行。
- * 简化版：使用新值更新表中的所有行（无 WHERE 过滤）。
+ * UpdateExecutor 按 SET 子句更新子执行器产出的行 (扫描，或者扫描 + 过滤)。
+ * SET 的值是在表的 schema 上编译的表达式，在旧行上求值 (SET x = x + 1)，
+ * 再转成列的类型。按批从子执行器取行，只解码 SET 表达式用到的列：
+ * - SET 的列都是定长列 (非字典编码) 时在页里原地改写这几列，不重建整行
+ * - 否则整行更新：其他列由 TableHeap 从存储的旧行原样拷贝 (溢出列沿用原来的溢出链)，
+ *   变长行放不下时由 TableHeap 搬走
+ * Next 执行整条语句，只返回一次 true；更新的行数见 GetAffectedRows。
+ * 未知列、重复的列在构造时抛异常，值转换失败在执行时抛异常。
  */
 class UpdateExecutor : public Executor {
  public:
-  UpdateExecutor(table_id_t table_id, std::vector<Value> new_values)
-    : table_id_(table_id), new_values_(new_values) {}
+  UpdateExecutor(std::unique_ptr<Executor> child, table_id_t table_id,
+                 const std::vector<hsql::UpdateClause*>& updates,
+                 const Schema* schema);
 
   void Init(ExecutionContext* exec_ctx) override;
 
   bool Next(Tuple* tuple) override;
 
+  uint64_t GetAffectedRows() const { return affected_rows_; }
+  // SET 的列是否都能原地改写
+  bool IsInPlace() const { return in_place_; }
+
  private:
+  // 第 i 个 SET 在 row 上的值，已转成列的类型
+  Value Evaluate(uint32_t i, const DataChunk& chunk, uint32_t row) const;
+
+  std::unique_ptr<Executor> child_;
   table_id_t table_id_;
-  std::vector<Value> new_values_;
+  const Schema* schema_;
+  std::vector<uint32_t> columns_;  // SET 的列号
+  std::vector<std::unique_ptr<CompiledExpr>> exprs_;
+  std::vector<uint32_t> input_columns_;  // SET 表达式读到的列
+  bool in_place_ = true;
+
+  std::unique_ptr<TableHeap> table_heap_;
+  std::unique_ptr<DataChunk> input_;
+  std::vector<Value> values_;  // 当前行 SET 的新值
+  uint64_t affected_rows_ = 0;
   bool updated_ = false;
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 #include "type/type_id.h"
@@ -25,4 +26,12 @@ void PrintHelp();
 void ExecSql(const std::string& sql, bustub::SQLParser& sql_parser,
              bustub::CatalogManager* catalog);
 
+// 并行执行的线程数 (0 表示 CPU 核数)，下一条语句开始生效
+void SetParallelism(uint32_t num_threads);
+uint32_t GetParallelism();
+
+// SELECT 的执行方式：push 流水线或者 volcano 拉取 (默认)
+void SetPushExecution(bool enabled);
+bool GetPushExecution();
+
 }  // namespace bustub
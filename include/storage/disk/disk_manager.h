@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -41,12 +42,29 @@ class DiskManager {
   auto WritePage(table_id_t table_id, page_id_t page_id,
                  const char* page_data) -> void;
 
+  // ===== temp files =====
+  // 算子内存不够时 (hash join / 排序 / 聚合) 溢出用的临时文件，按页读写，
+  // 不经过 buffer pool。放在 data_dir/tmp 下，删除或析构时清理，启动时清掉残留。
+  // 不同线程可以同时读写不同的临时文件。
+  auto CreateTempFile() -> uint32_t;
+  auto WriteTempPage(uint32_t file_id, std::size_t page_no,
+                     const char* page_data) -> void;
+  auto ReadTempPage(uint32_t file_id, std::size_t page_no,
+                    char* page_data) -> void;
+  auto DeleteTempFile(uint32_t file_id) -> void;
+
  private:
   auto GetTableFilePath(table_id_t table_id,
                         const std::string& table_name) const -> std::string;
 
+  auto GetTempFile(uint32_t file_id) -> std::fstream&;
+
   std::string data_dir_;
   std::unordered_map<table_id_t, std::fstream> table_files_;
+
+  std::mutex temp_latch_;  // 只保护 temp_files_ 这张表
+  uint32_t next_temp_id_{0};
+  std::unordered_map<uint32_t, std::fstream> temp_files_;
 };
 
 }  // namespace bustub
\ No newline at end of file
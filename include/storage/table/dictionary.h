@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "common/config.h"
+
+/*
+  字典编码列的字典：一列所有不同的字符串 <-> 从 0 开始的 uint32 编码
+  行里只存 4 字节编码 (定长)。
+  字典存在表文件里的一条字典页链上 (见 DictionaryPage)，catalog.meta 只记链首页。
+  新条目先追加写进链尾并刷盘，GetOrAdd 才返回编码，
+  所以任何带着这个编码的数据页写盘时，条目一定已经在盘上了。
+  编码只增不删：删掉的行留下的编码不回收，保证已写入页里的编码始终有效。
+  编码按首次出现的顺序分配，不保持字符串的大小顺序，只能直接用于等值比较和分组。
+*/
+
+namespace bustub {
+
+class BufferPoolManager;
+
+class Dictionary {
+ public:
+  static constexpr uint32_t INVALID_CODE = UINT32_MAX;
+
+  // first_page_id 是已有的字典页链 (从 catalog.meta 读出)，新建的字典为 INVALID_PAGE_ID
+  explicit Dictionary(page_id_t first_page_id = INVALID_PAGE_ID)
+    : first_page_id_(first_page_id) {}
+
+  /**
+   * 接到 table_id 的表文件上：有字典页链时读出其中的条目，没有时新建一条
+   * (把已有的条目写进去)。之后新加的条目都写进这条链。
+   * 没有接上的字典只在内存里。
+   */
+  auto Attach(BufferPoolManager* bpm, table_id_t table_id) -> bool;
+  auto GetFirstPageId() const -> page_id_t { return first_page_id_; }
+
+  // 取 data 的编码，不存在则分配一个新编码 (接上表文件时先持久化再返回)
+  auto GetOrAdd(const char* data, uint32_t len) -> uint32_t;
+  // 只查不加，不存在返回 false (等值过滤绑定常量时用)
+  auto Lookup(const char* data, uint32_t len, uint32_t* code) const -> bool;
+  // 编码 -> 字符串，返回的 view 在字典存活期间一直有效
+  auto Decode(uint32_t code) const -> std::string_view;
+  auto Size() const -> uint32_t;
+
+ private:
+  // 把一个条目追加到字典页链尾并刷盘，调用方持有写锁
+  auto Persist(std::string_view entry) -> bool;
+
+  mutable std::shared_mutex latch_;
+  // deque 追加元素不会移动已有元素，index_ 里的 string_view 始终有效
+  std::deque<std::string> values_;
+  std::unordered_map<std::string_view, uint32_t> index_;
+
+  BufferPoolManager* bpm_ = nullptr;  // 没有接上表文件时为 nullptr
+  table_id_t table_id_ = 0;
+  page_id_t first_page_id_;
+  page_id_t last_page_id_ = INVALID_PAGE_ID;
+};
+
+}  // namespace bustub
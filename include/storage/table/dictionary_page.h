@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/config.h"
+#include "storage/page/page.h"
+
+/*
+  字典页：字典编码列的字典条目，和 TablePage 共用同一个表文件。
+  一列的字典是一条按 next_page_id_ 串起来的页链，条目 | len | bytes | 按编码顺序
+  首尾相接写在各页的 payload 里 (一个条目可以跨页)，只追加不修改。
+*/
+
+namespace bustub {
+
+class DictionaryPage : public Page {
+  struct Header {
+    page_id_t page_id_;
+    page_id_t next_page_id_;
+    uint32_t data_size_;
+  };
+
+ public:
+  // 每个字典页可以存放的数据字节数
+  static constexpr uint32_t CAPACITY = PAGE_SIZE - sizeof(Header);
+
+  auto Init(page_id_t page_id) -> void;
+
+  auto GetNextPageId() -> page_id_t { return GetHeader()->next_page_id_; }
+  auto SetNextPageId(page_id_t page_id) -> void {
+    GetHeader()->next_page_id_ = page_id;
+  }
+  auto GetDataSize() -> uint32_t { return GetHeader()->data_size_; }
+  auto GetPayload() -> char* { return data_ + sizeof(Header); }
+
+  // 把 data 尽量追加到本页，返回实际写入的字节数 (页满时小于 size)
+  auto Append(const char* data, uint32_t size) -> uint32_t;
+
+ private:
+  auto GetHeader() -> Header* { return reinterpret_cast<Header*>(data_); }
+};
+
+}  // namespace bustub
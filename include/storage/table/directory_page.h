@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/config.h"
+#include "storage/page/page.h"
+
+/*
+  页目录：记录一张表的第 N 个数据页是哪个 page_id (ordinal -> page_id)
+  一个目录页放不下时按 next_page_id_ 串成单链，和 TablePage 共用同一个表文件。
+  打开表、跳到第 N 页、把扫描切成若干段时都不必再沿 TablePage 链逐页走。
+*/
+
+namespace bustub {
+
+class BufferPoolManager;
+
+class DirectoryPage : public Page {
+  struct Header {
+    page_id_t page_id_;
+    page_id_t next_page_id_;
+    uint32_t entry_count_;
+    TableLayout layout_;  // 表的页格式 (只看链首页)
+  };
+
+ public:
+  // 每个目录页可以存放的条目数
+  static constexpr uint32_t CAPACITY =
+      (PAGE_SIZE - sizeof(Header)) / sizeof(page_id_t);
+
+  auto Init(page_id_t page_id) -> void;
+
+  auto GetNextPageId() -> page_id_t { return GetHeader()->next_page_id_; }
+  auto SetNextPageId(page_id_t page_id) -> void {
+    GetHeader()->next_page_id_ = page_id;
+  }
+  auto GetEntryCount() -> uint32_t { return GetHeader()->entry_count_; }
+  auto GetLayout() -> TableLayout { return GetHeader()->layout_; }
+  auto SetLayout(TableLayout layout) -> void { GetHeader()->layout_ = layout; }
+  auto GetEntry(uint32_t idx) -> page_id_t { return GetEntries()[idx]; }
+
+  // 追加一个条目，页满返回 false
+  auto Append(page_id_t page_id) -> bool;
+
+  // 沿目录链读出全部条目，并给出最后一个目录页 (之后追加用) 和表的页格式
+  static auto LoadChain(BufferPoolManager* bpm, table_id_t table_id,
+                        page_id_t first_page_id, std::vector<page_id_t>* pages,
+                        page_id_t* last_page_id, TableLayout* layout) -> bool;
+
+ private:
+  auto GetHeader() -> Header* { return reinterpret_cast<Header*>(data_); }
+  auto GetEntries() -> page_id_t* {
+    return reinterpret_cast<page_id_t*>(data_ + sizeof(Header));
+  }
+};
+
+}  // namespace bustub
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/config.h"
+#include "storage/page/page.h"
+
+/*
+  溢出页：存放单个超长变长值 (TOAST)
+  一个值被切成若干段，按 next_page_id_ 串成单链，和 TablePage 共用同一个表文件。
+  tuple 里只留一个 Tuple::ExternalRef，只有真正读这一列时才会去访问溢出链。
+*/
+
+namespace bustub {
+
+class BufferPoolManager;
+
+class OverflowPage : public Page {
+  struct Header {
+    page_id_t page_id_;
+    page_id_t next_page_id_;
+    uint32_t data_size_;
+  };
+
+ public:
+  // 每个溢出页可以存放的数据字节数
+  static constexpr uint32_t CAPACITY = PAGE_SIZE - sizeof(Header);
+
+  auto Init(page_id_t page_id) -> void;
+
+  auto GetNextPageId() -> page_id_t { return GetHeader()->next_page_id_; }
+  auto SetNextPageId(page_id_t page_id) -> void {
+    GetHeader()->next_page_id_ = page_id;
+  }
+  auto GetDataSize() -> uint32_t { return GetHeader()->data_size_; }
+  auto GetPayload() -> char* { return data_ + sizeof(Header); }
+
+  // 把 data 写成一条溢出链，返回链首页 id (失败返回 INVALID_PAGE_ID)
+  static auto WriteChain(BufferPoolManager* bpm, table_id_t table_id,
+                         const char* data, uint32_t size) -> page_id_t;
+
+  // 沿溢出链读出 size 字节到 out
+  static auto ReadChain(BufferPoolManager* bpm, table_id_t table_id,
+                        page_id_t first_page_id, char* out,
+                        uint32_t size) -> bool;
+
+  // 丢弃一条溢出链的所有页 (写入失败时回滚，值被更新或删除后回收)
+  static auto FreeChain(BufferPoolManager* bpm, table_id_t table_id,
+                        page_id_t first_page_id) -> void;
+
+ private:
+  auto GetHeader() -> Header* { return reinterpret_cast<Header*>(data_); }
+};
+
+}  // namespace bustub
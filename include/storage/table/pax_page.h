@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "common/rid.h"
+#include "storage/page/page.h"
+#include "storage/table/tuple.h"
+
+/*
+  PAX 页：页内按列分组 (minipage)，同一列的值在页内连续存放
+  | Header | live bitmap | col0: null bitmap + values | col1: ... |
+  每页的行数上限由 schema 算出；只支持全定长的 schema，行宽固定，更新总能原地完成。
+  对外仍是 RID(page_id, 行号) + 行格式 Tuple，TableHeap 的语义不变；
+  只读一列的算子可以直接拿 GetColumnData 扫这一列的 minipage。
+*/
+
+namespace bustub {
+class ScanPredicate;
+class TableHeap;
+
+class PaxPage : public Page {
+  friend TableHeap;
+  struct Header {
+    page_id_t page_id_;
+    page_id_t prev_page_id_;
+    page_id_t next_page_id_;
+    uint32_t tuple_count_;  // 已用行槽数 (含已删除)
+    uint32_t capacity_;     // 本页最多容纳的行数
+  };
+
+ public:
+  // 一个页能放下多少行，schema 含变长列时返回 0
+  static auto ComputeCapacity(const Schema *schema) -> uint32_t;
+
+  auto Init(const Schema *schema, page_id_t page_id,
+            page_id_t prev_page_id = INVALID_PAGE_ID,
+            page_id_t next_page_id = INVALID_PAGE_ID) -> void;
+
+  auto InsertTuple(const Schema *schema, const Tuple &tuple) -> RID;
+  auto GetTuple(const Schema *schema, RID rid) -> Tuple;
+  // 把本页所有存活行拼回行格式追加到 out (minipage 起点只算一次)
+  // predicate 非空时先在谓词列的 minipage 上求值，只拼匹配的行
+  auto CollectTuples(const Schema *schema, std::vector<Tuple> *out,
+                     const ScanPredicate *predicate = nullptr) -> void;
+  auto MarkDeleted(RID rid) -> bool;
+  auto UpdateTuple(const Schema *schema, const Tuple &new_tuple,
+                   RID rid) -> bool;
+  // 只改写 cols 这几列的 minipage
+  auto UpdateColumns(const Schema *schema, RID rid,
+                     const std::vector<uint32_t> &cols,
+                     const std::vector<Value> &values) -> bool;
+
+  // ===== column access =====
+  auto GetTupleCount() -> uint32_t { return GetHeader()->tuple_count_; }
+  auto IsLive(uint32_t slot_id) -> bool;
+  auto IsNull(const Schema *schema, uint32_t col_idx,
+              uint32_t slot_id) -> bool;
+  // 第 col_idx 列的值数组，第 i 行的值在 GetColumnData() + i * 列宽
+  auto GetColumnData(const Schema *schema, uint32_t col_idx) -> const char *;
+
+ private:
+  auto GetHeader() -> Header * { return reinterpret_cast<Header *>(data_); }
+  auto GetLiveBitmap() -> uint8_t * {
+    return reinterpret_cast<uint8_t *>(data_ + sizeof(Header));
+  }
+  // 第 col_idx 列 minipage 的起点 (先 null bitmap，后值数组)
+  static auto MinipageOffset(const Schema *schema, uint32_t col_idx,
+                             uint32_t capacity) -> uint32_t;
+};
+
+}  // namespace bustub
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+#include "catalog/schema.h"
+#include "type/type_kernels.h"
+
+/*
+  下推到表扫描的谓词 "整数列 op 常量"，直接在页字节上求值，只有匹配的行才拷贝成 Tuple。
+  - 行式页：先把每个槽位这一列的值 (tuple 里 null bitmap 之后 + 列偏移) 收集到连续数组
+  - PAX 页：这一列的 minipage 本身就是连续数组，直接比较
+  比较用 SIMD 一次比较多个值 (AVX2 8 x int32 / 4 x int64，SSE4.2 4 x int32 / 2 x int64)，
+  运行时按 CPU 选择，非 x86 或不支持时用标量循环。
+  支持 4 / 8 字节整数存储的列 (INTEGER / DATE / BIGINT / TIMESTAMP)，
+  以及字典编码列的 = / != (常量是字典编码)。
+*/
+
+namespace bustub {
+
+class ScanPredicate {
+ public:
+  enum class SimdLevel { SCALAR, SSE42, AVX2 };
+
+  // col 上的 op 能否下推 (字典列只支持 = / !=)
+  static auto Supports(const Column &col, CompareOp op) -> bool;
+  // 本机支持的最高级别
+  static auto DetectSimdLevel() -> SimdLevel;
+
+  // constant 是列的存储值：INTEGER / DATE 为 int32，BIGINT / TIMESTAMP 为 int64，字典列为编码
+  ScanPredicate(const Schema *schema, uint32_t col_idx, CompareOp op,
+                int64_t constant);
+
+  auto GetColumnIndex() const -> uint32_t { return col_idx_; }
+  auto GetWidth() const -> uint32_t { return width_; }
+  // 值在行格式 tuple 里的字节偏移
+  auto GetValueOffset() const -> uint32_t { return value_offset_; }
+
+  // 基准测试用：强制使用某一级内核 (高于本机支持的级别会退回 DetectSimdLevel)
+  auto SetSimdLevel(SimdLevel level) -> void;
+
+  // values 是 count 个连续存放的值 (可不对齐)，nulls 第 i 位为 1 表示第 i 个值是 NULL (可为空)。
+  // 匹配的第 i 位写 1 到 match，match 至少 (count + 63) / 64 个字
+  auto Evaluate(const char *values, const uint8_t *nulls, uint32_t count,
+                uint64_t *match) const -> void;
+  // 单个行格式 tuple (转发桩指向的行在别的页，逐条求值)
+  auto Matches(const char *tuple_data) const -> bool;
+
+ private:
+  uint32_t col_idx_;
+  CompareOp op_;
+  int64_t constant_;
+  uint32_t width_;
+  uint32_t value_offset_;
+  SimdLevel level_;
+};
+
+}  // namespace bustub
@@ -1,37 +1,50 @@
 #pragma once
 
-#include <optional>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 
 #include "common/config.h"
 #include "common/rid.h"
+#include "storage/table/table_stats.h"
 #include "storage/table/tuple.h"
 
 /*
     逻辑表：一个双向链表，把一连串 TablePage 串起来，构成一个完整的表
     一张表不是单个页，而是一个双向链表。
     每个页记录 prev_page_id、next_page_id，形成链。
-    TableHeap 持有 first_page_id 和 last_page_id，找到表的起点和终点。
+    另外每张表有一个持久化的页目录 (DirectoryPage)，记录第 N 页的 page_id，
+    TableHeap 打开时只读目录，按序号随机访问页，也可以只扫描 [begin, end) 这一段页。
     所有页操作都通过 BufferPoolManager 进行。
+    建表时可以选 PAX 页格式 (PaxPage，页内按列分组)，接口和 RID 语义与行式页相同。
+    超过 TUPLE_TOAST_THRESHOLD 的 tuple 会把最长的变长值挪到溢出页 (OverflowPage)。
 */
 
 namespace bustub {
 
+class Page;
+class ScanPredicate;
 class TablePage;
 class BufferPoolManager;
 
 class TableHeap {
  public:
   // ============ Iterator =============
+  // 按页批量迭代：每个页只 Fetch/Unpin 一次，把该页所有存活的 Tuple
+  // 一次性拷贝进 page_tuples_，之后逐条吐出，吐完再按页目录换到下一页。
   class TableIterator {
    public:
-    // 构造函数
-    TableIterator(TableHeap* table_heap, RID rid);
+    // 构造函数：扫描序号在 [ordinal, end_ordinal) 的页 (ordinal 越界即 End)
+    // predicate 非空时只吐出满足它的行，谓词在页字节上求值，不匹配的行不拷贝
+    TableIterator(TableHeap* table_heap, std::size_t ordinal,
+                  std::size_t end_ordinal,
+                  const ScanPredicate* predicate = nullptr);
 
     // 解引用运算符 (*it) -> 获取当前 Tuple
-    const Tuple operator*();
+    const Tuple& operator*() const;
 
     // 箭头运算符 (it->) -> 获取当前 Tuple 的指针
-    const Tuple* operator->();
+    const Tuple* operator->() const;
 
     // 前置自增 (++it) -> 移动到下一条
     TableIterator& operator++();
@@ -44,33 +57,120 @@ class TableHeap {
     bool operator!=(const TableIterator& itr) const;
 
    private:
+    // 从第 ordinal 页开始装载下一个含有存活记录的页，没有则置为 End
+    void LoadPage(std::size_t ordinal);
+    // PAX 页：逐行从各列 minipage 拼回行格式
+    void LoadPaxPage(page_id_t page_id);
+
     TableHeap* table_heap_;
+    const ScanPredicate* predicate_;  // 下推的谓词，可为空 (由调用方持有)
     RID rid_;
-    std::optional<Tuple> tuple_cache_{std::nullopt};
-    // 为了性能，迭代器内部可能会缓存当前的 Tuple，避免每次解引用都去 Fetch Page
-    // 但简单实现可以先不缓存，每次 *it 都去 Fetch。
+    std::vector<Tuple> page_tuples_;  // 当前页的所有存活记录
+    std::size_t cursor_{0};           // 当前记录在 page_tuples_ 中的下标
+    std::size_t next_ordinal_{0};     // 下一页的序号
+    std::size_t end_ordinal_{0};      // 扫描范围的右端 (不含)
+
+    // 行式页求值谓词用的缓冲：谓词列的值、null 位、匹配位图
+    std::vector<char> pred_values_;
+    std::vector<uint8_t> pred_nulls_;
+    std::vector<uint64_t> pred_match_;
   };
 
   TableIterator Begin();
+  // 只扫描序号在 [begin_ordinal, end_ordinal) 的页，用来把一次扫描切成多段
+  TableIterator Begin(std::size_t begin_ordinal, std::size_t end_ordinal,
+                      const ScanPredicate* predicate = nullptr);
   TableIterator End();
 
   // ===== structor & destructor ======
-  TableHeap(BufferPoolManager* bpm, table_id_t table_id);  // 新建表
-  TableHeap(BufferPoolManager* bpm, table_id_t table_id,
-            page_id_t first_page_id);  // 从disk读出的表
+  TableHeap(BufferPoolManager* bpm, table_id_t table_id, const Schema* schema,
+            TableLayout layout = TableLayout::ROW);  // 新建表
+  TableHeap(BufferPoolManager* bpm, table_id_t table_id, const Schema* schema,
+            page_id_t directory_page_id,
+            TableStats* stats = nullptr);  // 从disk读出的表 (按页目录打开)
   ~TableHeap() = default;
 
+  // ========= Page directory =========
+  page_id_t GetDirectoryPageId() const { return directory_page_id_; }
+  page_id_t GetFirstPageId() const { return first_page_id_; }
+  TableLayout GetLayout() const { return layout_; }
+  std::size_t GetPageCount() const { return pages_.size(); }
+  // 第 ordinal 个数据页的 page_id，越界返回 INVALID_PAGE_ID
+  page_id_t GetPageId(std::size_t ordinal) const;
+
+  // 统计信息：打开时传入 stats 就维护调用方 (TableInfo) 的那份，否则维护自己的
+  TableStats* GetStats() {
+    return external_stats_ != nullptr ? external_stats_ : &local_stats_;
+  }
+
   // ========= Logic function =========
   RID InsertTuple(const Tuple& tuple);                // 插入记录
   bool MarkDeleted(const RID rid);                    // 标记删除记录
   bool UpdateTuple(const Tuple& new_tuple, RID rid);  // 更新记录
+  // 原地改写一行的几个定长列 (非字典编码)，不重建整行；values 已是列的类型
+  bool UpdateColumns(RID rid, const std::vector<uint32_t>& cols,
+                     const std::vector<Value>& values);
+  // 把第 cols[i] 列换成 values[i] 后整行更新 (任意列)；其余列按存储格式原样拷贝，
+  // 溢出列沿用原来的 ExternalRef，不读也不重写溢出链
+  bool ReplaceColumns(RID rid, const std::vector<uint32_t>& cols,
+                      const std::vector<Value>& values);
   Tuple GetTuple(const RID& rid);                     // 获取记录
 
+  // 行变长放不下时会被搬到别的页，原槽位留下转发桩 (RID 不变)；
+  // 这里把能搬回原页的行搬回去，返回收拢的转发桩个数
+  uint32_t CollapseForwarding();
+
  private:
+  // 插到最后一页，放不下就追加新页；is_moved 表示这是被搬迁的行
+  RID InsertIntoLastPage(const Tuple& tuple, bool is_moved);
+
+  // 把新数据页登记到页目录，最后一个目录页满了就再接一个
+  bool AppendToDirectory(page_id_t page_id);
+
+  // 按 layout_ 分派到 TablePage / PaxPage
+  void InitPage(Page* page, page_id_t page_id, page_id_t prev_page_id);
+  void SetNextPageId(Page* page, page_id_t next_page_id);
+  RID InsertIntoPage(Page* page, const Tuple& tuple, bool is_moved);
+
+  // PAX 行的大小 (行格式：null bitmap + 定长区)
+  uint32_t PaxRowSize() const {
+    return (schema_->GetColumnCount() + 7) / 8 + schema_->GetStorageSize();
+  }
+
+  // 行已确认存在 (old_tuple 是它当前的存储映像)：必要时 TOAST 后写入，
+  // 成功后释放旧值独占的溢出链，失败时释放刚写的
+  bool UpdateRow(const Tuple& raw_tuple, RID rid, const Tuple& old_tuple);
+  // 行式页上写入已 TOAST 的新映像：原地、页整理后原地，或者搬走留转发桩
+  bool UpdateStored(const Tuple& new_tuple, RID rid);
+
+  // 溢出链：行里各溢出列的链首页；释放 chains 里不在 keep 中的链
+  bool HasVarlenColumns() const;
+  std::vector<page_id_t> ExternalChains(const Tuple& tuple) const;
+  void FreeChains(const std::vector<page_id_t>& chains,
+                  const std::vector<page_id_t>& keep);
+
+  // 页整理回收了 count 个已删除 tuple 的空间
+  void ReclaimDead(uint32_t count) {
+    TableStats* stats = GetStats();
+    stats->dead_tuples_ -= std::min<uint64_t>(stats->dead_tuples_, count);
+  }
+
+  // 把过长 tuple 中最长的变长值依次挪到溢出链，直到不超过阈值
+  Tuple ToastTuple(const Tuple& tuple);
+
   BufferPoolManager* bpm_;
   table_id_t table_id_;
+  const Schema* schema_;
   page_id_t first_page_id_;  // head page pointer
   page_id_t last_page_id_;   // tail page pointer
+
+  page_id_t directory_page_id_{INVALID_PAGE_ID};       // 页目录链首
+  page_id_t last_directory_page_id_{INVALID_PAGE_ID};  // 页目录链尾
+  std::vector<page_id_t> pages_;  // 页目录的内存副本: ordinal -> page_id
+  TableLayout layout_{TableLayout::ROW};  // 页格式，记在页目录里
+
+  TableStats local_stats_;
+  TableStats* external_stats_{nullptr};
 };
 
 }  // namespace bustub
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 #include "common/config.h"
 #include "common/rid.h"
@@ -21,20 +22,53 @@ class TablePage : public Page {
     uint32_t free_space_ptr_;
   };
 
+  // storage_size_ 的高两位是槽位状态：
+  // FORWARD: 行被搬到别的页，槽位本身就是转发桩 (offset_ = page_id，低位 = slot_id)
+  // MOVED:   这条 tuple 是替别的槽位存放的，只能经由转发桩访问，扫描时跳过
+  static constexpr uint32_t SLOT_FORWARD_FLAG = 0x80000000;
+  static constexpr uint32_t SLOT_MOVED_FLAG = 0x40000000;
+  static constexpr uint32_t SLOT_SIZE_MASK = 0x3FFFFFFF;
+
   struct Slot {
     uint32_t offset_;
     uint32_t storage_size_;
+
+    auto IsDeleted() const -> bool { return storage_size_ == 0; }
+    auto IsForward() const -> bool { return storage_size_ & SLOT_FORWARD_FLAG; }
+    auto IsMoved() const -> bool { return storage_size_ & SLOT_MOVED_FLAG; }
+    auto GetSize() const -> uint32_t {
+      return IsForward() ? 0 : storage_size_ & SLOT_SIZE_MASK;
+    }
   };
 
  public:
   auto Init(page_id_t page_id, page_id_t prev_page_id = INVALID_PAGE_ID,
             page_id_t next_page_id = INVALID_PAGE_ID) -> void;
   auto GetFreeSpaceRemaining() -> uint32_t;
-  auto InsertTuple(const Tuple &tuple) -> RID;
+  auto InsertTuple(const Tuple &tuple, bool is_moved = false) -> RID;
 
   auto GetTuple(const RID rid) -> Tuple;
   auto MarkDeleted(const RID rid) -> bool;
-  auto UpdateTuple(const Tuple &new_tuple, RID rid) -> bool;
+  // 放不下时会先 Compact 再试；reclaimed 不为空时加上 Compact 回收的已删除 tuple 数
+  auto UpdateTuple(const Tuple &new_tuple, RID rid,
+                   uint32_t *reclaimed = nullptr) -> bool;
+  // 原地改写定长列 (行长不变)：第 cols[i] 列写成 values[i]，值已是列的类型
+  auto UpdateColumns(const Schema *schema, RID rid,
+                     const std::vector<uint32_t> &cols,
+                     const std::vector<Value> &values) -> bool;
+
+  // ===== forwarding stubs =====
+  // 槽位是转发桩时返回 true，并给出目标 RID
+  auto GetForward(uint32_t slot_id, RID *target) -> bool;
+  // 把槽位改成指向 target 的转发桩 (原数据成为垃圾，等 Compact 回收)
+  auto SetForward(uint32_t slot_id, RID target) -> void;
+  // 把 tuple 放回转发桩所在槽位，空间不够返回 false (reclaimed 同 UpdateTuple)
+  auto Unforward(uint32_t slot_id, const Tuple &tuple,
+                 uint32_t *reclaimed = nullptr) -> bool;
+
+  // 整理数据区，回收删除/搬走留下的空洞 (槽号不变，RID 保持稳定)。
+  // 返回这次回收了数据的已删除 tuple 数 (回收过的删除槽位 offset_ 置 0，不再重复计数)
+  auto Compact() -> uint32_t;
 
  private:
   // return offset of new tuple
@@ -43,4 +77,4 @@ class TablePage : public Page {
   auto GetHeader() -> Header *;
   auto GetSlot(uint32_t slot_id) -> Slot *;
 };
-}  // namespace bustub
\ No newline at end of file
+}  // namespace bustub
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/config.h"
+
+/*
+  表的统计信息：由 TableHeap 在插入/删除/更新时增量维护，随 catalog.meta 持久化
+  读取它不需要扫表 (COUNT(*)、规划器、vacuum 调度)
+*/
+
+namespace bustub {
+
+struct TableStats {
+  uint64_t live_tuples_{0};  // 存活的行数
+  uint64_t dead_tuples_{0};  // 已删除、槽位尚未回收的 tuple 数
+  uint64_t page_count_{0};   // 数据页数 (不含页目录和溢出页)
+  uint64_t tuple_bytes_{0};  // 存活 tuple 占用的字节数
+
+  // 平均填充率：存活数据占数据页总空间的比例
+  double FillFactor() const {
+    return page_count_ == 0 ? 0.0
+                            : static_cast<double>(tuple_bytes_) /
+                                  static_cast<double>(page_count_ * PAGE_SIZE);
+  }
+};
+
+}  // namespace bustub
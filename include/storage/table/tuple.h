@@ -10,12 +10,23 @@
 #include "type/value.h"
 
 namespace bustub {
+class BufferPoolManager;
+
 class Tuple {
  public:
+  // 变长列的定长槽里若置了这一位，变长区里存的不是 [len][bytes]，
+  // 而是指向溢出链的 ExternalRef
+  static constexpr uint32_t EXTERNAL_FLAG = 0x80000000;
+  struct ExternalRef {
+    uint32_t length_;          // 值的逻辑长度
+    table_id_t table_id_;      // 溢出链所在的表
+    page_id_t first_page_id_;  // 溢出链首页
+  };
+
   // defalt
   Tuple();
   // cp
-  Tuple(std::vector<Value> values, Schema *schema);
+  Tuple(const std::vector<Value> &values, Schema *schema);
   Tuple(RID rid, char *data, uint32_t size);
   Tuple(const Tuple &other);
   Tuple& operator=(const Tuple &other);
@@ -25,7 +36,9 @@ class Tuple {
 
   ~Tuple();
 
-  Value GetValue(const Schema *schema, uint32_t column_idx) const;
+  // 溢出到外部的列需要传入 bpm 才能读出 (只在真正访问这一列时读溢出链)
+  Value GetValue(const Schema *schema, uint32_t column_idx,
+                 BufferPoolManager *bpm = nullptr) const;
 
   inline RID GetRid() const { return rid_; }
   inline void SetRid(RID rid) { rid_ = rid; }
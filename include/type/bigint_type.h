@@ -0,0 +1,33 @@
+/*
+  64 位整数类型实现
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "type/type.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class BigIntType : public Type {
+ public:
+  BigIntType();
+
+  void SerializeTo(const Value &val, char *storage) const override;
+  Value DeserializeFrom(const char *storage) const override;
+
+  bool CompareEquals(const Value &left,
+                     const Value &right) const override;
+
+  bool CompareLessThan(const Value &left,
+                       const Value &right) const override;
+
+  uint64_t Hash(const Value &val) const override;
+
+
+  std::string ToString(const Value &val) const override;
+};
+
+}  // namespace bustub
@@ -0,0 +1,36 @@
+/*
+  布尔类型实现，存储为 1 字节 0 / 1
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "type/type.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class BooleanType : public Type {
+ public:
+  BooleanType();
+
+  // 'true' / 'false' / '1' / '0' (大小写不敏感)
+  static bool Parse(const std::string &str, bool *result);
+
+  void SerializeTo(const Value &val, char *storage) const override;
+  Value DeserializeFrom(const char *storage) const override;
+
+  bool CompareEquals(const Value &left,
+                     const Value &right) const override;
+
+  bool CompareLessThan(const Value &left,
+                       const Value &right) const override;
+
+  uint64_t Hash(const Value &val) const override;
+
+
+  std::string ToString(const Value &val) const override;
+};
+
+}  // namespace bustub
@@ -0,0 +1,42 @@
+/*
+  批量列哈希：一次算一整批行的某一列，不构造 Value
+
+  列类型在循环外选定一次，循环体里只有读字节 + 内联的哈希内核。
+  多列 key 逐列调用，combine = true 时把本列的哈希组合进 hashes 里已有的值，
+  结果和逐行 CombineHashes(..., Value::Hash()) 一致。
+  字典编码列 HashTuples 按解码出的字符串哈希 (可以和普通 VARCHAR 列 join)；
+  只在同一列内分组时用 HashDictCodes 直接哈希 4 字节编码，不用解码。
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "catalog/schema.h"
+#include "storage/table/tuple.h"
+#include "type/type_id.h"
+
+namespace bustub {
+class BufferPoolManager;
+
+class ColumnHasher {
+ public:
+  // 行格式：tuples[0..count) 的第 col_idx 列；溢出列需要 bpm
+  static void HashTuples(const Schema *schema, uint32_t col_idx,
+                         const Tuple *tuples, std::size_t count,
+                         uint64_t *hashes, bool combine,
+                         BufferPoolManager *bpm = nullptr);
+
+  // 字典编码列：哈希编码本身，同一字典内编码和字符串一一对应
+  static void HashDictCodes(const Schema *schema, uint32_t col_idx,
+                            const Tuple *tuples, std::size_t count,
+                            uint64_t *hashes, bool combine);
+
+  // 列格式：连续存放的 count 个定长值 (如 PAX minipage)，
+  // null_bitmap 第 i 位为 1 表示第 i 个值是 NULL，可以为空
+  static void HashFixed(TypeId type_id, const char *values,
+                        const uint8_t *null_bitmap, std::size_t count,
+                        uint64_t *hashes, bool combine);
+};
+
+}  // namespace bustub
@@ -0,0 +1,42 @@
+/*
+  日期类型实现，存储为 int32：距 1970-01-01 的天数
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "type/type.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class DateType : public Type {
+ public:
+  DateType();
+
+  // 'YYYY-MM-DD' <-> 天数，格式不对返回 false
+  static bool Parse(const std::string &str, int32_t *days);
+  static std::string Format(int32_t days);
+
+  // 公历日期 <-> 距 1970-01-01 的天数
+  static int32_t DaysFromCivil(int32_t year, uint32_t month, uint32_t day);
+  static void CivilFromDays(int32_t days, int32_t *year, uint32_t *month,
+                            uint32_t *day);
+
+  void SerializeTo(const Value &val, char *storage) const override;
+  Value DeserializeFrom(const char *storage) const override;
+
+  bool CompareEquals(const Value &left,
+                     const Value &right) const override;
+
+  bool CompareLessThan(const Value &left,
+                       const Value &right) const override;
+
+  uint64_t Hash(const Value &val) const override;
+
+
+  std::string ToString(const Value &val) const override;
+};
+
+}  // namespace bustub
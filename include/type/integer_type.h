@@ -25,6 +25,9 @@ class IntegerType : public Type {
   bool CompareLessThan(const Value &left,
                        const Value &right) const override;
 
+  uint64_t Hash(const Value &val) const override;
+
+
   std::string ToString(const Value &val) const override;
 };
 
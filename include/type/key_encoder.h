@@ -0,0 +1,62 @@
+/*
+  可 memcmp 比较的规范化键编码
+
+  把一行里的若干 key 列编码成一个字节串，字节串按 memcmp 的顺序就是 SQL 的顺序，
+  排序、B+ 树、merge join 比较复合键时只需要一次 memcmp (std::string 的 < 也是)。
+
+  每列的编码：| null 标记 (1 字节) | 值 |
+  - null 标记：NULL 为 0x00，非 NULL 为 0x01，所以升序时 NULL 排最前
+  - INTEGER / DATE / BIGINT / TIMESTAMP：翻转符号位后按大端写出
+  - DOUBLE：正数翻转符号位，负数按位取反，再按大端写出 (-0.0 归一成 0.0)
+  - BOOLEAN：1 字节 0 / 1
+  - VARCHAR：0x00 转义成 0x00 0xFF，以 0x00 0x00 结尾，前缀短的串排前面
+    (字典编码列先解码，编码本身不保持顺序)
+  降序列把这一列的全部字节 (含 null 标记) 取反。
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "storage/table/tuple.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+class BufferPoolManager;
+
+class KeyEncoder {
+ public:
+  // key_attrs: 参与编码的列号 (按顺序)；descending 为空时全部升序
+  KeyEncoder(const Schema *schema, std::vector<uint32_t> key_attrs,
+             std::vector<bool> descending = {});
+
+  // 把 tuple 的 key 列追加编码到 out，定长列和行内变长列直接读 tuple 字节，
+  // 只有溢出列才走 GetValue (需要 bpm)
+  void EncodeTuple(const Tuple &tuple, std::string *out,
+                   BufferPoolManager *bpm = nullptr) const;
+  // 按 key 列的顺序给出的值 (values.size() == key 列数)
+  void EncodeValues(const std::vector<Value> &values, std::string *out) const;
+
+  // 单个值的编码，值的类型即编码类型
+  static void EncodeValue(const Value &val, std::string *out,
+                          bool descending = false);
+
+  inline uint32_t GetKeyCount() const {
+    return static_cast<uint32_t>(key_attrs_.size());
+  }
+
+ private:
+  static void EncodeNull(std::string *out, bool descending);
+  // 把 storage 处序列化好的值 (定长值或 [len][bytes]) 编码出来
+  static void EncodeRaw(TypeId type_id, const char *storage, std::string *out,
+                        bool descending);
+
+  const Schema *schema_;
+  std::vector<uint32_t> key_attrs_;
+  std::vector<bool> descending_;
+};
+
+}  // namespace bustub
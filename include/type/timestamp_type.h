@@ -0,0 +1,37 @@
+/*
+  时间戳类型实现，存储为 int64：距 1970-01-01 00:00:00 的微秒数 (不带时区)
+*/
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "type/type.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class TimestampType : public Type {
+ public:
+  TimestampType();
+
+  // 'YYYY-MM-DD[ HH:MM:SS[.ffffff]]' <-> 微秒数，格式不对返回 false
+  static bool Parse(const std::string &str, int64_t *micros);
+  static std::string Format(int64_t micros);
+
+  void SerializeTo(const Value &val, char *storage) const override;
+  Value DeserializeFrom(const char *storage) const override;
+
+  bool CompareEquals(const Value &left,
+                     const Value &right) const override;
+
+  bool CompareLessThan(const Value &left,
+                       const Value &right) const override;
+
+  uint64_t Hash(const Value &val) const override;
+
+
+  std::string ToString(const Value &val) const override;
+};
+
+}  // namespace bustub
@@ -5,6 +5,7 @@
 */
 
 #pragma once
+#include <cstdint>
 #include <string>
 
 #include "type/type_id.h"
@@ -18,6 +19,8 @@ class Type {
 
   // 单例工厂：根据 TypeId 拿到对应的 Type 处理器
   static Type * GetInstance(TypeId type_id);
+  // 类型名 (SQL 里的写法)
+  static std::string TypeIdToString(TypeId type_id);
 
   /*
     定义type的行为，但不具体实现，将所有行为分发到具体type实现
@@ -33,6 +36,9 @@ class Type {
   virtual bool CompareEquals(const Value &left, const Value &right) const = 0;
   virtual bool CompareLessThan(const Value &left, const Value &right) const = 0;  // for b+tree
 
+  // hash (调用方先处理 NULL)
+  virtual uint64_t Hash(const Value &val) const = 0;
+
   // debug
   virtual std::string ToString(const Value &val) const = 0;
 
@@ -1,10 +1,34 @@
 #pragma once
 
+#include <cstdint>
+
 namespace bustub {
 enum TypeId {
   INVALID = 0,
-  INTEGER = 1,  // int32_t
-  VARCHAR = 2,  // string
-                // ...
+  INTEGER = 1,    // int32_t
+  VARCHAR = 2,    // string
+  BIGINT = 3,     // int64_t
+  DOUBLE = 4,     // double
+  BOOLEAN = 5,    // 1 byte, 0 / 1
+  DATE = 6,       // int32_t, days since 1970-01-01
+  TIMESTAMP = 7,  // int64_t, microseconds since 1970-01-01 00:00:00
+                  // ...
 };
-}
\ No newline at end of file
+
+// 定长类型的值宽度 (字节)，变长和无效类型返回 0
+inline uint32_t GetFixedTypeSize(TypeId type_id) {
+  switch (type_id) {
+    case INTEGER:
+    case DATE:
+      return 4;
+    case BIGINT:
+    case DOUBLE:
+    case TIMESTAMP:
+      return 8;
+    case BOOLEAN:
+      return 1;
+    default:
+      return 0;
+  }
+}
+}  // namespace bustub
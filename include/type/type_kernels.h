@@ -0,0 +1,123 @@
+/*
+  按类型特化的比较/序列化内核
+
+  Type 单例走 GetInstance + switch + 虚函数，内层循环里没法内联。
+  这里把每种类型的操作写成 TypeKernel<T> 的静态内联函数：
+  - 编译期已知类型时直接调用 TypeKernel<T>，可以被完全内联
+  - 运行期按列类型在计划阶段取一次 ValueKernels (函数指针表)，之后每行只是一次直接调用
+  内核不处理 NULL，调用方先判 IsNull。
+  HashRaw 直接对 tuple 里序列化好的字节求哈希，结果和 Hash(Value) 一致。
+*/
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "common/hash_util.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+// 各存储格式的哈希，整数统一按 int64
+inline uint64_t HashOf(int32_t val) { return HashUtil::HashInt(val); }
+inline uint64_t HashOf(int64_t val) { return HashUtil::HashInt(val); }
+inline uint64_t HashOf(double val) { return HashUtil::HashDouble(val); }
+inline uint64_t HashOf(bool val) { return HashUtil::HashInt(val ? 1 : 0); }
+
+// 比较符 ("常量 op 列" 在编译表达式时已经翻转成 "列 op' 常量")
+enum class CompareOp { EQ, NE, LT, LE, GT, GE };
+
+template <TypeId type_id>
+struct TypeKernel;
+
+// 定长类型共用的内核：T 是值在 tuple 里的存储格式，Get 从 Value 里取出它
+template <typename T, T (Value::*Get)() const>
+struct FixedWidthKernel {
+  static inline bool Equals(const Value &left, const Value &right) {
+    return (left.*Get)() == (right.*Get)();
+  }
+  static inline bool LessThan(const Value &left, const Value &right) {
+    return (left.*Get)() < (right.*Get)();
+  }
+  static inline void Serialize(const Value &val, char *storage) {
+    T raw_val = (val.*Get)();
+    std::memcpy(storage, &raw_val, sizeof(raw_val));
+  }
+  static inline uint64_t Hash(const Value &val) { return HashOf((val.*Get)()); }
+  static inline uint64_t HashRaw(const char *storage) {
+    T raw_val;
+    std::memcpy(&raw_val, storage, sizeof(raw_val));
+    return HashOf(raw_val);
+  }
+};
+
+template <>
+struct TypeKernel<TypeId::INTEGER>
+    : FixedWidthKernel<int32_t, &Value::GetAsInteger> {};
+template <>
+struct TypeKernel<TypeId::BIGINT>
+    : FixedWidthKernel<int64_t, &Value::GetAsBigInt> {};
+template <>
+struct TypeKernel<TypeId::DOUBLE>
+    : FixedWidthKernel<double, &Value::GetAsDouble> {};
+template <>
+struct TypeKernel<TypeId::BOOLEAN>
+    : FixedWidthKernel<bool, &Value::GetAsBoolean> {};
+template <>
+struct TypeKernel<TypeId::DATE>
+    : FixedWidthKernel<int32_t, &Value::GetAsInteger> {};
+template <>
+struct TypeKernel<TypeId::TIMESTAMP>
+    : FixedWidthKernel<int64_t, &Value::GetAsBigInt> {};
+
+template <>
+struct TypeKernel<TypeId::VARCHAR> {
+  static inline bool Equals(const Value &left, const Value &right) {
+    uint32_t len = left.GetLogicLength();
+    return len == right.GetLogicLength() &&
+           std::memcmp(left.GetAsVarChar(), right.GetAsVarChar(), len) == 0;
+  }
+  static inline bool LessThan(const Value &left, const Value &right) {
+    uint32_t len1 = left.GetLogicLength();
+    uint32_t len2 = right.GetLogicLength();
+    // 只比较公共部分，相同时短的更小
+    int cmp = std::memcmp(left.GetAsVarChar(), right.GetAsVarChar(),
+                          std::min(len1, len2));
+    return cmp != 0 ? cmp < 0 : len1 < len2;
+  }
+  // [uint32 len][bytes]
+  static inline void Serialize(const Value &val, char *storage) {
+    uint32_t len = val.GetLogicLength();
+    std::memcpy(storage, &len, sizeof(len));
+    std::memcpy(storage + sizeof(len), val.GetAsVarChar(), len);
+  }
+  static inline uint64_t Hash(const Value &val) {
+    return HashUtil::HashBytes(val.GetAsVarChar(), val.GetLogicLength());
+  }
+  static inline uint64_t HashRaw(const char *storage) {
+    uint32_t len;
+    std::memcpy(&len, storage, sizeof(len));
+    return HashUtil::HashBytes(storage + sizeof(len), len);
+  }
+};
+
+// 某一列的内核函数指针，计划阶段按列类型选定
+struct ValueKernels {
+  using CompareFn = bool (*)(const Value &, const Value &);
+  using SerializeFn = void (*)(const Value &, char *);
+  using HashFn = uint64_t (*)(const Value &);
+  using HashRawFn = uint64_t (*)(const char *);
+
+  CompareFn equals_;
+  CompareFn less_than_;
+  SerializeFn serialize_;
+  HashFn hash_;
+  HashRawFn hash_raw_;
+
+  // 不支持的类型返回 nullptr
+  static const ValueKernels *Get(TypeId type_id);
+};
+
+}  // namespace bustub
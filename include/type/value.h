@@ -1,5 +1,8 @@
 /*
   数据容器,所有类型都用这个存，使用union复用内存
+
+  短字符串 (<= INLINE_CAPACITY 字节) 直接放在 union 里，不走堆分配；
+  长字符串才 new char[]。移动构造/赋值只搬指针，不拷贝字符串。
 */
 
 #pragma once
@@ -16,22 +19,40 @@ namespace bustub {
 class Type;
 class Value {
  public:
+  // 不超过这个长度的字符串内联存放
+  static constexpr uint32_t INLINE_CAPACITY = 15;
+
+  // NULL 构造：指定类型的空值
+  explicit Value(TypeId type_id);
   // 整数构造
   Value(const int32_t integer);
+  // 整数存储的类型：BIGINT / BOOLEAN / DATE / TIMESTAMP (也可以是 INTEGER)
+  Value(TypeId type_id, int64_t raw);
+  // 浮点构造
+  Value(const double decimal);
   // 字符串构造
-  Value(const std::string str);
+  Value(const std::string &str);
+  Value(const char *data, uint32_t len);
   // destructor
   ~Value();
 
   // 拷贝构造
   Value(const Value &other);
   Value & operator=(const Value &other);
+  // 移动构造：长字符串直接接管对方的堆内存
+  Value(Value &&other) noexcept;
+  Value & operator=(Value &&other) noexcept;
 
   // = data access =
-  inline int32_t GetAsInteger() const { return value_.integer_; }
-  inline const char *GetAsVarChar() const { return value_.varchar_; }
+  inline int32_t GetAsInteger() const { return value_.integer_; }  // INTEGER / DATE
+  inline int64_t GetAsBigInt() const { return value_.bigint_; }     // BIGINT / TIMESTAMP
+  inline double GetAsDouble() const { return value_.decimal_; }
+  inline bool GetAsBoolean() const { return value_.boolean_; }
+  inline const char *GetAsVarChar() const {
+    return IsInlineVarChar() ? value_.inline_ : value_.varchar_;
+  }
   inline uint32_t GetLogicLength() const { return logic_len_; }   // 字符串长度
-  inline TypeId GetTypeId() const { return type_id_; }            
+  inline TypeId GetTypeId() const { return type_id_; }
   inline uint32_t GetStorageSize() const { return storage_size_; }  // 可变长数据的最大上限(初始分配)
   inline bool IsNull() const { return is_null_; }
 
@@ -40,21 +61,39 @@ class Value {
   void SerializeTo(char *storage) const;
   // trans storage to value
   static Value DeserializeFrom(const char *storage, TypeId type_id);
-  // compare
+  // compare (任一侧为 NULL 时都为 false)
   bool CompareEquals(const Value &other) const;
   bool CompareLessThan(const Value &other) const;
+  // 64 位哈希，NULL 有固定的哈希值；数值相等的 INTEGER / BIGINT 哈希相同
+  uint64_t Hash() const;
   // debug
   std::string ToString() const;
 
+  // 转成目标类型 (插入/更新/过滤时把字面量对齐到列类型)，无法转换时抛 CONVERSION 异常
+  Value CastAs(TypeId type_id) const;
+
  private:
+  inline bool IsInlineVarChar() const { return logic_len_ <= INLINE_CAPACITY; }
+  // 持有堆内存时才需要释放 / 移交
+  inline bool OwnsHeap() const {
+    return type_id_ == TypeId::VARCHAR && !is_null_ && !IsInlineVarChar();
+  }
+  void CopyFrom(const Value &other);
+  void MoveFrom(Value &&other);
+  void Release();
+
   TypeId type_id_;
   uint32_t storage_size_;  // bytes
   uint32_t logic_len_;     // for varchar
-  bool is_null_;
+  bool is_null_{false};
 
   union Val {
     int32_t integer_;
-    char *varchar_;  // varchar pointer
+    int64_t bigint_;
+    double decimal_;
+    bool boolean_;
+    char *varchar_;                       // varchar pointer (长字符串)
+    char inline_[INLINE_CAPACITY + 1];    // 短字符串，带 '\0'
   } value_;
 };
-}  // namespace bustub
\ No newline at end of file
+}  // namespace bustub
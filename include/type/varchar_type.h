@@ -19,6 +19,9 @@ class VarCharType : public Type {
   bool CompareLessThan(const Value &left,
                        const Value &right) const override;
 
+  uint64_t Hash(const Value &val) const override;
+
+
   std::string ToString(const Value &val) const override;
 };
 
@@ -56,14 +56,12 @@ auto BufferPoolManager::FetchPage(table_id_t table_id,
   } else {
     if (!replacer_->Evict(&frame_id)) return nullptr;
     page = &pages_[frame_id];
-    if (page->IsDirty()) {
-      // Find old key and flush
-      for (auto& [old_key, old_frame_id] : page_table_) {
-        if (old_frame_id == frame_id) {
-          FlushPageInternal(old_key);
-          page_table_.erase(old_key);
-          break;
-        }
+    // Find old key, flush if dirty, and always drop the stale mapping
+    for (auto& [old_key, old_frame_id] : page_table_) {
+      if (old_frame_id == frame_id) {
+        if (page->IsDirty()) FlushPageInternal(old_key);
+        page_table_.erase(old_key);
+        break;
       }
     }
     page->ResetMemory();
@@ -160,9 +158,10 @@ auto BufferPoolManager::NewPage(table_id_t table_id,
                                 page_id_t* page_id) -> Page* {
   std::lock_guard<std::mutex> lock(latch_);
 
-  // Get next page id for this table
+  // Get next page id for this table (continue after pages already on disk)
   if (table_next_page_id_.find(table_id) == table_next_page_id_.end()) {
-    table_next_page_id_[table_id] = 0;
+    table_next_page_id_[table_id] =
+        static_cast<page_id_t>(disk_manager_->GetNumPages(table_id));
   }
 
   page_id_t new_page_id = table_next_page_id_[table_id]++;
@@ -179,13 +178,12 @@ auto BufferPoolManager::NewPage(table_id_t table_id,
   } else {
     if (!replacer_->Evict(&frame_id)) return nullptr;
     page = &pages_[frame_id];
-    if (page->IsDirty()) {
-      for (auto& [old_key, old_frame_id] : page_table_) {
-        if (old_frame_id == frame_id) {
-          FlushPageInternal(old_key);
-          page_table_.erase(old_key);
-          break;
-        }
+    // Find old key, flush if dirty, and always drop the stale mapping
+    for (auto& [old_key, old_frame_id] : page_table_) {
+      if (old_frame_id == frame_id) {
+        if (page->IsDirty()) FlushPageInternal(old_key);
+        page_table_.erase(old_key);
+        break;
       }
     }
     page->ResetMemory();
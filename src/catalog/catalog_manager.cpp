@@ -8,6 +8,7 @@
 #include "catalog/schema.h"
 #include "catalog/table_info.h"
 #include "storage/disk/disk_manager.h"
+#include "storage/table/dictionary.h"
 #include "storage/table/table_heap.h"
 #include "storage/table/table_page.h"
 
@@ -27,16 +28,19 @@ CatalogManager::CatalogManager(BufferPoolManager* bpm,
     TableInfo* info = catalog_meta_->GetTable(table_name);
     if (info) {
       disk_manager_->OpenTableFile(info->GetId(), table_name);
+      AttachDictionaries(info->GetId(), info->GetSchema());
     }
   }
 }
 
 CatalogManager::~CatalogManager() {
+  catalog_meta_->SaveToDisk();
   delete catalog_meta_;
 }
 
 TableInfo* CatalogManager::CreateTable(const std::string& name,
-                                       const Schema& schema) {
+                                       const Schema& schema,
+                                       TableLayout layout) {
   // Check if table already exists
   if (catalog_meta_->GetTable(name) != nullptr) {
     return nullptr;
@@ -50,29 +54,33 @@ TableInfo* CatalogManager::CreateTable(const std::string& name,
     return nullptr;
   }
 
-  // Create first page for the table
-  page_id_t first_page_id;
-  Page* first_page = bpm_->NewPage(table_id, &first_page_id);
-  if (!first_page) {
+  // Create first page and page directory for the table
+  TableHeap table_heap(bpm_, table_id, &schema, layout);
+  page_id_t directory_page_id = table_heap.GetDirectoryPageId();
+  if (directory_page_id == INVALID_PAGE_ID) {
     disk_manager_->DeleteTableFile(table_id, name);
     return nullptr;
   }
 
-  // Initialize table page
-  TablePage* table_page = reinterpret_cast<TablePage*>(first_page);
-  table_page->Init(first_page_id);
-
-  bpm_->UnpinPage(table_id, first_page_id, true);
+  // Dictionary-encoded columns keep their entries in the table file
+  if (!AttachDictionaries(table_id, schema)) {
+    bpm_->DeletePage(table_id, table_heap.GetFirstPageId());
+    bpm_->DeletePage(table_id, directory_page_id);
+    disk_manager_->DeleteTableFile(table_id, name);
+    return nullptr;
+  }
 
   // Create table info
   auto table_info =
-      std::make_unique<TableInfo>(table_id, name, schema, first_page_id);
+      std::make_unique<TableInfo>(table_id, name, schema, directory_page_id);
+  *table_info->GetStats() = *table_heap.GetStats();
   TableInfo* info_ptr = table_info.get();
 
   // Add to catalog (will auto-save to disk)
   if (!catalog_meta_->AddTable(std::move(table_info))) {
     // Cleanup on failure
-    bpm_->DeletePage(table_id, first_page_id);
+    bpm_->DeletePage(table_id, table_heap.GetFirstPageId());
+    bpm_->DeletePage(table_id, directory_page_id);
     disk_manager_->DeleteTableFile(table_id, name);
     return nullptr;
   }
@@ -117,6 +125,21 @@ bool CatalogManager::DropTable(table_id_t tid) {
   return DropTable(info->GetName());
 }
 
+bool CatalogManager::AttachDictionaries(table_id_t table_id,
+                                        const Schema& schema) {
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    Dictionary* dict = schema.GetColumn(i).GetDictionary();
+    if (dict != nullptr && !dict->Attach(bpm_, table_id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CatalogManager::Flush() {
+  return catalog_meta_->SaveToDisk();
+}
+
 std::vector<std::string> CatalogManager::GetTableNames() const {
   return catalog_meta_->GetTableNames();
 }
@@ -7,6 +7,7 @@
 #include "catalog/column.h"
 #include "catalog/schema.h"
 #include "catalog/table_info.h"
+#include "storage/table/dictionary.h"
 
 namespace bustub {
 
@@ -121,10 +122,10 @@ bool CatalogMeta::SerializeTo(std::ofstream& out) const {
     out.write(reinterpret_cast<const char*>(&name_len), sizeof(name_len));
     out.write(table_name.c_str(), name_len);
 
-    // Write first page id
-    page_id_t first_page_id = table_info->GetFirstPageId();
-    out.write(reinterpret_cast<const char*>(&first_page_id),
-              sizeof(first_page_id));
+    // Write page directory id
+    page_id_t directory_page_id = table_info->GetDirectoryPageId();
+    out.write(reinterpret_cast<const char*>(&directory_page_id),
+              sizeof(directory_page_id));
 
     // Write schema
     const Schema& schema = table_info->GetSchema();
@@ -159,7 +160,26 @@ bool CatalogMeta::SerializeTo(std::ofstream& out) const {
       uint32_t col_storage_size = col.GetStorageSize();
       out.write(reinterpret_cast<const char*>(&col_storage_size),
                 sizeof(col_storage_size));
+
+      // Write dictionary: first page of its chain in the table file,
+      // INVALID_PAGE_ID if the column is not dictionary encoded
+      const Dictionary* dict = col.GetDictionary();
+      page_id_t dict_page_id =
+          dict == nullptr ? INVALID_PAGE_ID : dict->GetFirstPageId();
+      out.write(reinterpret_cast<const char*>(&dict_page_id),
+                sizeof(dict_page_id));
     }
+
+    // Write table stats
+    const TableStats& stats = *table_info->GetStats();
+    out.write(reinterpret_cast<const char*>(&stats.live_tuples_),
+              sizeof(stats.live_tuples_));
+    out.write(reinterpret_cast<const char*>(&stats.dead_tuples_),
+              sizeof(stats.dead_tuples_));
+    out.write(reinterpret_cast<const char*>(&stats.page_count_),
+              sizeof(stats.page_count_));
+    out.write(reinterpret_cast<const char*>(&stats.tuple_bytes_),
+              sizeof(stats.tuple_bytes_));
   }
 
   return out.good();
@@ -200,9 +220,10 @@ bool CatalogMeta::DeserializeFrom(std::ifstream& in) {
     std::string table_name(name_len, '\0');
     in.read(&table_name[0], name_len);
 
-    // Read first page id
-    page_id_t first_page_id;
-    in.read(reinterpret_cast<char*>(&first_page_id), sizeof(first_page_id));
+    // Read page directory id
+    page_id_t directory_page_id;
+    in.read(reinterpret_cast<char*>(&directory_page_id),
+            sizeof(directory_page_id));
 
     // Read schema
     // Read schema name
@@ -238,16 +259,41 @@ bool CatalogMeta::DeserializeFrom(std::ifstream& in) {
       in.read(reinterpret_cast<char*>(&col_storage_size),
               sizeof(col_storage_size));
 
+      // Read dictionary (entries are loaded from the table file on attach)
+      page_id_t dict_page_id;
+      in.read(reinterpret_cast<char*>(&dict_page_id), sizeof(dict_page_id));
+      std::shared_ptr<Dictionary> dict;
+      if (dict_page_id != INVALID_PAGE_ID) {
+        if (col_type != TypeId::VARCHAR) {
+          return false;
+        }
+        dict = std::make_shared<Dictionary>(dict_page_id);
+      }
+
       // Create column
-      if (col_type == TypeId::INTEGER) {
+      if (GetFixedTypeSize(col_type) > 0) {
         columns.emplace_back(col_name, col_type);
       } else if (col_type == TypeId::VARCHAR) {
         columns.emplace_back(col_name, col_type, col_storage_size);
+        if (dict != nullptr) {
+          columns.back().SetDictionary(std::move(dict));
+        }
       } else {
         return false;
       }
     }
 
+    // Read table stats
+    TableStats stats;
+    in.read(reinterpret_cast<char*>(&stats.live_tuples_),
+            sizeof(stats.live_tuples_));
+    in.read(reinterpret_cast<char*>(&stats.dead_tuples_),
+            sizeof(stats.dead_tuples_));
+    in.read(reinterpret_cast<char*>(&stats.page_count_),
+            sizeof(stats.page_count_));
+    in.read(reinterpret_cast<char*>(&stats.tuple_bytes_),
+            sizeof(stats.tuple_bytes_));
+
     if (!in.good()) {
       return false;
     }
@@ -255,7 +301,8 @@ bool CatalogMeta::DeserializeFrom(std::ifstream& in) {
     // Create schema and table info
     Schema schema(schema_name, columns);
     auto table_info = std::make_unique<TableInfo>(table_id, table_name, schema,
-                                                  first_page_id);
+                                                  directory_page_id);
+    *table_info->GetStats() = stats;
 
     // Add to maps without flushing (we'll flush once at the end)
     if (!AddTableInternal(std::move(table_info))) {
@@ -5,13 +5,13 @@
 namespace bustub {
 Column::Column(std::string name, TypeId type)
     : name_(std::move(name)), type_(type) {
-  if (type_ == TypeId::INTEGER) {
-    storage_size_ = 4;  // int32_t
-  } else {
-    // futrue case: BIGINT or others
+  // INTEGER / BIGINT / DOUBLE / BOOLEAN / DATE / TIMESTAMP
+  storage_size_ = GetFixedTypeSize(type_);
+  if (storage_size_ == 0) {
+    // 变长或未知类型不能走这个构造
     type_ = TypeId::INVALID;
-    storage_size_ = 0;
   }
+  fixed_length_ = storage_size_;
   // 偏移量初始化为0，稍后由 Schema 计算
   column_offset_ = 0;
 }
@@ -25,6 +25,8 @@ Column::Column(std::string name, TypeId type, std::size_t storage_size)
     type_ = TypeId::INVALID;
     storage_size_ = 0;
   }
+  // 定长区只存一个 uint32_t 偏移，指向 tuple 尾部变长区里的 [len][bytes]
+  fixed_length_ = type_ == TypeId::VARCHAR ? sizeof(uint32_t) : 0;
 
   column_offset_ = 0;
 }
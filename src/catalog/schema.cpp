@@ -11,12 +11,12 @@ Schema::Schema(std::string name, std::vector<Column> columns)
   is_inlined_ = true;
   uint32_t offset = 0;
   for (auto &col : columns_) {
-    if (col.GetType() != TypeId::INTEGER) {
+    if (!col.IsInlined() || col.GetType() == TypeId::INVALID) {
       is_inlined_ = false;
     }
 
     col.column_offset_ = offset;
-    offset += col.GetStorageSize();
+    offset += col.GetFixedLength();
   }
   storage_size_ = offset;
 }
@@ -5,11 +5,11 @@
 namespace bustub {
 
 TableInfo::TableInfo(table_id_t tid, std::string name, Schema schema,
-                     page_id_t first_page_id)
+                     page_id_t directory_page_id)
   : tid_(tid),
     name_(std::move(name)),
     schema_(schema),
-    first_page_id_(first_page_id) {}
+    directory_page_id_(directory_page_id) {}
 
 table_id_t TableInfo::GetId() const {
   return tid_;
@@ -23,8 +23,8 @@ const Schema& TableInfo::GetSchema() const {
   return schema_;
 }
 
-page_id_t TableInfo::GetFirstPageId() const {
-  return first_page_id_;
+page_id_t TableInfo::GetDirectoryPageId() const {
+  return directory_page_id_;
 }
 
 }  // namespace bustub
\ No newline at end of file
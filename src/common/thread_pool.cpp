@@ -0,0 +1,124 @@
+#include "common/thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace bustub {
+
+namespace {
+thread_local int current_worker = -1;
+}  // namespace
+
+ThreadPool::ThreadPool(uint32_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  for (uint32_t i = 0; i < num_threads; i++) {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+  for (uint32_t i = 0; i < num_threads; i++) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> guard(idle_latch_);
+    stop_ = true;
+  }
+  idle_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+int ThreadPool::CurrentWorker() { return current_worker; }
+
+void ThreadPool::RunAll(std::vector<Task> tasks) {
+  if (tasks.empty()) {
+    return;
+  }
+  std::mutex done_latch;
+  std::condition_variable done_cv;
+  std::size_t pending = tasks.size();
+  std::exception_ptr error;
+
+  // 先计数再放进队列：已经醒着的 worker 可能马上取走任务并减计数，
+  // 计数在前才不会减到 0 以下 (无符号数回绕后空闲的 worker 会一直空转)
+  {
+    std::lock_guard<std::mutex> guard(idle_latch_);
+    queued_ += tasks.size();
+  }
+  for (std::size_t i = 0; i < tasks.size(); i++) {
+    Task wrapped = [&, task = std::move(tasks[i])] {
+      std::exception_ptr task_error;
+      try {
+        task();
+      } catch (...) {
+        task_error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> guard(done_latch);
+      if (task_error && !error) {
+        error = task_error;
+      }
+      if (--pending == 0) {
+        done_cv.notify_one();
+      }
+    };
+    WorkQueue& queue = *queues_[i % queues_.size()];
+    std::lock_guard<std::mutex> guard(queue.latch_);
+    queue.tasks_.push_back(std::move(wrapped));
+  }
+  idle_cv_.notify_all();
+
+  std::unique_lock<std::mutex> lock(done_latch);
+  done_cv.wait(lock, [&] { return pending == 0; });
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void ThreadPool::WorkerLoop(uint32_t index) {
+  current_worker = static_cast<int>(index);
+  Task task;
+  while (true) {
+    if (PopLocal(index, &task) || Steal(index, &task)) {
+      queued_--;
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(idle_latch_);
+    idle_cv_.wait(lock, [this] { return stop_ || queued_ > 0; });
+    if (stop_ && queued_ == 0) {
+      return;
+    }
+  }
+}
+
+bool ThreadPool::PopLocal(uint32_t index, Task* task) {
+  WorkQueue& queue = *queues_[index];
+  std::lock_guard<std::mutex> guard(queue.latch_);
+  if (queue.tasks_.empty()) {
+    return false;
+  }
+  *task = std::move(queue.tasks_.back());
+  queue.tasks_.pop_back();
+  return true;
+}
+
+bool ThreadPool::Steal(uint32_t index, Task* task) {
+  for (std::size_t i = 1; i < queues_.size(); i++) {
+    WorkQueue& queue = *queues_[(index + i) % queues_.size()];
+    std::lock_guard<std::mutex> guard(queue.latch_);
+    if (!queue.tasks_.empty()) {
+      *task = std::move(queue.tasks_.front());
+      queue.tasks_.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace bustub
@@ -0,0 +1,740 @@
+#include "execution/aggregation_executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "common/config.h"
+#include "common/exception.h"
+#include "common/hash_util.h"
+#include "execution/pipeline.h"
+#include "sql/Expr.h"
+#include "type/key_encoder.h"
+#include "type/type.h"
+
+namespace bustub {
+
+namespace {
+constexpr uint32_t NO_GROUP = UINT32_MAX;
+
+// 整数 SUM / AVG 累加一个值。SUM 的结果是 BIGINT，溢出报错；
+// AVG 的结果是 DOUBLE，整数和放不下时并进 double_sum 继续累加
+void AddToSum(int64_t value, AggregationType type, int64_t* int_sum,
+              double* double_sum) {
+  int64_t result;
+  if (!__builtin_add_overflow(*int_sum, value, &result)) {
+    *int_sum = result;
+    return;
+  }
+  if (type == AggregationType::SUM) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "SUM out of BIGINT range");
+  }
+  *double_sum += static_cast<double>(*int_sum) + static_cast<double>(value);
+  *int_sum = 0;
+}
+
+std::string FunctionName(const hsql::Expr* expr) {
+  std::string name = expr->name == nullptr ? "" : expr->name;
+  std::transform(name.begin(), name.end(), name.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return name;
+}
+
+bool IsAggregateCall(const hsql::Expr* expr) {
+  if (expr == nullptr || expr->type != hsql::kExprFunctionRef) return false;
+  std::string name = FunctionName(expr);
+  return name == "count" || name == "sum" || name == "min" || name == "max" ||
+         name == "avg";
+}
+
+// 两个表达式写法相同 (函数名不分大小写)，用来把 HAVING 里的聚合对上 SELECT 列表
+bool SameExpr(const hsql::Expr* a, const hsql::Expr* b) {
+  if (a == nullptr || b == nullptr) return a == b;
+  if (a->type != b->type || a->opType != b->opType || a->ival != b->ival ||
+      a->ival2 != b->ival2 || a->fval != b->fval ||
+      a->distinct != b->distinct || a->isBoolLiteral != b->isBoolLiteral) {
+    return false;
+  }
+  auto same_str = [](const char* x, const char* y) {
+    return x == nullptr || y == nullptr ? x == y : std::strcmp(x, y) == 0;
+  };
+  if (a->type == hsql::kExprFunctionRef) {
+    if (FunctionName(a) != FunctionName(b)) return false;
+  } else if (!same_str(a->name, b->name)) {
+    return false;
+  }
+  if (!same_str(a->table, b->table) || !SameExpr(a->expr, b->expr) ||
+      !SameExpr(a->expr2, b->expr2)) {
+    return false;
+  }
+  if (a->exprList == nullptr || b->exprList == nullptr) {
+    return a->exprList == b->exprList;
+  }
+  if (a->exprList->size() != b->exprList->size()) return false;
+  for (std::size_t i = 0; i < a->exprList->size(); i++) {
+    if (!SameExpr(a->exprList->at(i), b->exprList->at(i))) return false;
+  }
+  return true;
+}
+
+bool IsNumeric(TypeId type_id) {
+  return type_id == TypeId::INTEGER || type_id == TypeId::BIGINT ||
+         type_id == TypeId::DOUBLE || type_id == TypeId::INVALID;
+}
+}  // namespace
+
+AggregationExecutor::AggregationExecutor(
+    std::unique_ptr<Executor> child,
+    const std::vector<hsql::Expr*>& select_list,
+    const std::vector<hsql::Expr*>* group_by, const Schema* input_schema)
+  : child_(std::move(child)), input_schema_(input_schema) {
+  // GROUP BY 里直接引用的列，非聚合的输出项只能用这些列
+  std::vector<uint32_t> group_columns;
+  if (group_by != nullptr) {
+    for (const hsql::Expr* item : *group_by) {
+      if (item == nullptr) {
+        throw Exception(ExceptionType::EXECUTION, "incomplete GROUP BY");
+      }
+      group_by_.push_back(ExprCompiler::Compile(item, input_schema));
+      uint32_t col_idx;
+      if (group_by_.back()->AsColumnRef(&col_idx)) {
+        group_columns.push_back(col_idx);
+      }
+    }
+  }
+
+  std::vector<Column> columns;
+  for (const hsql::Expr* item : select_list) {
+    if (item == nullptr) {
+      throw Exception(ExceptionType::EXECUTION, "incomplete select list");
+    }
+    if (item->type == hsql::kExprStar) {
+      throw Exception(ExceptionType::EXECUTION,
+                      "SELECT * cannot be used with aggregation");
+    }
+    std::string name = "?column?";
+    if (item->alias != nullptr) {
+      name = item->alias;
+    } else if (item->type == hsql::kExprColumnRef && item->name != nullptr) {
+      name = item->name;
+    } else if (item->type == hsql::kExprFunctionRef) {
+      name = FunctionName(item);
+    }
+
+    if (IsAggregateCall(item)) {
+      BindAggregate(item, input_schema);
+      aggregate_calls_.push_back(item);
+      outputs_.push_back(OutputItem{
+          true, static_cast<uint32_t>(aggregates_.size() - 1), nullptr});
+      columns.push_back(
+          AggregateColumn(std::move(name), aggregates_.back(), input_schema));
+      continue;
+    }
+
+    auto expr = ExprCompiler::Compile(item, input_schema);
+    std::vector<uint32_t> cols;
+    expr->CollectColumns(&cols);
+    for (uint32_t col_idx : cols) {
+      if (std::find(group_columns.begin(), group_columns.end(), col_idx) ==
+          group_columns.end()) {
+        throw Exception(ExceptionType::EXECUTION,
+                        "column '" + input_schema->GetColumn(col_idx).GetName() +
+                            "' must appear in GROUP BY or be aggregated");
+      }
+    }
+    keep_row_ = true;
+    columns.push_back(
+        ExprCompiler::OutputColumn(std::move(name), *expr, input_schema));
+    outputs_.push_back(OutputItem{false, 0, std::move(expr)});
+  }
+  output_schema_ = std::make_unique<Schema>(input_schema->GetName(), columns);
+
+  for (const auto& expr : group_by_) {
+    expr->CollectColumns(&input_columns_);
+  }
+  for (const auto& agg : aggregates_) {
+    if (agg.arg_ != nullptr) agg.arg_->CollectColumns(&input_columns_);
+  }
+  for (const auto& item : outputs_) {
+    if (item.expr_ != nullptr) item.expr_->CollectColumns(&input_columns_);
+  }
+}
+
+bool AggregationExecutor::HasAggregate(
+    const std::vector<hsql::Expr*>& select_list) {
+  return std::any_of(select_list.begin(), select_list.end(), IsAggregateCall);
+}
+
+void AggregationExecutor::BindAggregate(const hsql::Expr* item,
+                                        const Schema* input_schema) {
+  std::string name = FunctionName(item);
+  if (item->distinct) {
+    throw Exception(ExceptionType::NOT_IMPLEMENTED,
+                    name + "(DISTINCT ...) is not supported");
+  }
+  if (item->exprList == nullptr || item->exprList->size() != 1 ||
+      item->exprList->at(0) == nullptr) {
+    throw Exception(ExceptionType::EXECUTION,
+                    name + "() takes exactly one argument");
+  }
+  const hsql::Expr* arg = item->exprList->at(0);
+
+  Aggregate agg;
+  if (arg->type == hsql::kExprStar) {
+    if (name != "count") {
+      throw Exception(ExceptionType::EXECUTION, name + "(*) is not allowed");
+    }
+    agg.type_ = AggregationType::COUNT_STAR;
+    aggregates_.push_back(std::move(agg));
+    return;
+  }
+
+  agg.arg_ = ExprCompiler::Compile(arg, input_schema);
+  if (name == "count") {
+    agg.type_ = AggregationType::COUNT;
+  } else if (name == "min") {
+    agg.type_ = AggregationType::MIN;
+  } else if (name == "max") {
+    agg.type_ = AggregationType::MAX;
+  } else {
+    agg.type_ = name == "sum" ? AggregationType::SUM : AggregationType::AVG;
+    TypeId type_id = agg.arg_->GetReturnType();
+    if (!IsNumeric(type_id)) {
+      throw Exception(ExceptionType::MISMATCH_TYPE,
+                      name + "() needs a numeric argument, not " +
+                          Type::TypeIdToString(type_id));
+    }
+  }
+  aggregates_.push_back(std::move(agg));
+}
+
+void AggregationExecutor::SetHaving(const hsql::Expr* having) {
+  std::vector<Column> columns;
+  for (uint32_t i = 0; i < output_schema_->GetColumnCount(); i++) {
+    columns.push_back(output_schema_->GetColumn(i));
+  }
+  // 先找出所有聚合调用 (不进入聚合的参数) 定下列号，再按扩展后的 schema 编译
+  std::vector<std::pair<const hsql::Expr*, uint32_t>> bound;
+  std::vector<const hsql::Expr*> stack{having};
+  while (!stack.empty()) {
+    const hsql::Expr* expr = stack.back();
+    stack.pop_back();
+    if (expr == nullptr) continue;
+    if (IsAggregateCall(expr)) {
+      bound.emplace_back(expr, BindHavingAggregate(expr, &columns));
+      continue;
+    }
+    stack.push_back(expr->expr);
+    stack.push_back(expr->expr2);
+    if (expr->exprList != nullptr) {
+      stack.insert(stack.end(), expr->exprList->begin(), expr->exprList->end());
+    }
+  }
+  having_schema_ = std::make_unique<Schema>(output_schema_->GetName(), columns);
+  having_ = ExprCompiler::Compile(
+      having, having_schema_.get(), [&bound](const hsql::Expr* expr) {
+        for (const auto& [call, col_idx] : bound) {
+          if (call == expr) return static_cast<int>(col_idx);
+        }
+        return -1;
+      });
+  TypeId type_id = having_->GetReturnType();
+  if (type_id != TypeId::BOOLEAN && type_id != TypeId::INVALID) {
+    throw Exception(ExceptionType::MISMATCH_TYPE,
+                    "HAVING must be BOOLEAN, not " +
+                        Type::TypeIdToString(type_id));
+  }
+}
+
+uint32_t AggregationExecutor::BindHavingAggregate(
+    const hsql::Expr* call, std::vector<Column>* columns) {
+  for (uint32_t i = 0; i < outputs_.size(); i++) {
+    if (outputs_[i].is_aggregate_ &&
+        SameExpr(aggregate_calls_[outputs_[i].index_], call)) {
+      return i;
+    }
+  }
+  for (uint32_t k = 0; k < having_aggregates_.size(); k++) {
+    if (SameExpr(aggregate_calls_[having_aggregates_[k]], call)) {
+      return static_cast<uint32_t>(outputs_.size()) + k;
+    }
+  }
+  BindAggregate(call, input_schema_);
+  aggregate_calls_.push_back(call);
+  const Aggregate& agg = aggregates_.back();
+  if (agg.arg_ != nullptr) agg.arg_->CollectColumns(&input_columns_);
+  having_aggregates_.push_back(static_cast<uint32_t>(aggregates_.size() - 1));
+  columns->push_back(AggregateColumn(FunctionName(call), agg, input_schema_));
+  return static_cast<uint32_t>(columns->size() - 1);
+}
+
+Column AggregationExecutor::AggregateColumn(std::string name,
+                                            const Aggregate& agg,
+                                            const Schema* input_schema) const {
+  switch (agg.type_) {
+    case AggregationType::COUNT_STAR:
+    case AggregationType::COUNT:
+      return Column(std::move(name), TypeId::BIGINT);
+    case AggregationType::SUM:
+      return Column(std::move(name),
+                    agg.arg_->GetReturnType() == TypeId::DOUBLE
+                        ? TypeId::DOUBLE
+                        : TypeId::BIGINT);
+    case AggregationType::AVG:
+      return Column(std::move(name), TypeId::DOUBLE);
+    case AggregationType::MIN:
+    case AggregationType::MAX:
+      break;
+  }
+  return ExprCompiler::OutputColumn(std::move(name), *agg.arg_, input_schema);
+}
+
+bool AggregationExecutor::IsCountStarOnly() const {
+  return group_by_.empty() &&
+         std::all_of(aggregates_.begin(), aggregates_.end(),
+                     [](const Aggregate& agg) {
+                       return agg.type_ == AggregationType::COUNT_STAR;
+                     });
+}
+
+void AggregationExecutor::Init(ExecutionContext* exec_ctx) {
+  OpenSink(exec_ctx);
+  if (input_rows_ != UINT64_MAX && IsCountStarOnly()) {
+    InsertEmptyGroup();
+    for (auto& state : table_.states_) {
+      state.count_ = static_cast<int64_t>(input_rows_);
+    }
+    return;
+  }
+
+  if (pipeline_factory_ && exec_ctx->thread_pool_ != nullptr &&
+      exec_ctx->thread_pool_->GetThreadCount() > 1) {
+    ConsumeParallel();
+  } else {
+    child_->Init(exec_ctx);
+    ConsumeChild();
+  }
+  FinishSink();
+}
+
+void AggregationExecutor::OpenSink(ExecutionContext* exec_ctx) {
+  Executor::Init(exec_ctx);
+  table_.Clear();
+  table_.spill_.clear();
+  output_pos_ = 0;
+  pending_.clear();
+  spilled_ = false;
+  depth_ = 0;
+  aggregated_partitions_ = 0;
+}
+
+void AggregationExecutor::Sink(const DataChunk& chunk) {
+  uint32_t count = chunk.GetSelectedCount();
+  for (uint32_t k = 0; k < count; k++) {
+    uint32_t row = chunk.GetSelectedRow(k);
+    Accumulate(&table_, 0, exec_ctx_->memory_limit_, ExprInput(&chunk, row),
+               [&]() { return chunk.GetTuple(row); });
+  }
+}
+
+void AggregationExecutor::FinishSink() {
+  FinishLevel();
+  // 没有 GROUP BY 时空输入也有一行结果
+  if (group_by_.empty() && table_.groups_.empty()) {
+    InsertEmptyGroup();
+  }
+}
+
+void AggregationExecutor::BuildPipeline(PipelineBuilder* builder,
+                                        const Schema* schema) {
+  // 整表 COUNT(*) 用表统计，不需要子树
+  if (input_rows_ != UINT64_MAX && IsCountStarOnly()) {
+    builder->SetSource(this, schema, true);
+    return;
+  }
+  builder->SetSource(this, schema, false);
+  builder->AddChildPipeline(this, child_.get(), input_schema_);
+}
+
+void AggregationExecutor::InsertEmptyGroup() {
+  table_.Insert("", 0, HashUtil::HashBytes("", 0), Tuple(),
+                aggregates_.size());
+}
+
+void AggregationExecutor::ConsumeChild() {
+  // 向量化地从子执行器取数，只解码用到的列
+  input_ = std::make_unique<DataChunk>(input_schema_);
+  input_->SetNeededColumns(input_columns_);
+  while (child_->NextBatch(input_.get())) {
+    Sink(*input_);
+  }
+  input_.reset();
+}
+
+void AggregationExecutor::ConsumeParallel() {
+  ThreadPool* pool = exec_ctx_->thread_pool_;
+
+  // 每个线程一份流水线，在这里 (单线程) 建好并 Init，任务里只切换页范围。
+  // 线程数不超过 morsel 数，表太小 (不到两个 morsel) 时不值得并行，退回串行
+  std::vector<WorkerState> workers(1);
+  workers[0].pipeline_ = pipeline_factory_(&workers[0].scan_);
+  workers[0].pipeline_->Init(exec_ctx_);
+  std::size_t page_count = workers[0].scan_->GetPageCount();
+  if (page_count < 2 * MORSEL_PAGES) {
+    workers.clear();
+    child_->Init(exec_ctx_);
+    ConsumeChild();
+    return;
+  }
+  auto num_workers = static_cast<uint32_t>(std::min<std::size_t>(
+      pool->GetThreadCount(), page_count / MORSEL_PAGES));
+  std::size_t budget = exec_ctx_->memory_limit_ / num_workers;
+  workers.resize(num_workers);
+  for (WorkerState& worker : workers) {
+    if (worker.pipeline_ == nullptr) {
+      worker.pipeline_ = pipeline_factory_(&worker.scan_);
+      worker.pipeline_->Init(exec_ctx_);
+    }
+    worker.input_ = std::make_unique<DataChunk>(input_schema_);
+    worker.input_->SetNeededColumns(input_columns_);
+  }
+
+  // 每个 worker 一个任务，从共享的游标领取 morsel，先干完的多领，不用事先分匀。
+  // 最后一个 morsel 不设上界，扫描期间追加的页也算在内
+  std::atomic<std::size_t> next_morsel{0};
+  std::vector<ThreadPool::Task> tasks;
+  for (WorkerState& worker : workers) {
+    tasks.emplace_back([this, &worker, &next_morsel, page_count, budget]() {
+      DataChunk* input = worker.input_.get();
+      while (true) {
+        std::size_t begin = next_morsel.fetch_add(1) * MORSEL_PAGES;
+        if (begin >= page_count) break;
+        std::size_t end = begin + MORSEL_PAGES >= page_count
+                              ? std::numeric_limits<std::size_t>::max()
+                              : begin + MORSEL_PAGES;
+        worker.scan_->SetPageRange(begin, end);
+        while (worker.pipeline_->NextBatch(input)) {
+          uint32_t count = input->GetSelectedCount();
+          for (uint32_t k = 0; k < count; k++) {
+            uint32_t row = input->GetSelectedRow(k);
+            Accumulate(&worker.table_, 0, budget, ExprInput(input, row),
+                       [&]() { return input->GetTuple(row); });
+          }
+        }
+      }
+    });
+  }
+  pool->RunAll(std::move(tasks));
+
+  // 流水线断点：局部表按组合并，溢出的行再按串行的方式聚合进全局表
+  for (WorkerState& worker : workers) {
+    worker.input_.reset();
+    worker.pipeline_.reset();
+    MergeTable(&worker.table_);
+  }
+  BufferPoolManager* bpm = exec_ctx_->catalog_->GetBPM();
+  for (WorkerState& worker : workers) {
+    for (auto& file : worker.table_.spill_) {
+      spilled_ = true;
+      file->Rewind();
+      Tuple tuple;
+      while (file->Next(&tuple)) {
+        Accumulate(&table_, 0, exec_ctx_->memory_limit_,
+                   ExprInput(&tuple, input_schema_, bpm),
+                   [&]() { return tuple; });
+      }
+      file.reset();
+    }
+  }
+}
+
+void AggregationExecutor::MergeTable(GroupTable* local) {
+  std::size_t num_aggregates = aggregates_.size();
+  for (uint32_t g = 0; g < local->groups_.size(); g++) {
+    Group& group = local->groups_[g];
+    const char* key = local->key_arena_.data() + group.key_offset_;
+    uint32_t target = table_.Find(key, group.key_len_, group.hash_);
+    if (target == NO_GROUP) {
+      target = table_.Insert(key, group.key_len_, group.hash_,
+                             std::move(group.row_), num_aggregates);
+    }
+    for (std::size_t i = 0; i < num_aggregates; i++) {
+      Merge(&table_.states_[target * num_aggregates + i],
+            local->states_[g * num_aggregates + i], aggregates_[i]);
+    }
+  }
+  local->Clear();
+}
+
+template <typename MakeTuple>
+void AggregationExecutor::Accumulate(GroupTable* table, uint32_t depth,
+                                     std::size_t budget,
+                                     const ExprInput& input,
+                                     MakeTuple make_tuple) const {
+  std::string& key = table->key_buffer_;
+  key.clear();
+  for (const auto& expr : group_by_) {
+    Value val = expr->Evaluate(input);
+    TypeId type_id = expr->GetReturnType();
+    if (!val.IsNull() && val.GetTypeId() != type_id &&
+        type_id != TypeId::INVALID) {
+      val = val.CastAs(type_id);
+    }
+    KeyEncoder::EncodeValue(val, &key);
+  }
+  uint64_t hash = HashUtil::HashBytes(key.data(), key.size());
+
+  uint32_t group = table->Find(key.data(), key.size(), hash);
+  if (group == NO_GROUP) {
+    // 溢出以后不建新组，这一行留给分区
+    if (!table->spill_.empty()) {
+      table->spill_[PartitionOf(hash, depth)]->Append(make_tuple());
+      return;
+    }
+    group = table->Insert(key.data(), key.size(), hash,
+                          keep_row_ ? make_tuple() : Tuple(),
+                          aggregates_.size());
+  }
+
+  AggState* states = &table->states_[group * aggregates_.size()];
+  for (uint32_t i = 0; i < aggregates_.size(); i++) {
+    Update(&states[i], aggregates_[i], input);
+  }
+
+  if (table->spill_.empty() && !group_by_.empty() &&
+      depth < MAX_PARTITION_DEPTH && table->bytes_ > budget) {
+    DiskManager* disk_manager = exec_ctx_->catalog_->GetDiskManager();
+    for (uint32_t i = 0; i < NUM_PARTITIONS; i++) {
+      table->spill_.push_back(std::make_unique<SpillFile>(disk_manager));
+    }
+  }
+}
+
+void AggregationExecutor::Update(AggState* state, const Aggregate& agg,
+                                 const ExprInput& input) {
+  if (agg.type_ == AggregationType::COUNT_STAR) {
+    state->count_++;
+    return;
+  }
+  Value val = agg.arg_->Evaluate(input);
+  if (val.IsNull()) return;
+  state->count_++;
+  switch (agg.type_) {
+    case AggregationType::SUM:
+    case AggregationType::AVG:
+      if (val.GetTypeId() == TypeId::DOUBLE) {
+        state->double_sum_ += val.GetAsDouble();
+      } else if (val.GetTypeId() == TypeId::INTEGER) {
+        AddToSum(val.GetAsInteger(), agg.type_, &state->int_sum_,
+                 &state->double_sum_);
+      } else {
+        AddToSum(val.GetAsBigInt(), agg.type_, &state->int_sum_,
+                 &state->double_sum_);
+      }
+      break;
+    case AggregationType::MIN:
+      if (state->count_ == 1 || val.CompareLessThan(state->extreme_)) {
+        state->extreme_ = std::move(val);
+      }
+      break;
+    case AggregationType::MAX:
+      if (state->count_ == 1 || state->extreme_.CompareLessThan(val)) {
+        state->extreme_ = std::move(val);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void AggregationExecutor::Merge(AggState* into, const AggState& from,
+                                const Aggregate& agg) {
+  if (from.count_ == 0) return;
+  if (agg.type_ == AggregationType::MIN || agg.type_ == AggregationType::MAX) {
+    bool replace = into->count_ == 0 ||
+                   (agg.type_ == AggregationType::MIN
+                        ? from.extreme_.CompareLessThan(into->extreme_)
+                        : into->extreme_.CompareLessThan(from.extreme_));
+    if (replace) {
+      into->extreme_ = from.extreme_;
+    }
+  }
+  into->count_ += from.count_;
+  AddToSum(from.int_sum_, agg.type_, &into->int_sum_, &into->double_sum_);
+  into->double_sum_ += from.double_sum_;
+}
+
+Value AggregationExecutor::Finalize(const AggState& state,
+                                    const Aggregate& agg) const {
+  switch (agg.type_) {
+    case AggregationType::COUNT_STAR:
+    case AggregationType::COUNT:
+      return Value(TypeId::BIGINT, state.count_);
+    case AggregationType::SUM:
+      if (state.count_ == 0) return Value(TypeId::INVALID);
+      if (agg.arg_->GetReturnType() == TypeId::DOUBLE) {
+        return Value(state.double_sum_ + static_cast<double>(state.int_sum_));
+      }
+      return Value(TypeId::BIGINT, state.int_sum_);
+    case AggregationType::AVG:
+      if (state.count_ == 0) return Value(TypeId::INVALID);
+      return Value((state.double_sum_ + static_cast<double>(state.int_sum_)) /
+                   static_cast<double>(state.count_));
+    case AggregationType::MIN:
+    case AggregationType::MAX:
+      return state.extreme_;
+  }
+  return Value(TypeId::INVALID);
+}
+
+// ============ 开放寻址哈希表 ============
+
+uint32_t AggregationExecutor::GroupTable::Find(const char* key,
+                                               std::size_t len,
+                                               uint64_t hash) const {
+  if (slots_.empty()) return NO_GROUP;
+  for (uint64_t pos = hash & slot_mask_;; pos = (pos + 1) & slot_mask_) {
+    const Slot& slot = slots_[pos];
+    if (slot.group_ == NO_GROUP) return NO_GROUP;
+    if (slot.hash_ != hash) continue;
+    const Group& group = groups_[slot.group_];
+    if (group.key_len_ == len &&
+        std::memcmp(key_arena_.data() + group.key_offset_, key, len) == 0) {
+      return slot.group_;
+    }
+  }
+}
+
+uint32_t AggregationExecutor::GroupTable::Insert(const char* key,
+                                                 std::size_t len,
+                                                 uint64_t hash, Tuple row,
+                                                 std::size_t num_aggregates) {
+  // 装填因子不超过 1/2
+  if ((groups_.size() + 1) * 2 > slots_.size()) {
+    Grow();
+  }
+  auto group = static_cast<uint32_t>(groups_.size());
+  uint64_t pos = hash & slot_mask_;
+  while (slots_[pos].group_ != NO_GROUP) {
+    pos = (pos + 1) & slot_mask_;
+  }
+  slots_[pos] = Slot{hash, group};
+
+  bytes_ += len + row.GetStorageSize() + sizeof(Group) +
+            num_aggregates * sizeof(AggState) + 2 * sizeof(Slot);
+  groups_.push_back(Group{hash, static_cast<uint32_t>(key_arena_.size()),
+                          static_cast<uint32_t>(len), std::move(row)});
+  key_arena_.append(key, len);
+  states_.resize(states_.size() + num_aggregates);
+  return group;
+}
+
+void AggregationExecutor::GroupTable::Grow() {
+  std::size_t capacity = std::max<std::size_t>(16, slots_.size() * 2);
+  std::vector<Slot> old = std::move(slots_);
+  slots_.assign(capacity, Slot{0, NO_GROUP});
+  slot_mask_ = capacity - 1;
+  for (const Slot& slot : old) {
+    if (slot.group_ == NO_GROUP) continue;
+    uint64_t pos = slot.hash_ & slot_mask_;
+    while (slots_[pos].group_ != NO_GROUP) {
+      pos = (pos + 1) & slot_mask_;
+    }
+    slots_[pos] = slot;
+  }
+}
+
+void AggregationExecutor::GroupTable::Clear() {
+  slots_.clear();
+  slot_mask_ = 0;
+  groups_.clear();
+  states_.clear();
+  key_arena_.clear();
+  bytes_ = 0;
+}
+
+// ============ 溢出 ============
+
+uint32_t AggregationExecutor::PartitionOf(uint64_t hash, uint32_t depth) {
+  // 低位用来选槽，这里先混一次再取高位；每一层用不同的哈希位
+  uint64_t mixed = HashUtil::Mix64(hash + depth * 0x9E3779B97F4A7C15ULL);
+  return static_cast<uint32_t>(mixed >> 32) % NUM_PARTITIONS;
+}
+
+void AggregationExecutor::FinishLevel() {
+  for (auto& file : table_.spill_) {
+    spilled_ = true;
+    if (file->GetTupleCount() == 0) continue;
+    file->Rewind();
+    pending_.push_back(Partition{std::move(file), depth_ + 1});
+  }
+  table_.spill_.clear();
+}
+
+bool AggregationExecutor::NextPartition() {
+  table_.Clear();
+  output_pos_ = 0;
+  if (pending_.empty()) {
+    return false;
+  }
+  Partition part = std::move(pending_.back());
+  pending_.pop_back();
+
+  depth_ = part.depth_;
+  BufferPoolManager* bpm = exec_ctx_->catalog_->GetBPM();
+  Tuple tuple;
+  while (part.rows_->Next(&tuple)) {
+    Accumulate(&table_, depth_, exec_ctx_->memory_limit_,
+               ExprInput(&tuple, input_schema_, bpm), [&]() { return tuple; });
+  }
+  FinishLevel();
+  aggregated_partitions_++;
+  return true;
+}
+
+bool AggregationExecutor::Next(Tuple* tuple) {
+  // 有 HAVING 时先按扩展的一行求值，不满足的组跳过
+  const Schema* row_schema =
+      having_ != nullptr ? having_schema_.get() : output_schema_.get();
+  BufferPoolManager* bpm = exec_ctx_->catalog_->GetBPM();
+  std::vector<Value> values;
+  while (true) {
+    while (output_pos_ >= table_.groups_.size()) {
+      if (!NextPartition()) return false;
+    }
+    const Group& group = table_.groups_[output_pos_];
+    const AggState* states = &table_.states_[output_pos_ * aggregates_.size()];
+    output_pos_++;
+
+    values.clear();
+    for (uint32_t i = 0; i < row_schema->GetColumnCount(); i++) {
+      // 输出项之后的列是只给 HAVING 用的聚合
+      uint32_t agg_idx = i >= outputs_.size()
+                             ? having_aggregates_[i - outputs_.size()]
+                             : outputs_[i].index_;
+      Value val = i >= outputs_.size() || outputs_[i].is_aggregate_
+                      ? Finalize(states[agg_idx], aggregates_[agg_idx])
+                      : outputs_[i].expr_->Evaluate(
+                            ExprInput(&group.row_, input_schema_, bpm));
+      if (val.IsNull()) {
+        val = Value(row_schema->GetColumn(i).GetType());
+      }
+      values.push_back(std::move(val));
+    }
+    if (having_ != nullptr) {
+      Tuple row(values, having_schema_.get());
+      if (!having_->EvaluatePredicate(
+              ExprInput(&row, having_schema_.get(), bpm))) {
+        continue;
+      }
+      values.erase(values.begin() + outputs_.size(), values.end());
+    }
+    *tuple = Tuple(values, output_schema_.get());
+    return true;
+  }
+}
+
+}  // namespace bustub
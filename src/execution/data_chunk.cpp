@@ -0,0 +1,181 @@
+#include "execution/data_chunk.h"
+
+#include <cstring>
+
+#include "storage/table/dictionary.h"
+
+namespace bustub {
+
+void ColumnVector::Init(const Column& col, uint32_t capacity) {
+  type_ = col.GetType();
+  dictionary_ = col.GetDictionary();
+  if (col.IsInlined()) {
+    width_ = col.GetFixedLength();
+  } else {
+    width_ = sizeof(StringRef);
+  }
+  data_.assign(static_cast<std::size_t>(width_) * capacity, 0);
+  nulls_.assign((capacity + 7) / 8, 0);
+}
+
+void ColumnVector::Reset() {
+  std::memset(nulls_.data(), 0, nulls_.size());
+  heap_.clear();
+}
+
+void ColumnVector::SetNull(uint32_t row) {
+  nulls_[row >> 3] |= (1 << (row % 8));
+}
+
+void ColumnVector::SetRaw(uint32_t row, const char* storage) {
+  std::memcpy(data_.data() + static_cast<std::size_t>(row) * width_, storage,
+              width_);
+}
+
+void ColumnVector::SetString(uint32_t row, const char* data, uint32_t len) {
+  StringRef ref{static_cast<uint32_t>(heap_.size()), len};
+  heap_.append(data, len);
+  std::memcpy(data_.data() + static_cast<std::size_t>(row) * width_, &ref,
+              sizeof(ref));
+}
+
+void ColumnVector::CopyValue(const ColumnVector& src, uint32_t src_row,
+                             uint32_t row) {
+  if (src.IsNull(src_row)) {
+    SetNull(row);
+    return;
+  }
+  // 非字典的 VARCHAR 值槽指向 src 自己的 heap_，要把字节拷过来
+  if (type_ == TypeId::VARCHAR && dictionary_ == nullptr) {
+    std::string_view str = src.GetString(src_row);
+    SetString(row, str.data(), static_cast<uint32_t>(str.size()));
+    return;
+  }
+  SetRaw(row, src.data_.data() + static_cast<std::size_t>(src_row) * width_);
+}
+
+std::string_view ColumnVector::GetString(uint32_t row) const {
+  const char* slot = data_.data() + static_cast<std::size_t>(row) * width_;
+  if (dictionary_ != nullptr) {
+    uint32_t code;
+    std::memcpy(&code, slot, sizeof(code));
+    return dictionary_->Decode(code);
+  }
+  StringRef ref;
+  std::memcpy(&ref, slot, sizeof(ref));
+  return std::string_view(heap_.data() + ref.offset_, ref.len_);
+}
+
+Value ColumnVector::GetValue(uint32_t row) const {
+  if (IsNull(row)) {
+    return Value(type_);
+  }
+  if (type_ == TypeId::VARCHAR) {
+    std::string_view str = GetString(row);
+    return Value(str.data(), static_cast<uint32_t>(str.size()));
+  }
+  return Value::DeserializeFrom(
+      data_.data() + static_cast<std::size_t>(row) * width_, type_);
+}
+
+DataChunk::DataChunk(const Schema* schema)
+    : schema_(schema),
+      columns_(schema->GetColumnCount()),
+      rids_(BATCH_SIZE),
+      needed_(schema->GetColumnCount(), true),
+      selection_(BATCH_SIZE),
+      selection_buffer_(BATCH_SIZE) {
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    columns_[i].Init(schema->GetColumn(i), BATCH_SIZE);
+  }
+}
+
+void DataChunk::Reset() {
+  for (auto& col : columns_) {
+    col.Reset();
+  }
+  size_ = 0;
+  has_selection_ = false;
+  selected_count_ = 0;
+}
+
+void DataChunk::AppendTuple(const Tuple& tuple, BufferPoolManager* bpm) {
+  const char* data = tuple.GetData();
+  uint32_t col_count = schema_->GetColumnCount();
+  uint32_t bitmap_size = (col_count + 7) / 8;
+  uint32_t row = size_++;
+  rids_[row] = tuple.GetRid();
+  for (uint32_t i = 0; i < col_count; i++) {
+    if (!needed_[i]) continue;
+    ColumnVector& vec = columns_[i];
+    if (data[i >> 3] & (1 << (i % 8))) {
+      vec.SetNull(row);
+      continue;
+    }
+    const Column& col = schema_->GetColumn(i);
+    const char* val_ptr = data + bitmap_size + col.GetOffset();
+    // 定长列和字典列：定长区里的字节就是值槽
+    if (col.IsInlined()) {
+      vec.SetRaw(row, val_ptr);
+      continue;
+    }
+    uint32_t heap_offset;
+    std::memcpy(&heap_offset, val_ptr, sizeof(heap_offset));
+    if (heap_offset & Tuple::EXTERNAL_FLAG) {
+      Value val = tuple.GetValue(schema_, i, bpm);
+      vec.SetString(row, val.GetAsVarChar(), val.GetLogicLength());
+      continue;
+    }
+    uint32_t len;
+    std::memcpy(&len, data + heap_offset, sizeof(len));
+    vec.SetString(row, data + heap_offset + sizeof(len), len);
+  }
+}
+
+uint32_t DataChunk::AppendRowFrom(const DataChunk& src, uint32_t src_row) {
+  uint32_t row = AppendRow(src.rids_[src_row]);
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    if (!needed_[i]) continue;
+    if (src.needed_[i]) {
+      columns_[i].CopyValue(src.columns_[i], src_row, row);
+    } else {
+      columns_[i].SetNull(row);
+    }
+  }
+  return row;
+}
+
+void DataChunk::SetNeededColumns(const std::vector<uint32_t>& cols) {
+  needed_.assign(needed_.size(), false);
+  for (auto col_idx : cols) {
+    needed_[col_idx] = true;
+  }
+}
+
+void DataChunk::SetSelection(uint32_t count) {
+  selection_.swap(selection_buffer_);
+  selected_count_ = count;
+  has_selection_ = true;
+}
+
+Value DataChunk::GetValue(uint32_t col_idx, uint32_t row) const {
+  return columns_[col_idx].GetValue(row);
+}
+
+Tuple DataChunk::GetTuple(uint32_t row) const {
+  std::vector<Value> values;
+  values.reserve(columns_.size());
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    // 没有读出的列按 NULL 处理
+    if (needed_[i]) {
+      values.push_back(columns_[i].GetValue(row));
+    } else {
+      values.emplace_back(columns_[i].GetType());
+    }
+  }
+  Tuple tuple(values, const_cast<Schema*>(schema_));
+  tuple.SetRid(rids_[row]);
+  return tuple;
+}
+
+}  // namespace bustub
@@ -1,36 +1,39 @@
 #include "execution/delete_executor.h"
 
-#include "storage/table/table_heap.h"
+#include "common/exception.h"
 
 namespace bustub {
 
 void DeleteExecutor::Init(ExecutionContext* exec_ctx) {
   Executor::Init(exec_ctx);
+  auto table_info = exec_ctx_->catalog_->GetTable(table_id_);
+  if (!table_info) {
+    throw Exception(ExceptionType::CATALOG, "table to delete from not found");
+  }
+  // 整条语句共用一个 TableHeap，维护 TableInfo 的统计
+  table_heap_ = std::make_unique<TableHeap>(
+      exec_ctx_->catalog_->GetBPM(), table_id_, &table_info->GetSchema(),
+      table_info->GetDirectoryPageId(), table_info->GetStats());
+  input_ = std::make_unique<DataChunk>(&table_info->GetSchema());
+  input_->SetNeededColumns({});
+  affected_rows_ = 0;
+  deleted_ = false;
+  child_->Init(exec_ctx);
 }
 
 bool DeleteExecutor::Next(Tuple* tuple) {
   if (deleted_) {
     return false;
   }
-
-  auto table_info = exec_ctx_->catalog_->GetTable(table_id_);
-  if (!table_info) {
-    return false;
-  }
-
-  TableHeap table_heap(exec_ctx_->catalog_->GetBPM(), table_id_,
-                       table_info->GetFirstPageId());
-
-  // 遍历所有行并标记删除
-  auto iter = table_heap.Begin();
-  auto end_iter = table_heap.End();
-
-  while (iter != end_iter) {
-    Tuple current_tuple = *iter;
-    table_heap.MarkDeleted(current_tuple.GetRid());
-    ++iter;
+  // 扫描按页拷贝行，删掉已经读过的行不影响后面的扫描
+  while (child_->NextBatch(input_.get())) {
+    uint32_t count = input_->GetSelectedCount();
+    for (uint32_t k = 0; k < count; k++) {
+      if (table_heap_->MarkDeleted(input_->GetRid(input_->GetSelectedRow(k)))) {
+        affected_rows_++;
+      }
+    }
   }
-
   deleted_ = true;
   return true;
 }
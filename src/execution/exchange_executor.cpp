@@ -0,0 +1,206 @@
+#include "execution/exchange_executor.h"
+
+#include <utility>
+
+#include "common/config.h"
+#include "common/exception.h"
+#include "common/hash_util.h"
+#include "type/key_encoder.h"
+
+namespace bustub {
+
+Exchange::Exchange(ExchangeType type,
+                   std::vector<std::unique_ptr<Executor>> producers,
+                   const Schema* schema, uint32_t num_consumers,
+                   const std::vector<hsql::Expr*>* partition_by)
+  : type_(type), producers_(std::move(producers)), schema_(schema) {
+  if (producers_.empty() || num_consumers == 0) {
+    throw Exception(ExceptionType::EXECUTION,
+                    "exchange needs at least one producer and one consumer");
+  }
+  if (type_ == ExchangeType::GATHER && num_consumers != 1) {
+    throw Exception(ExceptionType::EXECUTION,
+                    "gather exchange has exactly one consumer");
+  }
+  if (type_ == ExchangeType::REPARTITION) {
+    if (partition_by == nullptr || partition_by->empty()) {
+      throw Exception(ExceptionType::EXECUTION,
+                      "repartition exchange needs a partition key");
+    }
+    for (const hsql::Expr* expr : *partition_by) {
+      partition_by_.push_back(ExprCompiler::Compile(expr, schema));
+    }
+  }
+  for (uint32_t i = 0; i < num_consumers; i++) {
+    channels_.push_back(
+        std::make_unique<BatchChannel>(EXCHANGE_QUEUE_BATCHES));
+  }
+  finished_.assign(num_consumers, 0);
+}
+
+void Exchange::SetNeededColumns(std::vector<uint32_t> cols) {
+  partial_columns_ = true;
+  needed_columns_ = std::move(cols);
+  producer_columns_ = needed_columns_;
+  for (const auto& expr : partition_by_) {
+    expr->CollectColumns(&producer_columns_);
+  }
+}
+
+Exchange::~Exchange() {
+  for (auto& channel : channels_) {
+    channel->Close();
+  }
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void Exchange::Start(ExecutionContext* exec_ctx) {
+  std::lock_guard<std::mutex> guard(latch_);
+  if (started_) {
+    return;
+  }
+  started_ = true;
+  exec_ctx_ = exec_ctx;
+  for (uint32_t i = 0; i < producers_.size(); i++) {
+    threads_.emplace_back([this, i] { Produce(i); });
+  }
+}
+
+void Exchange::Produce(uint32_t producer) {
+  try {
+    Executor* exec = producers_[producer].get();
+    exec->Init(exec_ctx_);
+    auto chunk = NewChunk(producer_columns_);
+    std::vector<std::unique_ptr<DataChunk>> outputs(channels_.size());
+    std::string key;
+    bool open = true;
+    while (open && exec->NextBatch(chunk.get())) {
+      if (chunk->GetSelectedCount() == 0) continue;
+      if (type_ == ExchangeType::GATHER) {
+        open = Send(0, std::move(chunk));
+        chunk = NewChunk(producer_columns_);
+        continue;
+      }
+      open = Route(*chunk, &outputs, &key);
+    }
+    for (uint32_t c = 0; c < outputs.size() && open; c++) {
+      if (outputs[c] != nullptr && outputs[c]->GetSize() > 0) {
+        open = Send(c, std::move(outputs[c]));
+      }
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> guard(latch_);
+    if (!error_) {
+      error_ = std::current_exception();
+    }
+  }
+  // 通道关闭后这些 Put 直接失败
+  for (uint32_t c = 0; c < channels_.size(); c++) {
+    Send(c, nullptr);
+  }
+}
+
+bool Exchange::Route(const DataChunk& chunk,
+                     std::vector<std::unique_ptr<DataChunk>>* outputs,
+                     std::string* key) {
+  auto num_consumers = static_cast<uint32_t>(outputs->size());
+  uint32_t count = chunk.GetSelectedCount();
+  for (uint32_t k = 0; k < count; k++) {
+    uint32_t row = chunk.GetSelectedRow(k);
+    uint32_t first = 0;
+    uint32_t last = num_consumers;
+    if (type_ == ExchangeType::REPARTITION) {
+      key->clear();
+      ExprInput input(&chunk, row);
+      for (const auto& expr : partition_by_) {
+        Value val = expr->Evaluate(input);
+        TypeId type_id = expr->GetReturnType();
+        if (!val.IsNull() && val.GetTypeId() != type_id &&
+            type_id != TypeId::INVALID) {
+          val = val.CastAs(type_id);
+        }
+        KeyEncoder::EncodeValue(val, key);
+      }
+      // 下游的哈希表用低位选槽，这里混一次再取高位，
+      // 免得一个消费者拿到的行哈希低位都相同
+      uint64_t hash =
+          HashUtil::Mix64(HashUtil::HashBytes(key->data(), key->size()));
+      first = static_cast<uint32_t>(hash >> 32) % num_consumers;
+      last = first + 1;
+    }
+    for (uint32_t c = first; c < last; c++) {
+      auto& out = (*outputs)[c];
+      if (out == nullptr) {
+        out = NewChunk(needed_columns_);
+      }
+      out->AppendRowFrom(chunk, row);
+      // 攒满就发出去
+      if (out->IsFull() && !Send(c, std::move(out))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool Exchange::Send(uint32_t consumer, std::unique_ptr<DataChunk> chunk) {
+  return channels_[consumer]->Put(std::move(chunk));
+}
+
+std::unique_ptr<DataChunk> Exchange::NewChunk(
+    const std::vector<uint32_t>& cols) const {
+  auto chunk = std::make_unique<DataChunk>(schema_);
+  if (partial_columns_) {
+    chunk->SetNeededColumns(cols);
+  }
+  return chunk;
+}
+
+std::unique_ptr<DataChunk> Exchange::Receive(uint32_t consumer) {
+  while (finished_[consumer] < producers_.size()) {
+    std::unique_ptr<DataChunk> chunk = channels_[consumer]->Get();
+    if (chunk != nullptr) {
+      return chunk;
+    }
+    finished_[consumer]++;
+    std::lock_guard<std::mutex> guard(latch_);
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+  return nullptr;
+}
+
+void ExchangeExecutor::Init(ExecutionContext* exec_ctx) {
+  Executor::Init(exec_ctx);
+  current_.reset();
+  current_pos_ = 0;
+  exchange_->Start(exec_ctx);
+}
+
+bool ExchangeExecutor::Next(Tuple* tuple) {
+  while (current_ == nullptr ||
+         current_pos_ >= current_->GetSelectedCount()) {
+    current_ = exchange_->Receive(consumer_);
+    current_pos_ = 0;
+    if (current_ == nullptr) {
+      return false;
+    }
+  }
+  *tuple = current_->GetTuple(current_->GetSelectedRow(current_pos_++));
+  return true;
+}
+
+bool ExchangeExecutor::NextBatch(DataChunk* chunk) {
+  std::unique_ptr<DataChunk> batch = exchange_->Receive(consumer_);
+  if (batch == nullptr) {
+    chunk->Reset();
+    return false;
+  }
+  std::swap(*chunk, *batch);
+  return true;
+}
+
+}  // namespace bustub
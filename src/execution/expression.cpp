@@ -0,0 +1,757 @@
+#include "execution/expression.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+#include "execution/data_chunk.h"
+#include "sql/Expr.h"
+#include "type/type_kernels.h"
+
+namespace bustub {
+
+Value ExprInput::GetValue(uint32_t col_idx) const {
+  if (chunk_ != nullptr) {
+    return chunk_->GetValue(col_idx, row_);
+  }
+  return tuple_->GetValue(schema_, col_idx, bpm_);
+}
+
+namespace {
+
+using ExprPtr = std::unique_ptr<CompiledExpr>;
+
+inline bool IsNumeric(TypeId type_id) {
+  return type_id == TypeId::INTEGER || type_id == TypeId::BIGINT ||
+         type_id == TypeId::DOUBLE;
+}
+
+inline Value MakeBoolean(bool val) { return Value(TypeId::BOOLEAN, val); }
+inline Value NullBoolean() { return Value(TypeId::BOOLEAN); }
+
+// ============ 节点 ============
+
+class ConstantExpr : public CompiledExpr {
+ public:
+  explicit ConstantExpr(Value val)
+    : CompiledExpr(val.GetTypeId()), val_(std::move(val)) {}
+  Value Evaluate(const ExprInput& input) const override { return val_; }
+  bool IsConstant() const override { return true; }
+  const Value& GetValue() const { return val_; }
+
+ private:
+  Value val_;
+};
+
+class ColumnRefExpr : public CompiledExpr {
+ public:
+  ColumnRefExpr(uint32_t col_idx, TypeId type_id)
+    : CompiledExpr(type_id), col_idx_(col_idx) {}
+  Value Evaluate(const ExprInput& input) const override {
+    return input.GetValue(col_idx_);
+  }
+  uint32_t GetColumnIndex() const { return col_idx_; }
+  bool AsColumnRef(uint32_t* col_idx) const override {
+    *col_idx = col_idx_;
+    return true;
+  }
+  void CollectColumns(std::vector<uint32_t>* cols) const override {
+    cols->push_back(col_idx_);
+  }
+
+ private:
+  uint32_t col_idx_;
+};
+
+// 数值提升 / DATE -> TIMESTAMP
+class CastExpr : public CompiledExpr {
+ public:
+  CastExpr(ExprPtr child, TypeId type_id)
+    : CompiledExpr(type_id), child_(std::move(child)) {}
+  Value Evaluate(const ExprInput& input) const override {
+    return child_->Evaluate(input).CastAs(return_type_);
+  }
+  void CollectColumns(std::vector<uint32_t>* cols) const override {
+    child_->CollectColumns(cols);
+  }
+
+ private:
+  ExprPtr child_;
+};
+
+class ComparisonExpr : public CompiledExpr {
+ public:
+  ComparisonExpr(CompareOp op, ExprPtr left, ExprPtr right,
+                 const ValueKernels* kernels)
+    : CompiledExpr(TypeId::BOOLEAN),
+      op_(op),
+      left_(std::move(left)),
+      right_(std::move(right)),
+      kernels_(kernels) {}
+
+  Value Evaluate(const ExprInput& input) const override {
+    Value left = left_->Evaluate(input);
+    if (left.IsNull()) return NullBoolean();
+    Value right = right_->Evaluate(input);
+    if (right.IsNull()) return NullBoolean();
+    switch (op_) {
+      case CompareOp::EQ:
+        return MakeBoolean(kernels_->equals_(left, right));
+      case CompareOp::NE:
+        return MakeBoolean(!kernels_->equals_(left, right));
+      case CompareOp::LT:
+        return MakeBoolean(kernels_->less_than_(left, right));
+      case CompareOp::LE:
+        return MakeBoolean(!kernels_->less_than_(right, left));
+      case CompareOp::GT:
+        return MakeBoolean(kernels_->less_than_(right, left));
+      case CompareOp::GE:
+        return MakeBoolean(!kernels_->less_than_(left, right));
+    }
+    return NullBoolean();
+  }
+
+  bool AsSimpleComparison(SimpleComparison* out) const override {
+    auto column = dynamic_cast<const ColumnRefExpr*>(left_.get());
+    auto constant = dynamic_cast<const ConstantExpr*>(right_.get());
+    if (column == nullptr || constant == nullptr) return false;
+    out->col_idx_ = column->GetColumnIndex();
+    out->op_ = op_;
+    out->constant_ = constant->GetValue();
+    return true;
+  }
+  void CollectColumns(std::vector<uint32_t>* cols) const override {
+    left_->CollectColumns(cols);
+    right_->CollectColumns(cols);
+  }
+
+ private:
+  CompareOp op_;
+  ExprPtr left_;
+  ExprPtr right_;
+  const ValueKernels* kernels_;
+};
+
+class ArithmeticExpr : public CompiledExpr {
+ public:
+  // 两边已经转成 type_id (BIGINT 或 DOUBLE)
+  ArithmeticExpr(hsql::OperatorType op, ExprPtr left, ExprPtr right,
+                 TypeId type_id)
+    : CompiledExpr(type_id),
+      op_(op),
+      left_(std::move(left)),
+      right_(std::move(right)) {}
+
+  Value Evaluate(const ExprInput& input) const override {
+    Value left = left_->Evaluate(input);
+    if (left.IsNull()) return Value(return_type_);
+    Value right = right_->Evaluate(input);
+    if (right.IsNull()) return Value(return_type_);
+    if (return_type_ == TypeId::DOUBLE) {
+      return EvaluateDouble(left.GetAsDouble(), right.GetAsDouble());
+    }
+    return EvaluateBigInt(left.GetAsBigInt(), right.GetAsBigInt());
+  }
+  void CollectColumns(std::vector<uint32_t>* cols) const override {
+    left_->CollectColumns(cols);
+    right_->CollectColumns(cols);
+  }
+
+ private:
+  Value EvaluateBigInt(int64_t left, int64_t right) const {
+    int64_t result = 0;
+    bool overflow = false;
+    switch (op_) {
+      case hsql::kOpPlus:
+        overflow = __builtin_add_overflow(left, right, &result);
+        break;
+      case hsql::kOpMinus:
+        overflow = __builtin_sub_overflow(left, right, &result);
+        break;
+      case hsql::kOpAsterisk:
+        overflow = __builtin_mul_overflow(left, right, &result);
+        break;
+      case hsql::kOpSlash:
+        if (right == 0) throw DivideByZero();
+        overflow = left == std::numeric_limits<int64_t>::min() && right == -1;
+        if (!overflow) result = left / right;
+        break;
+      case hsql::kOpPercentage:
+        if (right == 0) throw DivideByZero();
+        result = right == -1 ? 0 : left % right;
+        break;
+      default:
+        break;
+    }
+    if (overflow) {
+      throw Exception(ExceptionType::OUT_OF_RANGE, "BIGINT out of range");
+    }
+    return Value(TypeId::BIGINT, result);
+  }
+
+  Value EvaluateDouble(double left, double right) const {
+    switch (op_) {
+      case hsql::kOpPlus:
+        return Value(left + right);
+      case hsql::kOpMinus:
+        return Value(left - right);
+      case hsql::kOpAsterisk:
+        return Value(left * right);
+      case hsql::kOpSlash:
+        if (right == 0) throw DivideByZero();
+        return Value(left / right);
+      case hsql::kOpPercentage:
+        if (right == 0) throw DivideByZero();
+        return Value(std::fmod(left, right));
+      default:
+        return Value(TypeId::DOUBLE);
+    }
+  }
+
+  static Exception DivideByZero() {
+    return Exception(ExceptionType::DIVIDE_BY_ZERO, "division by zero");
+  }
+
+  hsql::OperatorType op_;
+  ExprPtr left_;
+  ExprPtr right_;
+};
+
+class NegateExpr : public CompiledExpr {
+ public:
+  NegateExpr(ExprPtr child, TypeId type_id)
+    : CompiledExpr(type_id), child_(std::move(child)) {}
+  Value Evaluate(const ExprInput& input) const override {
+    Value val = child_->Evaluate(input);
+    if (val.IsNull()) return Value(return_type_);
+    if (return_type_ == TypeId::DOUBLE) return Value(-val.GetAsDouble());
+    int64_t raw = val.GetAsBigInt();
+    if (raw == std::numeric_limits<int64_t>::min()) {
+      throw Exception(ExceptionType::OUT_OF_RANGE, "BIGINT out of range");
+    }
+    return Value(TypeId::BIGINT, -raw);
+  }
+  void CollectColumns(std::vector<uint32_t>* cols) const override {
+    child_->CollectColumns(cols);
+  }
+
+ private:
+  ExprPtr child_;
+};
+
+// AND / OR，三值逻辑，能短路就短路
+class LogicExpr : public CompiledExpr {
+ public:
+  LogicExpr(bool is_and, ExprPtr left, ExprPtr right)
+    : CompiledExpr(TypeId::BOOLEAN),
+      is_and_(is_and),
+      left_(std::move(left)),
+      right_(std::move(right)) {}
+
+  Value Evaluate(const ExprInput& input) const override {
+    // AND 遇到 FALSE、OR 遇到 TRUE 即可确定结果
+    bool decisive = !is_and_;
+    Value left = left_->Evaluate(input);
+    if (!left.IsNull() && left.GetAsBoolean() == decisive) return left;
+    Value right = right_->Evaluate(input);
+    if (!right.IsNull() && right.GetAsBoolean() == decisive) return right;
+    if (left.IsNull() || right.IsNull()) return NullBoolean();
+    return MakeBoolean(!decisive);
+  }
+  void CollectColumns(std::vector<uint32_t>* cols) const override {
+    left_->CollectColumns(cols);
+    right_->CollectColumns(cols);
+  }
+
+ private:
+  bool is_and_;
+  ExprPtr left_;
+  ExprPtr right_;
+};
+
+class NotExpr : public CompiledExpr {
+ public:
+  explicit NotExpr(ExprPtr child)
+    : CompiledExpr(TypeId::BOOLEAN), child_(std::move(child)) {}
+  Value Evaluate(const ExprInput& input) const override {
+    Value val = child_->Evaluate(input);
+    if (val.IsNull()) return NullBoolean();
+    return MakeBoolean(!val.GetAsBoolean());
+  }
+  void CollectColumns(std::vector<uint32_t>* cols) const override {
+    child_->CollectColumns(cols);
+  }
+
+ private:
+  ExprPtr child_;
+};
+
+class IsNullExpr : public CompiledExpr {
+ public:
+  explicit IsNullExpr(ExprPtr child)
+    : CompiledExpr(TypeId::BOOLEAN), child_(std::move(child)) {}
+  Value Evaluate(const ExprInput& input) const override {
+    return MakeBoolean(child_->Evaluate(input).IsNull());
+  }
+  void CollectColumns(std::vector<uint32_t>* cols) const override {
+    child_->CollectColumns(cols);
+  }
+
+ private:
+  ExprPtr child_;
+};
+
+// x IN (常量...)：常量在编译期转成 x 的类型放进哈希集合
+class InListExpr : public CompiledExpr {
+ public:
+  struct ValueHash {
+    std::size_t operator()(const Value& val) const { return val.Hash(); }
+  };
+  struct ValueEqual {
+    bool operator()(const Value& left, const Value& right) const {
+      return left.CompareEquals(right);
+    }
+  };
+
+  InListExpr(ExprPtr child, std::unordered_set<Value, ValueHash, ValueEqual> set,
+             bool has_null)
+    : CompiledExpr(TypeId::BOOLEAN),
+      child_(std::move(child)),
+      set_(std::move(set)),
+      has_null_(has_null) {}
+
+  Value Evaluate(const ExprInput& input) const override {
+    Value val = child_->Evaluate(input);
+    if (val.IsNull()) return NullBoolean();
+    if (set_.count(val) > 0) return MakeBoolean(true);
+    // 列表里有 NULL 时找不到的结果是 UNKNOWN
+    return has_null_ ? NullBoolean() : MakeBoolean(false);
+  }
+  void CollectColumns(std::vector<uint32_t>* cols) const override {
+    child_->CollectColumns(cols);
+  }
+
+ private:
+  ExprPtr child_;
+  std::unordered_set<Value, ValueHash, ValueEqual> set_;
+  bool has_null_;
+};
+
+// ============ 编译 ============
+
+class Compiler {
+ public:
+  explicit Compiler(const Schema* schema,
+                    const ExprCompiler::Binder* bind = nullptr)
+    : schema_(schema), bind_(bind) {}
+
+  ExprPtr Compile(const hsql::Expr* expr) {
+    if (expr == nullptr) {
+      throw Exception(ExceptionType::EXECUTION, "incomplete expression");
+    }
+    if (bind_ != nullptr) {
+      int col_idx = (*bind_)(expr);
+      if (col_idx >= 0) return MakeColumnRef(col_idx);
+    }
+    switch (expr->type) {
+      case hsql::kExprLiteralInt:
+        if (expr->isBoolLiteral) {
+          return Constant(MakeBoolean(expr->ival != 0));
+        }
+        return Constant(Value(TypeId::BIGINT, expr->ival));
+      case hsql::kExprLiteralFloat:
+        return Constant(Value(expr->fval));
+      case hsql::kExprLiteralString:
+        return Constant(Value(std::string(expr->name)));
+      case hsql::kExprLiteralDate:
+        return Constant(Value(std::string(expr->name)).CastAs(TypeId::DATE));
+      case hsql::kExprLiteralNull:
+        return Constant(Value(TypeId::INVALID));
+      case hsql::kExprColumnRef:
+        return ColumnRef(expr);
+      case hsql::kExprOperator:
+        return Operator(expr);
+      default:
+        throw Exception(ExceptionType::NOT_IMPLEMENTED,
+                        "unsupported expression");
+    }
+  }
+
+ private:
+  static ExprPtr Constant(Value val) {
+    return std::make_unique<ConstantExpr>(std::move(val));
+  }
+
+  // 子节点全是常量时在编译期求值
+  static ExprPtr FoldIf(bool is_const, ExprPtr node) {
+    if (!is_const) return node;
+    return Constant(node->Evaluate(ExprInput(nullptr, nullptr, nullptr)));
+  }
+
+  static const Value& ConstantOf(const ExprPtr& node) {
+    return static_cast<const ConstantExpr*>(node.get())->GetValue();
+  }
+
+  // 列名解析：join 的输出列名是 "表.列"
+  // 1. 写了表名 (t.a) 先找 "t.a"，找不到再按列名找 (单表 schema 的列名不带表名)
+  // 2. 按列名精确匹配
+  // 3. 唯一一个 "*.a" 的列；有多个时报 ambiguous
+  ExprPtr ColumnRef(const hsql::Expr* expr) {
+    if (expr->name == nullptr) {
+      throw Exception(ExceptionType::EXECUTION, "unknown column ''");
+    }
+    std::string name = expr->name;
+    if (expr->table != nullptr) {
+      int idx = FindColumn(std::string(expr->table) + "." + name);
+      if (idx >= 0) return MakeColumnRef(idx);
+    }
+    int idx = FindColumn(name);
+    if (idx >= 0) return MakeColumnRef(idx);
+
+    std::string suffix = "." + name;
+    for (uint32_t i = 0; i < schema_->GetColumnCount(); i++) {
+      const std::string& col_name = schema_->GetColumn(i).GetName();
+      if (col_name.size() > suffix.size() &&
+          col_name.compare(col_name.size() - suffix.size(), suffix.size(),
+                           suffix) == 0) {
+        if (idx >= 0) {
+          throw Exception(ExceptionType::EXECUTION,
+                          "column '" + name + "' is ambiguous");
+        }
+        idx = static_cast<int>(i);
+      }
+    }
+    if (idx >= 0) return MakeColumnRef(idx);
+    throw Exception(ExceptionType::EXECUTION,
+                    "unknown column '" +
+                        (expr->table == nullptr
+                             ? name
+                             : std::string(expr->table) + "." + name) +
+                        "'");
+  }
+
+  int FindColumn(const std::string& name) const {
+    for (uint32_t i = 0; i < schema_->GetColumnCount(); i++) {
+      if (schema_->GetColumn(i).GetName() == name) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+  ExprPtr MakeColumnRef(int col_idx) const {
+    return std::make_unique<ColumnRefExpr>(
+        col_idx, schema_->GetColumn(col_idx).GetType());
+  }
+
+  ExprPtr Operator(const hsql::Expr* expr) {
+    switch (expr->opType) {
+      case hsql::kOpEquals:
+        return Comparison(CompareOp::EQ, Compile(expr->expr), Compile(expr->expr2));
+      case hsql::kOpNotEquals:
+        return Comparison(CompareOp::NE, Compile(expr->expr), Compile(expr->expr2));
+      case hsql::kOpLess:
+        return Comparison(CompareOp::LT, Compile(expr->expr), Compile(expr->expr2));
+      case hsql::kOpLessEq:
+        return Comparison(CompareOp::LE, Compile(expr->expr), Compile(expr->expr2));
+      case hsql::kOpGreater:
+        return Comparison(CompareOp::GT, Compile(expr->expr), Compile(expr->expr2));
+      case hsql::kOpGreaterEq:
+        return Comparison(CompareOp::GE, Compile(expr->expr), Compile(expr->expr2));
+      case hsql::kOpAnd:
+      case hsql::kOpOr:
+        return Logic(expr->opType == hsql::kOpAnd, Compile(expr->expr),
+                     Compile(expr->expr2));
+      case hsql::kOpNot: {
+        ExprPtr child = Compile(expr->expr);
+        CheckBoolean(child, "NOT");
+        bool is_const = child->IsConstant();
+        return FoldIf(is_const, std::make_unique<NotExpr>(std::move(child)));
+      }
+      case hsql::kOpIsNull: {
+        ExprPtr child = Compile(expr->expr);
+        bool is_const = child->IsConstant();
+        return FoldIf(is_const, std::make_unique<IsNullExpr>(std::move(child)));
+      }
+      case hsql::kOpPlus:
+      case hsql::kOpMinus:
+      case hsql::kOpAsterisk:
+      case hsql::kOpSlash:
+      case hsql::kOpPercentage:
+        return Arithmetic(expr->opType, Compile(expr->expr),
+                          Compile(expr->expr2));
+      case hsql::kOpUnaryMinus:
+        return Negate(Compile(expr->expr));
+      case hsql::kOpBetween: {
+        // x BETWEEN a AND b  =>  x >= a AND x <= b
+        if (expr->exprList == nullptr || expr->exprList->size() != 2) {
+          throw Exception(ExceptionType::EXECUTION, "malformed BETWEEN");
+        }
+        ExprPtr low = Comparison(CompareOp::GE, Compile(expr->expr),
+                                 Compile(expr->exprList->at(0)));
+        ExprPtr high = Comparison(CompareOp::LE, Compile(expr->expr),
+                                  Compile(expr->exprList->at(1)));
+        return Logic(true, std::move(low), std::move(high));
+      }
+      case hsql::kOpIn:
+        return InList(expr);
+      default:
+        throw Exception(ExceptionType::NOT_IMPLEMENTED,
+                        "unsupported operator");
+    }
+  }
+
+  // 常量 val 转成 type_id，数值之间要求无损 (2.5 不能转成 INTEGER 的 2)
+  static bool CastConstant(const Value& val, TypeId type_id, Value* out) {
+    try {
+      Value cast = val.CastAs(type_id);
+      if (IsNumeric(val.GetTypeId()) && IsNumeric(type_id) &&
+          !cast.CastAs(val.GetTypeId()).CompareEquals(val)) {
+        return false;
+      }
+      *out = std::move(cast);
+      return true;
+    } catch (const Exception&) {
+      return false;
+    }
+  }
+
+  static TypeId CommonType(TypeId left, TypeId right) {
+    return ExprCompiler::CommonType(left, right);
+  }
+
+  // 把 node 转成 type_id：常量直接转，其他节点只允许提升
+  static bool Coerce(ExprPtr* node, TypeId type_id) {
+    TypeId from = (*node)->GetReturnType();
+    if (from == type_id) return true;
+    if ((*node)->IsConstant()) {
+      Value cast(TypeId::INVALID);
+      if (!CastConstant(ConstantOf(*node), type_id, &cast)) return false;
+      *node = Constant(std::move(cast));
+      return true;
+    }
+    if (CommonType(from, type_id) != type_id) return false;
+    *node = std::make_unique<CastExpr>(std::move(*node), type_id);
+    return true;
+  }
+
+  static CompareOp Mirror(CompareOp op) {
+    switch (op) {
+      case CompareOp::LT:
+        return CompareOp::GT;
+      case CompareOp::LE:
+        return CompareOp::GE;
+      case CompareOp::GT:
+        return CompareOp::LT;
+      case CompareOp::GE:
+        return CompareOp::LE;
+      default:
+        return op;
+    }
+  }
+
+  static ExprPtr Comparison(CompareOp op, ExprPtr left, ExprPtr right) {
+    // 常量放右边
+    if (left->IsConstant() && !right->IsConstant()) {
+      std::swap(left, right);
+      op = Mirror(op);
+    }
+    TypeId left_type = left->GetReturnType();
+    TypeId right_type = right->GetReturnType();
+    // 和 NULL 比较永远是 UNKNOWN
+    if (left_type == TypeId::INVALID || right_type == TypeId::INVALID) {
+      return Constant(NullBoolean());
+    }
+    if (left_type != right_type) {
+      Value cast(TypeId::INVALID);
+      if (right->IsConstant() && CastConstant(ConstantOf(right), left_type, &cast)) {
+        right = Constant(std::move(cast));
+      } else {
+        TypeId common = CommonType(left_type, right_type);
+        if (common == TypeId::INVALID || !Coerce(&left, common) ||
+            !Coerce(&right, common)) {
+          if (right->IsConstant()) {
+            // 常量转不成列的类型，没有行能匹配
+            return Constant(MakeBoolean(false));
+          }
+          throw Exception(ExceptionType::MISMATCH_TYPE,
+                          "cannot compare " + Type::TypeIdToString(left_type) +
+                              " with " + Type::TypeIdToString(right_type));
+        }
+      }
+    }
+    const ValueKernels* kernels = ValueKernels::Get(left->GetReturnType());
+    if (kernels == nullptr) {
+      throw Exception(ExceptionType::MISMATCH_TYPE,
+                      "cannot compare values of type " +
+                          Type::TypeIdToString(left->GetReturnType()));
+    }
+    bool is_const = left->IsConstant() && right->IsConstant();
+    return FoldIf(is_const,
+                  std::make_unique<ComparisonExpr>(op, std::move(left),
+                                                   std::move(right), kernels));
+  }
+
+  static void CheckBoolean(const ExprPtr& node, const char* op_name) {
+    TypeId type_id = node->GetReturnType();
+    if (type_id != TypeId::BOOLEAN && type_id != TypeId::INVALID) {
+      throw Exception(ExceptionType::MISMATCH_TYPE,
+                      std::string("argument of ") + op_name +
+                          " must be BOOLEAN, not " +
+                          Type::TypeIdToString(type_id));
+    }
+  }
+
+  static ExprPtr Logic(bool is_and, ExprPtr left, ExprPtr right) {
+    CheckBoolean(left, is_and ? "AND" : "OR");
+    CheckBoolean(right, is_and ? "AND" : "OR");
+    bool is_const = left->IsConstant() && right->IsConstant();
+    return FoldIf(is_const, std::make_unique<LogicExpr>(is_and, std::move(left),
+                                                        std::move(right)));
+  }
+
+  static void CheckNumeric(const ExprPtr& node) {
+    TypeId type_id = node->GetReturnType();
+    if (!IsNumeric(type_id) && type_id != TypeId::INVALID) {
+      throw Exception(ExceptionType::MISMATCH_TYPE,
+                      "arithmetic on non-numeric type " +
+                          Type::TypeIdToString(type_id));
+    }
+  }
+
+  static ExprPtr Arithmetic(hsql::OperatorType op, ExprPtr left,
+                            ExprPtr right) {
+    CheckNumeric(left);
+    CheckNumeric(right);
+    TypeId type_id = left->GetReturnType() == TypeId::DOUBLE ||
+                             right->GetReturnType() == TypeId::DOUBLE
+                         ? TypeId::DOUBLE
+                         : TypeId::BIGINT;
+    // NULL 常量没有类型，运算结果直接是 NULL
+    if (left->GetReturnType() == TypeId::INVALID ||
+        right->GetReturnType() == TypeId::INVALID) {
+      return Constant(Value(type_id));
+    }
+    Coerce(&left, type_id);
+    Coerce(&right, type_id);
+    bool is_const = left->IsConstant() && right->IsConstant();
+    return FoldIf(is_const,
+                  std::make_unique<ArithmeticExpr>(op, std::move(left),
+                                                   std::move(right), type_id));
+  }
+
+  static ExprPtr Negate(ExprPtr child) {
+    CheckNumeric(child);
+    if (child->GetReturnType() == TypeId::INVALID) return child;
+    TypeId type_id = child->GetReturnType() == TypeId::DOUBLE ? TypeId::DOUBLE
+                                                              : TypeId::BIGINT;
+    Coerce(&child, type_id);
+    bool is_const = child->IsConstant();
+    return FoldIf(is_const,
+                  std::make_unique<NegateExpr>(std::move(child), type_id));
+  }
+
+  ExprPtr InList(const hsql::Expr* expr) {
+    if (expr->exprList == nullptr) {
+      throw Exception(ExceptionType::NOT_IMPLEMENTED,
+                      "IN (SELECT ...) is not supported");
+    }
+    ExprPtr child = Compile(expr->expr);
+    std::vector<ExprPtr> items;
+    bool all_const = true;
+    for (auto item : *expr->exprList) {
+      items.push_back(Compile(item));
+      all_const = all_const && items.back()->IsConstant();
+    }
+    if (!all_const) {
+      // 列表里有非常量：展开成 x = a OR x = b ...
+      ExprPtr node;
+      for (auto& item : items) {
+        ExprPtr eq = Comparison(CompareOp::EQ, Compile(expr->expr), std::move(item));
+        node = node == nullptr ? std::move(eq)
+                               : Logic(false, std::move(node), std::move(eq));
+      }
+      return node;
+    }
+    if (child->GetReturnType() == TypeId::INVALID) {
+      return Constant(NullBoolean());
+    }
+    std::unordered_set<Value, InListExpr::ValueHash, InListExpr::ValueEqual> set;
+    bool has_null = false;
+    for (auto& item : items) {
+      const Value& val = ConstantOf(item);
+      if (val.IsNull()) {
+        has_null = true;
+        continue;
+      }
+      // 转不成 x 的类型的常量不可能等于 x，直接丢掉
+      Value cast(TypeId::INVALID);
+      if (CastConstant(val, child->GetReturnType(), &cast)) {
+        set.insert(std::move(cast));
+      }
+    }
+    bool is_const = child->IsConstant();
+    return FoldIf(is_const, std::make_unique<InListExpr>(
+                                std::move(child), std::move(set), has_null));
+  }
+
+  const Schema* schema_;
+  const ExprCompiler::Binder* bind_;
+};
+
+}  // namespace
+
+std::unique_ptr<CompiledExpr> ExprCompiler::Compile(const hsql::Expr* expr,
+                                                    const Schema* schema) {
+  return Compiler(schema).Compile(expr);
+}
+
+std::unique_ptr<CompiledExpr> ExprCompiler::Compile(const hsql::Expr* expr,
+                                                    const Schema* schema,
+                                                    const Binder& bind) {
+  return Compiler(schema, &bind).Compile(expr);
+}
+
+TypeId ExprCompiler::CommonType(TypeId left, TypeId right) {
+  if (left == right) return left;
+  if (IsNumeric(left) && IsNumeric(right)) {
+    return left == TypeId::DOUBLE || right == TypeId::DOUBLE ? TypeId::DOUBLE
+                                                             : TypeId::BIGINT;
+  }
+  if ((left == TypeId::DATE && right == TypeId::TIMESTAMP) ||
+      (left == TypeId::TIMESTAMP && right == TypeId::DATE)) {
+    return TypeId::TIMESTAMP;
+  }
+  return TypeId::INVALID;
+}
+
+std::unique_ptr<CompiledExpr> ExprCompiler::CompileColumn(
+    uint32_t col_idx, const Schema* schema) {
+  return std::make_unique<ColumnRefExpr>(
+      col_idx, schema->GetColumn(col_idx).GetType());
+}
+
+Column ExprCompiler::OutputColumn(std::string name, const CompiledExpr& expr,
+                                  const Schema* input_schema) {
+  TypeId type_id = expr.GetReturnType();
+  uint32_t col_idx;
+  if (expr.AsColumnRef(&col_idx)) {
+    const Column& col = input_schema->GetColumn(col_idx);
+    if (type_id == TypeId::VARCHAR) {
+      return Column(std::move(name), type_id, col.GetStorageSize());
+    }
+    return Column(std::move(name), type_id);
+  }
+  // NULL 字面量没有类型，按 VARCHAR 输出
+  if (type_id == TypeId::VARCHAR || type_id == TypeId::INVALID) {
+    return Column(std::move(name), TypeId::VARCHAR, DEFAULT_VARCHAR_LENGTH);
+  }
+  return Column(std::move(name), type_id);
+}
+
+}  // namespace bustub
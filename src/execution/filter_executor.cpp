@@ -1,16 +1,108 @@
 #include "execution/filter_executor.h"
 
+#include <cstring>
+#include <string_view>
+#include <utility>
+
 #include "catalog/schema.h"
+#include "common/exception.h"
+#include "execution/pipeline.h"
+#include "execution/table_scan_executor.h"
 #include "sql/Expr.h"
+#include "storage/table/dictionary.h"
+#include "storage/table/scan_predicate.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
+namespace {
+// 一批行的过滤循环：没有分支地把行号写进 sel_out，满足条件才前移
+// sel_in 为空表示 0..count 全部行
+template <typename Get, typename Pred>
+uint32_t SelectLoop(const uint8_t* nulls, const uint32_t* sel_in,
+                    uint32_t count, Get get, Pred pred, uint32_t* sel_out) {
+  uint32_t selected = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t row = sel_in == nullptr ? i : sel_in[i];
+    bool is_null = (nulls[row >> 3] & (1 << (row % 8))) != 0;
+    sel_out[selected] = row;
+    selected += static_cast<uint32_t>(!is_null && pred(get(row)));
+  }
+  return selected;
+}
+
+// 从列向量里读第 row 个定长值
+template <typename T>
+struct FixedReader {
+  const char* data_;
+  T operator()(uint32_t row) const {
+    T val;
+    std::memcpy(&val, data_ + static_cast<std::size_t>(row) * sizeof(T),
+                sizeof(T));
+    return val;
+  }
+};
+}  // namespace
+
 void FilterExecutor::Init(ExecutionContext* exec_ctx) {
   Executor::Init(exec_ctx);
+  // 下推的谓词要在子扫描 Init (创建迭代器) 之前交给它
+  BindFilter();
+  PushDownFilter();
   child_->Init(exec_ctx);
 }
 
+bool FilterExecutor::NextBatch(DataChunk* chunk) {
+  // 下游可能只要了部分列，过滤要读的列也得让扫描填上
+  if (!accept_all_ && !reject_all_) {
+    for (auto col_idx : filter_columns_) {
+      chunk->MarkNeeded(col_idx);
+    }
+  }
+  while (child_->NextBatch(chunk)) {
+    if (reject_all_) return false;
+    if (FilterBatch(chunk)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool FilterExecutor::FilterBatch(DataChunk* chunk) const {
+  if (accept_all_) return true;
+  if (reject_all_) return false;
+  uint32_t selected = SelectBatch(*chunk, chunk->GetSelectionBuffer());
+  chunk->SetSelection(selected);
+  return selected > 0;
+}
+
+void FilterExecutor::BuildPipeline(PipelineBuilder* builder,
+                                   const Schema* schema) {
+  builder->AddOperator(this);
+  child_->BuildPipeline(builder, schema_);
+}
+
+void FilterExecutor::OpenOperator(ExecutionContext* exec_ctx) {
+  Executor::OpenOperator(exec_ctx);
+  BindFilter();
+  PushDownFilter();
+}
+
+bool FilterExecutor::PushBatch(DataChunk* chunk, Pipeline* pipeline,
+                               std::size_t next) {
+  if (reject_all_) return false;
+  return !FilterBatch(chunk) || pipeline->Push(chunk, next);
+}
+
+bool FilterExecutor::PushInputColumns(bool partial,
+                                      std::vector<uint32_t>* cols) const {
+  if (!partial) return false;
+  if (!accept_all_ && !reject_all_) {
+    cols->insert(cols->end(), filter_columns_.begin(), filter_columns_.end());
+  }
+  return true;
+}
+
 bool FilterExecutor::Next(Tuple* tuple) {
   while (child_->Next(tuple)) {
     if (EvaluateFilter(*tuple)) {
@@ -20,97 +112,221 @@ bool FilterExecutor::Next(Tuple* tuple) {
   return false;
 }
 
-bool FilterExecutor::EvaluateFilter(const Tuple& tuple) {
+void FilterExecutor::BindFilter() {
+  accept_all_ = true;
+  reject_all_ = false;
+  predicate_.reset();
+  filter_columns_.clear();
+  simple_ = false;
+  kernels_ = nullptr;
+  compare_code_ = false;
+
   if (filter_expr_ == nullptr) {
-    return true;  // 无过滤条件，接受所有行
+    return;  // 无过滤条件，接受所有行
   }
 
-  // 简化版：仅支持基本的二元操作符 (=, <, >, <=, >=, !=)
-  if (filter_expr_->type != hsql::kExprOperator) {
-    return true;  // 非操作符表达式，暂不支持
+  predicate_ = ExprCompiler::Compile(filter_expr_, schema_);
+  predicate_->CollectColumns(&filter_columns_);
+  TypeId type_id = predicate_->GetReturnType();
+  if (type_id != TypeId::BOOLEAN && type_id != TypeId::INVALID) {
+    throw Exception(ExceptionType::MISMATCH_TYPE,
+                    "WHERE must be BOOLEAN, not " +
+                        Type::TypeIdToString(type_id));
   }
+  accept_all_ = false;
 
-  // 期望形式：列 op 值（或值 op 列）
-  hsql::Expr* left = filter_expr_->expr;
-  hsql::Expr* right = filter_expr_->expr2;
+  // 常量条件 (如 1 = 1、id = 'abc') 在编译期已经求出来了
+  if (predicate_->IsConstant()) {
+    accept_all_ =
+        predicate_->EvaluatePredicate(ExprInput(nullptr, nullptr, nullptr));
+    reject_all_ = !accept_all_;
+    return;
+  }
 
-  if (left == nullptr || right == nullptr) {
-    return true;  // 不完整的表达式
+  SimpleComparison cmp;
+  if (!predicate_->AsSimpleComparison(&cmp)) {
+    return;
+  }
+  kernels_ = ValueKernels::Get(cmp.constant_.GetTypeId());
+  if (kernels_ == nullptr) {
+    return;
   }
+  simple_ = true;
+  col_idx_ = cmp.col_idx_;
+  op_ = cmp.op_;
+  compare_val_ = std::move(cmp.constant_);
 
-  // 提取列索引和值
-  int col_idx = -1;
-  Value compare_val(0);  // 默认整数值
-  bool is_left_column = false;
+  const Column& col = schema_->GetColumn(col_idx_);
+  if (!col.IsDictEncoded() || (op_ != CompareOp::EQ && op_ != CompareOp::NE)) {
+    return;
+  }
+  // 常量只查字典不加入；字典里没有这个串时 = 不可能成立，
+  // != 仍走解码比较 (本条语句里可能有行被更新成这个串)
+  uint32_t code;
+  if (col.GetDictionary()->Lookup(compare_val_.GetAsVarChar(),
+                                  compare_val_.GetLogicLength(), &code)) {
+    compare_code_ = true;
+    compare_code_val_ = code;
+    code_offset_ = (schema_->GetColumnCount() + 7) / 8 + col.GetOffset();
+  } else if (op_ == CompareOp::EQ) {
+    reject_all_ = true;
+  }
+}
 
-  // 检查左边是否是列引用
-  if (left->type == hsql::kExprColumnRef && left->name != nullptr) {
-    is_left_column = true;
-    // 查找列索引
-    for (uint32_t i = 0; i < schema_->GetColumnCount(); i++) {
-      if (strcmp(schema_->GetColumn(i).GetName().c_str(), left->name) == 0) {
-        col_idx = i;
-        break;
-      }
-    }
-    // 评估右边值
-    if (right->type == hsql::kExprLiteralInt) {
-      compare_val = Value(static_cast<int32_t>(right->ival));
-    } else if (right->type == hsql::kExprLiteralString &&
-               right->name != nullptr) {
-      compare_val = Value(std::string(right->name));
-    } else {
-      return true;  // 无法评估右边值
+void FilterExecutor::PushDownFilter() {
+  if (!simple_ || reject_all_) return;
+  auto* scan = dynamic_cast<TableScanExecutor*>(child_.get());
+  const Column& col = schema_->GetColumn(col_idx_);
+  if (scan == nullptr || !ScanPredicate::Supports(col, op_)) return;
+
+  int64_t constant;
+  if (col.IsDictEncoded()) {
+    if (!compare_code_) return;
+    constant = compare_code_val_;
+  } else if (compare_val_.GetTypeId() != col.GetType()) {
+    return;
+  } else if (col.GetType() == TypeId::INTEGER ||
+             col.GetType() == TypeId::DATE) {
+    constant = compare_val_.GetAsInteger();
+  } else {
+    constant = compare_val_.GetAsBigInt();
+  }
+  scan->SetPredicate(
+      std::make_unique<ScanPredicate>(schema_, col_idx_, op_, constant));
+  accept_all_ = true;
+}
+
+bool FilterExecutor::EvaluateFilter(const Tuple& tuple) {
+  if (accept_all_) return true;
+  if (reject_all_) return false;
+
+  if (!simple_) {
+    return predicate_->EvaluatePredicate(
+        ExprInput(&tuple, schema_, exec_ctx_->catalog_->GetBPM()));
+  }
+
+  if (compare_code_) {
+    const char* data = tuple.GetData();
+    if (data[col_idx_ >> 3] & (1 << (col_idx_ % 8))) {
+      return false;  // NULL
     }
+    uint32_t code;
+    std::memcpy(&code, data + code_offset_, sizeof(code));
+    return (code == compare_code_val_) == (op_ == CompareOp::EQ);
   }
-  // 检查右边是否是列引用
-  else if (right->type == hsql::kExprColumnRef && right->name != nullptr) {
-    is_left_column = false;
-    // 查找列索引
-    for (uint32_t i = 0; i < schema_->GetColumnCount(); i++) {
-      if (strcmp(schema_->GetColumn(i).GetName().c_str(), right->name) == 0) {
-        col_idx = i;
-        break;
-      }
+
+  Value col_val =
+      tuple.GetValue(schema_, col_idx_, exec_ctx_->catalog_->GetBPM());
+  if (col_val.IsNull()) {
+    return false;  // NULL 和任何值比较都不成立
+  }
+
+  // 比较：每行只是对选定内核的直接调用
+  const Value& rhs = compare_val_;
+  switch (op_) {
+    case CompareOp::EQ:
+      return kernels_->equals_(col_val, rhs);
+    case CompareOp::NE:
+      return !kernels_->equals_(col_val, rhs);
+    case CompareOp::LT:
+      return kernels_->less_than_(col_val, rhs);
+    case CompareOp::LE:
+      return !kernels_->less_than_(rhs, col_val);
+    case CompareOp::GT:
+      return kernels_->less_than_(rhs, col_val);
+    case CompareOp::GE:
+      return !kernels_->less_than_(col_val, rhs);
+  }
+  return true;
+}
+
+uint32_t FilterExecutor::SelectBatch(const DataChunk& chunk,
+                                     uint32_t* sel_out) const {
+  const uint32_t* sel_in = chunk.GetSelection();
+  uint32_t count = chunk.GetSelectedCount();
+
+  // 一般表达式：逐行求值
+  if (!simple_) {
+    uint32_t selected = 0;
+    for (uint32_t i = 0; i < count; i++) {
+      uint32_t row = sel_in == nullptr ? i : sel_in[i];
+      sel_out[selected] = row;
+      selected += static_cast<uint32_t>(
+          predicate_->EvaluatePredicate(ExprInput(&chunk, row)));
     }
-    // 评估左边值
-    if (left->type == hsql::kExprLiteralInt) {
-      compare_val = Value(static_cast<int32_t>(left->ival));
-    } else if (left->type == hsql::kExprLiteralString &&
-               left->name != nullptr) {
-      compare_val = Value(std::string(left->name));
-    } else {
-      return true;  // 无法评估左边值
+    return selected;
+  }
+
+  const ColumnVector& vec = chunk.GetColumn(col_idx_);
+
+  // 字典列直接比较编码
+  if (compare_code_) {
+    return SelectByOp<uint32_t>(vec.GetNullBitmap(), sel_in, count,
+                                FixedReader<uint32_t>{vec.GetData()},
+                                compare_code_val_, sel_out);
+  }
+  switch (vec.GetType()) {
+    case TypeId::INTEGER:
+    case TypeId::DATE:
+      return SelectFixed<int32_t>(vec, sel_in, count, sel_out);
+    case TypeId::BIGINT:
+    case TypeId::TIMESTAMP:
+      return SelectFixed<int64_t>(vec, sel_in, count, sel_out);
+    case TypeId::DOUBLE:
+      return SelectFixed<double>(vec, sel_in, count, sel_out);
+    case TypeId::BOOLEAN:
+      return SelectFixed<bool>(vec, sel_in, count, sel_out);
+    case TypeId::VARCHAR: {
+      std::string_view rhs(compare_val_.GetAsVarChar(),
+                           compare_val_.GetLogicLength());
+      return SelectByOp<std::string_view>(
+          vec.GetNullBitmap(), sel_in, count,
+          [&vec](uint32_t row) { return vec.GetString(row); }, rhs, sel_out);
     }
-  } else {
-    return true;  // 不支持的表达式形式
-  }
-
-  if (col_idx < 0) {
-    return true;  // 找不到列
-  }
-
-  Value col_val = tuple.GetValue(schema_, col_idx);
-
-  // 比较
-  switch (filter_expr_->opType) {
-    case hsql::kOpEquals:
-      return col_val.CompareEquals(compare_val);
-    case hsql::kOpNotEquals:
-      return !col_val.CompareEquals(compare_val);
-    case hsql::kOpLess:
-      return col_val.CompareLessThan(compare_val);
-    case hsql::kOpLessEq:
-      return col_val.CompareLessThan(compare_val) ||
-             col_val.CompareEquals(compare_val);
-    case hsql::kOpGreater:
-      return !col_val.CompareLessThan(compare_val) &&
-             !col_val.CompareEquals(compare_val);
-    case hsql::kOpGreaterEq:
-      return !col_val.CompareLessThan(compare_val);
     default:
-      return true;  // 不支持的操作符
+      return 0;
+  }
+}
+
+template <typename T>
+uint32_t FilterExecutor::SelectFixed(const ColumnVector& vec,
+                                     const uint32_t* sel_in, uint32_t count,
+                                     uint32_t* sel_out) const {
+  // 常量按存储格式取出来，循环里只比较原始值
+  char storage[sizeof(int64_t)];
+  compare_val_.SerializeTo(storage);
+  T rhs;
+  std::memcpy(&rhs, storage, sizeof(rhs));
+  return SelectByOp<T>(vec.GetNullBitmap(), sel_in, count,
+                       FixedReader<T>{vec.GetData()}, rhs, sel_out);
+}
+
+template <typename T, typename Get>
+uint32_t FilterExecutor::SelectByOp(const uint8_t* nulls,
+                                    const uint32_t* sel_in, uint32_t count,
+                                    Get get, const T& rhs,
+                                    uint32_t* sel_out) const {
+  switch (op_) {
+    case CompareOp::EQ:
+      return SelectLoop(nulls, sel_in, count, get,
+                        [&rhs](const T& val) { return val == rhs; }, sel_out);
+    case CompareOp::NE:
+      return SelectLoop(nulls, sel_in, count, get,
+                        [&rhs](const T& val) { return val != rhs; }, sel_out);
+    case CompareOp::LT:
+      return SelectLoop(nulls, sel_in, count, get,
+                        [&rhs](const T& val) { return val < rhs; }, sel_out);
+    case CompareOp::LE:
+      return SelectLoop(nulls, sel_in, count, get,
+                        [&rhs](const T& val) { return val <= rhs; }, sel_out);
+    case CompareOp::GT:
+      return SelectLoop(nulls, sel_in, count, get,
+                        [&rhs](const T& val) { return val > rhs; }, sel_out);
+    case CompareOp::GE:
+      return SelectLoop(nulls, sel_in, count, get,
+                        [&rhs](const T& val) { return val >= rhs; }, sel_out);
   }
+  return 0;
 }
 
 }  // namespace bustub
@@ -0,0 +1,509 @@
+#include "execution/hash_join_executor.h"
+
+#include <cstring>
+#include <utility>
+
+#include "common/exception.h"
+#include "common/hash_util.h"
+#include "execution/pipeline.h"
+#include "sql/Expr.h"
+#include "type/key_encoder.h"
+
+namespace bustub {
+
+namespace {
+constexpr uint32_t INVALID_ENTRY = UINT32_MAX;
+// 每行在哈希表里除了 tuple 字节和 key 之外的开销 (Tuple、Entry、桶)
+constexpr std::size_t ROW_OVERHEAD =
+    sizeof(Tuple) + sizeof(uint64_t) * 4 + sizeof(uint32_t) * 2;
+
+Column RenameColumn(const Column& col, const char* qualifier) {
+  std::string name = qualifier == nullptr
+                         ? col.GetName()
+                         : std::string(qualifier) + "." + col.GetName();
+  if (col.GetType() == TypeId::VARCHAR) {
+    return Column(std::move(name), TypeId::VARCHAR, col.GetStorageSize());
+  }
+  return Column(std::move(name), col.GetType());
+}
+
+void SplitAnd(const hsql::Expr* expr, std::vector<const hsql::Expr*>* out) {
+  if (expr->type == hsql::kExprOperator && expr->opType == hsql::kOpAnd) {
+    SplitAnd(expr->expr, out);
+    SplitAnd(expr->expr2, out);
+    return;
+  }
+  out->push_back(expr);
+}
+}  // namespace
+
+HashJoinExecutor::HashJoinExecutor(
+    std::unique_ptr<Executor> left, const Schema* left_schema,
+    const char* left_name, std::unique_ptr<Executor> right,
+    const Schema* right_schema, const char* right_name, JoinType join_type,
+    const hsql::Expr* condition, bool build_left)
+  : join_type_(join_type),
+    build_left_(build_left && join_type == JoinType::INNER) {
+  left_.child_ = std::move(left);
+  left_.schema_ = left_schema;
+  right_.child_ = std::move(right);
+  right_.schema_ = right_schema;
+
+  std::vector<Column> columns;
+  for (uint32_t i = 0; i < left_schema->GetColumnCount(); i++) {
+    columns.push_back(RenameColumn(left_schema->GetColumn(i), left_name));
+  }
+  for (uint32_t i = 0; i < right_schema->GetColumnCount(); i++) {
+    columns.push_back(RenameColumn(right_schema->GetColumn(i), right_name));
+  }
+  output_schema_ = std::make_unique<Schema>("join", columns);
+
+  if (condition == nullptr) {
+    throw Exception(ExceptionType::NOT_IMPLEMENTED, "JOIN requires ON");
+  }
+  BindCondition(condition);
+}
+
+void HashJoinExecutor::BindCondition(const hsql::Expr* condition) {
+  uint32_t left_count = left_.schema_->GetColumnCount();
+  // 0: 不引用列  1: 只引用左侧  2: 只引用右侧  3: 两侧都引用
+  auto side_of = [&](const CompiledExpr& expr) {
+    std::vector<uint32_t> cols;
+    expr.CollectColumns(&cols);
+    int side = 0;
+    for (auto col_idx : cols) {
+      side |= col_idx < left_count ? 1 : 2;
+    }
+    return side;
+  };
+
+  std::vector<const hsql::Expr*> conjuncts;
+  SplitAnd(condition, &conjuncts);
+  for (const hsql::Expr* item : conjuncts) {
+    auto compiled = ExprCompiler::Compile(item, output_schema_.get());
+    if (item->type == hsql::kExprOperator && item->opType == hsql::kOpEquals) {
+      int lhs = side_of(*ExprCompiler::Compile(item->expr, output_schema_.get()));
+      int rhs =
+          side_of(*ExprCompiler::Compile(item->expr2, output_schema_.get()));
+      if ((lhs == 1 && rhs == 2) || (lhs == 2 && rhs == 1)) {
+        const hsql::Expr* left_expr = lhs == 1 ? item->expr : item->expr2;
+        const hsql::Expr* right_expr = lhs == 1 ? item->expr2 : item->expr;
+        // 每一侧的 key 在这一侧自己的行上求值
+        left_.keys_.push_back(ExprCompiler::Compile(left_expr, left_.schema_));
+        right_.keys_.push_back(
+            ExprCompiler::Compile(right_expr, right_.schema_));
+        TypeId left_type = left_.keys_.back()->GetReturnType();
+        TypeId right_type = right_.keys_.back()->GetReturnType();
+        TypeId key_type = ExprCompiler::CommonType(left_type, right_type);
+        if (key_type == TypeId::INVALID) {
+          throw Exception(ExceptionType::MISMATCH_TYPE,
+                          "cannot join " + Type::TypeIdToString(left_type) +
+                              " with " + Type::TypeIdToString(right_type));
+        }
+        key_types_.push_back(key_type);
+        continue;
+      }
+    }
+    TypeId type_id = compiled->GetReturnType();
+    if (type_id != TypeId::BOOLEAN && type_id != TypeId::INVALID) {
+      throw Exception(ExceptionType::MISMATCH_TYPE,
+                      "JOIN condition must be BOOLEAN, not " +
+                          Type::TypeIdToString(type_id));
+    }
+    residual_.push_back(std::move(compiled));
+  }
+  if (key_types_.empty()) {
+    throw Exception(ExceptionType::NOT_IMPLEMENTED,
+                    "JOIN condition needs an equality between the two sides");
+  }
+}
+
+void HashJoinExecutor::Init(ExecutionContext* exec_ctx) {
+  OpenSink(exec_ctx);
+  left_.child_->Init(exec_ctx);
+  right_.child_->Init(exec_ctx);
+  Side& build = BuildSide();
+  Tuple tuple;
+  while (build.child_->Next(&tuple)) {
+    AddBuild(tuple);
+  }
+  FinishSink();
+  if (spilled_) {
+    PartitionProbeSide();
+  }
+}
+
+void HashJoinExecutor::OpenSink(ExecutionContext* exec_ctx) {
+  Executor::Init(exec_ctx);
+  ClearTable();
+  spilled_ = false;
+  pending_.clear();
+  current_ = Partition();
+  joined_partitions_ = 0;
+  has_probe_ = false;
+}
+
+void HashJoinExecutor::Sink(const DataChunk& chunk) {
+  uint32_t count = chunk.GetSelectedCount();
+  for (uint32_t k = 0; k < count; k++) {
+    AddBuild(chunk.GetTuple(chunk.GetSelectedRow(k)));
+  }
+}
+
+void HashJoinExecutor::FinishSink() {
+  if (!spilled_) {
+    BuildBuckets();
+  }
+}
+
+void HashJoinExecutor::AddBuild(const Tuple& tuple) {
+  // 超出预算就把已经读进来的行分区写出，之后的行直接写分区
+  key_buffer_.clear();
+  if (!EncodeKey(BuildSide(), tuple, &key_buffer_)) return;
+  uint64_t hash = HashUtil::HashBytes(key_buffer_.data(), key_buffer_.size());
+  if (!spilled_) {
+    AddBuildRow(tuple, key_buffer_, hash);
+    if (table_bytes_ > exec_ctx_->memory_limit_) {
+      StartSpilling();
+    }
+    return;
+  }
+  pending_[PartitionOf(hash, 0)].build_->Append(tuple);
+}
+
+void HashJoinExecutor::BuildPipeline(PipelineBuilder* builder,
+                                     const Schema* schema) {
+  builder->AddOperator(this);
+  Side& build = BuildSide();
+  builder->AddChildPipeline(this, build.child_.get(), build.schema_);
+  Side& probe = ProbeSide();
+  probe.child_->BuildPipeline(builder, probe.schema_);
+}
+
+void HashJoinExecutor::OpenOperator(ExecutionContext* exec_ctx) {
+  // build 侧的流水线已经跑完，这里不能清哈希表
+  Executor::OpenOperator(exec_ctx);
+  if (out_ == nullptr) {
+    out_ = std::make_unique<DataChunk>(output_schema_.get());
+  }
+  out_->Reset();
+  has_probe_ = false;
+}
+
+bool HashJoinExecutor::PushBatch(DataChunk* chunk, Pipeline* pipeline,
+                                 std::size_t next) {
+  uint32_t count = chunk->GetSelectedCount();
+  if (spilled_) {
+    for (uint32_t k = 0; k < count; k++) {
+      PartitionProbeRow(chunk->GetTuple(chunk->GetSelectedRow(k)));
+    }
+    return true;
+  }
+  Tuple output;
+  for (uint32_t k = 0; k < count; k++) {
+    probe_ = chunk->GetTuple(chunk->GetSelectedRow(k));
+    if (!StartProbe()) continue;
+    while (NextMatch(&output)) {
+      if (!Emit(output, pipeline, next)) return false;
+    }
+  }
+  return Flush(pipeline, next);
+}
+
+bool HashJoinExecutor::FinishOperator(Pipeline* pipeline, std::size_t next) {
+  if (!spilled_) {
+    return true;
+  }
+  RewindPartitions();
+  // 逐个分区 join，和拉取方式走同一段代码
+  Tuple output;
+  while (Next(&output)) {
+    if (!Emit(output, pipeline, next)) return false;
+  }
+  return Flush(pipeline, next);
+}
+
+bool HashJoinExecutor::Emit(const Tuple& tuple, Pipeline* pipeline,
+                            std::size_t next) {
+  out_->AppendTuple(tuple, exec_ctx_->catalog_->GetBPM());
+  return !out_->IsFull() || Flush(pipeline, next);
+}
+
+bool HashJoinExecutor::Flush(Pipeline* pipeline, std::size_t next) {
+  if (out_->GetSize() == 0) {
+    return true;
+  }
+  bool open = pipeline->Push(out_.get(), next);
+  out_->Reset();
+  return open;
+}
+
+bool HashJoinExecutor::EncodeKey(const Side& side, const Tuple& tuple,
+                                 std::string* key) const {
+  ExprInput input(&tuple, side.schema_, exec_ctx_->catalog_->GetBPM());
+  for (uint32_t i = 0; i < side.keys_.size(); i++) {
+    Value val = side.keys_[i]->Evaluate(input);
+    if (val.IsNull()) return false;
+    if (val.GetTypeId() != key_types_[i]) {
+      val = val.CastAs(key_types_[i]);
+    }
+    KeyEncoder::EncodeValue(val, key);
+  }
+  return true;
+}
+
+uint32_t HashJoinExecutor::PartitionOf(uint64_t hash, uint32_t depth) {
+  // 每一层用不同的哈希位：低位已经用来选桶，这里先混一次再取高位
+  uint64_t mixed = HashUtil::Mix64(hash + depth * 0x9E3779B97F4A7C15ULL);
+  return static_cast<uint32_t>(mixed >> 32) % NUM_PARTITIONS;
+}
+
+// ============ 内存哈希表 ============
+
+void HashJoinExecutor::AddBuildRow(const Tuple& tuple, const std::string& key,
+                                   uint64_t hash) {
+  entries_.push_back(Entry{hash, static_cast<uint32_t>(key_arena_.size()),
+                           static_cast<uint32_t>(key.size()), INVALID_ENTRY});
+  key_arena_.append(key);
+  build_rows_.push_back(tuple);
+  table_bytes_ += tuple.GetStorageSize() + key.size() + ROW_OVERHEAD;
+}
+
+void HashJoinExecutor::BuildBuckets() {
+  std::size_t bucket_count = 16;
+  while (bucket_count < entries_.size() * 2) {
+    bucket_count <<= 1;
+  }
+  buckets_.assign(bucket_count, INVALID_ENTRY);
+  bucket_mask_ = bucket_count - 1;
+  for (uint32_t i = 0; i < entries_.size(); i++) {
+    uint32_t& head = buckets_[entries_[i].hash_ & bucket_mask_];
+    entries_[i].next_ = head;
+    head = i;
+  }
+}
+
+void HashJoinExecutor::ClearTable() {
+  build_rows_.clear();
+  entries_.clear();
+  key_arena_.clear();
+  buckets_.clear();
+  table_bytes_ = 0;
+}
+
+// ============ grace hash join ============
+
+std::vector<HashJoinExecutor::Partition> HashJoinExecutor::NewPartitions(
+    uint32_t depth) {
+  DiskManager* disk_manager = exec_ctx_->catalog_->GetDiskManager();
+  std::vector<Partition> parts(NUM_PARTITIONS);
+  for (auto& part : parts) {
+    part.build_ = std::make_unique<SpillFile>(disk_manager);
+    part.probe_ = std::make_unique<SpillFile>(disk_manager);
+    part.depth_ = depth;
+  }
+  return parts;
+}
+
+void HashJoinExecutor::StartSpilling() {
+  spilled_ = true;
+  pending_ = NewPartitions(0);
+  for (uint32_t i = 0; i < build_rows_.size(); i++) {
+    pending_[PartitionOf(entries_[i].hash_, 0)].build_->Append(build_rows_[i]);
+  }
+  ClearTable();
+}
+
+void HashJoinExecutor::PartitionProbeSide() {
+  Tuple tuple;
+  while (ProbeSide().child_->Next(&tuple)) {
+    PartitionProbeRow(tuple);
+  }
+  RewindPartitions();
+}
+
+void HashJoinExecutor::PartitionProbeRow(const Tuple& tuple) {
+  key_buffer_.clear();
+  if (!EncodeKey(ProbeSide(), tuple, &key_buffer_)) {
+    // key 有 NULL：INNER 直接丢掉，LEFT 随便放进一个分区，探测时补 NULL 输出
+    if (join_type_ == JoinType::LEFT) pending_[0].probe_->Append(tuple);
+    return;
+  }
+  uint64_t hash = HashUtil::HashBytes(key_buffer_.data(), key_buffer_.size());
+  pending_[PartitionOf(hash, 0)].probe_->Append(tuple);
+}
+
+void HashJoinExecutor::RewindPartitions() {
+  for (auto& part : pending_) {
+    part.build_->Rewind();
+    part.probe_->Rewind();
+  }
+}
+
+void HashJoinExecutor::Repartition(Partition* part) {
+  uint32_t depth = part->depth_ + 1;
+  std::vector<Partition> subs = NewPartitions(depth);
+  Tuple tuple;
+  std::string key;
+  while (part->build_->Next(&tuple)) {
+    key.clear();
+    EncodeKey(BuildSide(), tuple, &key);
+    uint64_t hash = HashUtil::HashBytes(key.data(), key.size());
+    subs[PartitionOf(hash, depth)].build_->Append(tuple);
+  }
+  while (part->probe_->Next(&tuple)) {
+    key.clear();
+    if (!EncodeKey(ProbeSide(), tuple, &key)) {
+      subs[0].probe_->Append(tuple);
+      continue;
+    }
+    uint64_t hash = HashUtil::HashBytes(key.data(), key.size());
+    subs[PartitionOf(hash, depth)].probe_->Append(tuple);
+  }
+  for (auto& sub : subs) {
+    sub.build_->Rewind();
+    sub.probe_->Rewind();
+    pending_.push_back(std::move(sub));
+  }
+}
+
+bool HashJoinExecutor::NextPartition() {
+  while (!pending_.empty()) {
+    Partition part = std::move(pending_.back());
+    pending_.pop_back();
+    // 没有 probe 行，或 INNER 没有 build 行：这个分区不会有输出
+    if (part.probe_->GetTupleCount() == 0 ||
+        (join_type_ == JoinType::INNER && part.build_->GetTupleCount() == 0)) {
+      continue;
+    }
+    std::size_t estimate =
+        part.build_->GetBytes() + part.build_->GetTupleCount() * ROW_OVERHEAD;
+    if (estimate > exec_ctx_->memory_limit_ &&
+        part.depth_ + 1 < MAX_PARTITION_DEPTH) {
+      Repartition(&part);
+      continue;
+    }
+
+    ClearTable();
+    Tuple tuple;
+    std::string key;
+    while (part.build_->Next(&tuple)) {
+      key.clear();
+      EncodeKey(BuildSide(), tuple, &key);
+      AddBuildRow(tuple, key, HashUtil::HashBytes(key.data(), key.size()));
+    }
+    BuildBuckets();
+    current_ = std::move(part);
+    joined_partitions_++;
+    return true;
+  }
+  ClearTable();
+  current_ = Partition();
+  return false;
+}
+
+// ============ probe ============
+
+bool HashJoinExecutor::NextProbeRow(Tuple* tuple) {
+  if (!spilled_) {
+    return ProbeSide().child_->Next(tuple);
+  }
+  return current_.probe_ != nullptr && current_.probe_->Next(tuple);
+}
+
+Tuple HashJoinExecutor::MakeOutput(const Tuple* build) const {
+  const Side& build_side = build_left_ ? left_ : right_;
+  BufferPoolManager* bpm = exec_ctx_->catalog_->GetBPM();
+  std::vector<Value> build_values;
+  uint32_t build_count = build_side.schema_->GetColumnCount();
+  build_values.reserve(build_count);
+  for (uint32_t i = 0; i < build_count; i++) {
+    if (build == nullptr) {
+      build_values.emplace_back(build_side.schema_->GetColumn(i).GetType());
+    } else {
+      build_values.push_back(build->GetValue(build_side.schema_, i, bpm));
+    }
+  }
+
+  std::vector<Value> values;
+  values.reserve(output_schema_->GetColumnCount());
+  const std::vector<Value>& first = build_left_ ? build_values : probe_values_;
+  const std::vector<Value>& second = build_left_ ? probe_values_ : build_values;
+  values.insert(values.end(), first.begin(), first.end());
+  values.insert(values.end(), second.begin(), second.end());
+  return Tuple(values, output_schema_.get());
+}
+
+bool HashJoinExecutor::StartProbe() {
+  BufferPoolManager* bpm = exec_ctx_->catalog_->GetBPM();
+  Side& probe = ProbeSide();
+  probe_key_.clear();
+  has_probe_ = true;
+  probe_matched_ = false;
+  chain_ = INVALID_ENTRY;
+  if (EncodeKey(probe, probe_, &probe_key_) && !buckets_.empty()) {
+    probe_hash_ = HashUtil::HashBytes(probe_key_.data(), probe_key_.size());
+    chain_ = buckets_[probe_hash_ & bucket_mask_];
+  } else if (join_type_ == JoinType::INNER) {
+    has_probe_ = false;
+    return false;
+  }
+  probe_values_.clear();
+  for (uint32_t i = 0; i < probe.schema_->GetColumnCount(); i++) {
+    probe_values_.push_back(probe_.GetValue(probe.schema_, i, bpm));
+  }
+  return true;
+}
+
+bool HashJoinExecutor::NextMatch(Tuple* tuple) {
+  if (!has_probe_) {
+    return false;
+  }
+  BufferPoolManager* bpm = exec_ctx_->catalog_->GetBPM();
+  // 沿着桶链找 key 相同的 build 行
+  while (chain_ != INVALID_ENTRY) {
+    const Entry& entry = entries_[chain_];
+    uint32_t idx = chain_;
+    chain_ = entry.next_;
+    if (entry.hash_ != probe_hash_ || entry.key_len_ != probe_key_.size() ||
+        std::memcmp(key_arena_.data() + entry.key_offset_, probe_key_.data(),
+                    entry.key_len_) != 0) {
+      continue;
+    }
+    Tuple output = MakeOutput(&build_rows_[idx]);
+    bool pass = true;
+    ExprInput input(&output, output_schema_.get(), bpm);
+    for (const auto& pred : residual_) {
+      if (!pred->EvaluatePredicate(input)) {
+        pass = false;
+        break;
+      }
+    }
+    if (pass) {
+      probe_matched_ = true;
+      *tuple = std::move(output);
+      return true;
+    }
+  }
+  has_probe_ = false;
+  if (join_type_ == JoinType::LEFT && !probe_matched_) {
+    *tuple = MakeOutput(nullptr);
+    return true;
+  }
+  return false;
+}
+
+bool HashJoinExecutor::Next(Tuple* tuple) {
+  while (true) {
+    if (NextMatch(tuple)) {
+      return true;
+    }
+    if (!NextProbeRow(&probe_)) {
+      if (!spilled_ || !NextPartition()) return false;
+      continue;
+    }
+    StartProbe();
+  }
+}
+
+}  // namespace bustub
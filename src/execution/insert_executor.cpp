@@ -19,7 +19,9 @@ bool InsertExecutor::Next(Tuple* tuple) {
   }
 
   TableHeap table_heap(exec_ctx_->catalog_->GetBPM(), table_id_,
-                       table_info->GetFirstPageId());
+                       &table_info->GetSchema(),
+                       table_info->GetDirectoryPageId(),
+                       table_info->GetStats());
 
   // 创建 tuple 并插入
   Tuple insert_tuple(values_, const_cast<Schema*>(&table_info->GetSchema()));
@@ -0,0 +1,91 @@
+#include "execution/limit_executor.h"
+
+#include <algorithm>
+
+#include "execution/pipeline.h"
+
+namespace bustub {
+
+void LimitExecutor::Init(ExecutionContext* exec_ctx) {
+  Executor::Init(exec_ctx);
+  skipped_ = 0;
+  emitted_ = 0;
+  // LIMIT 0 不需要子执行器
+  if (limit_ > 0) {
+    child_->Init(exec_ctx);
+  }
+}
+
+bool LimitExecutor::Next(Tuple* tuple) {
+  if (emitted_ >= limit_) {
+    return false;
+  }
+  while (skipped_ < offset_) {
+    if (!child_->Next(tuple)) return false;
+    skipped_++;
+  }
+  if (!child_->Next(tuple)) {
+    return false;
+  }
+  emitted_++;
+  return true;
+}
+
+bool LimitExecutor::NextBatch(DataChunk* chunk) {
+  chunk->Reset();
+  if (emitted_ >= limit_) {
+    return false;
+  }
+  while (child_->NextBatch(chunk)) {
+    if (Narrow(chunk) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t LimitExecutor::Narrow(DataChunk* chunk) {
+  uint32_t count = chunk->GetSelectedCount();
+  auto skip = static_cast<uint32_t>(
+      std::min<uint64_t>(offset_ - skipped_, count));
+  auto take = static_cast<uint32_t>(
+      std::min<uint64_t>(limit_ - emitted_, count - skip));
+  skipped_ += skip;
+  emitted_ += take;
+  if (take == 0) return 0;  // 整批都在 OFFSET 里
+  if (skip > 0 || take < count) {
+    uint32_t* sel = chunk->GetSelectionBuffer();
+    for (uint32_t i = 0; i < take; i++) {
+      sel[i] = chunk->GetSelectedRow(skip + i);
+    }
+    chunk->SetSelection(take);
+  }
+  return take;
+}
+
+void LimitExecutor::BuildPipeline(PipelineBuilder* builder,
+                                  const Schema* schema) {
+  // LIMIT 0 不需要子执行器，整个当作 (空的) 数据源
+  if (limit_ == 0) {
+    builder->SetSource(this, schema, true);
+    return;
+  }
+  builder->AddOperator(this);
+  child_->BuildPipeline(builder, schema);
+}
+
+void LimitExecutor::OpenOperator(ExecutionContext* exec_ctx) {
+  Executor::OpenOperator(exec_ctx);
+  skipped_ = 0;
+  emitted_ = 0;
+}
+
+bool LimitExecutor::PushBatch(DataChunk* chunk, Pipeline* pipeline,
+                              std::size_t next) {
+  if (Narrow(chunk) > 0 && !pipeline->Push(chunk, next)) {
+    return false;
+  }
+  return emitted_ < limit_;
+}
+
+}  // namespace bustub
@@ -0,0 +1,124 @@
+#include "execution/pipeline.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+// ============ Executor 的默认 push 接口 ============
+
+void Executor::BuildPipeline(PipelineBuilder* builder, const Schema* schema) {
+  builder->SetSource(this, schema, true);
+}
+
+bool Executor::PushBatch(DataChunk* chunk, Pipeline* pipeline,
+                         std::size_t next) {
+  throw Exception(ExceptionType::NOT_IMPLEMENTED,
+                  "operator cannot run inside a push pipeline");
+}
+
+void Executor::Sink(const DataChunk& chunk) {
+  throw Exception(ExceptionType::NOT_IMPLEMENTED,
+                  "operator cannot be a pipeline sink");
+}
+
+// ============ Pipeline ============
+
+bool Pipeline::Push(DataChunk* chunk, std::size_t op) {
+  if (op < operators_.size()) {
+    return operators_[op]->PushBatch(chunk, this, op + 1);
+  }
+  if (sink_ != nullptr) {
+    sink_->Sink(*chunk);
+    return true;
+  }
+  return (*output_)(*chunk);
+}
+
+void Pipeline::Run(ExecutionContext* exec_ctx) {
+  // 中间算子先准备：过滤要在扫描 Init 之前把谓词下推给它
+  for (Executor* op : operators_) {
+    op->OpenOperator(exec_ctx);
+  }
+  if (sink_ != nullptr) {
+    sink_->OpenSink(exec_ctx);
+  }
+
+  // 从终点往回推出数据源要解码的列
+  std::vector<uint32_t> cols;
+  bool partial = sink_ != nullptr && sink_->PushInputColumns(false, &cols);
+  for (auto it = operators_.rbegin(); it != operators_.rend(); ++it) {
+    partial = (*it)->PushInputColumns(partial, &cols);
+  }
+  DataChunk chunk(source_schema_);
+  if (partial) {
+    chunk.SetNeededColumns(cols);
+  }
+
+  if (init_source_) {
+    source_->Init(exec_ctx);
+  }
+  bool open = true;
+  while (open && source_->NextBatch(&chunk)) {
+    if (chunk.GetSelectedCount() > 0) {
+      open = Push(&chunk, 0);
+    }
+  }
+  // 输入结束：依次让中间算子输出剩下的结果 (比如溢出的 join 分区)
+  for (std::size_t i = 0; i < operators_.size() && open; i++) {
+    open = operators_[i]->FinishOperator(this, i + 1);
+  }
+  if (sink_ != nullptr) {
+    sink_->FinishSink();
+  }
+}
+
+// ============ PipelineBuilder ============
+
+void PipelineBuilder::AddOperator(Executor* op) {
+  current_->operators_.push_back(op);
+}
+
+void PipelineBuilder::SetSource(Executor* source, const Schema* schema,
+                                bool init) {
+  current_->source_ = source;
+  current_->source_schema_ = schema;
+  current_->init_source_ = init;
+  // 算子是从终点往数据源方向加的
+  std::reverse(current_->operators_.begin(), current_->operators_.end());
+}
+
+void PipelineBuilder::AddChildPipeline(Executor* sink, Executor* child,
+                                       const Schema* child_schema) {
+  Pipeline* parent = current_;
+  auto pipeline = std::make_unique<Pipeline>();
+  pipeline->sink_ = sink;
+  current_ = pipeline.get();
+  child->BuildPipeline(this, child_schema);
+  // 子树里更深的流水线已经排在前面了
+  pipelines_.push_back(std::move(pipeline));
+  current_ = parent;
+}
+
+// ============ PipelineExecutor ============
+
+PipelineExecutor::PipelineExecutor(Executor* root, const Schema* schema) {
+  PipelineBuilder builder;
+  auto last = std::make_unique<Pipeline>();
+  builder.current_ = last.get();
+  root->BuildPipeline(&builder, schema);
+  builder.pipelines_.push_back(std::move(last));
+  pipelines_ = std::move(builder.pipelines_);
+}
+
+void PipelineExecutor::Execute(ExecutionContext* exec_ctx,
+                               const Pipeline::OutputFn& output) {
+  pipelines_.back()->output_ = &output;
+  for (auto& pipeline : pipelines_) {
+    pipeline->Run(exec_ctx);
+  }
+}
+
+}  // namespace bustub
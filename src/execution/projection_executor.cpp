@@ -0,0 +1,153 @@
+#include "execution/projection_executor.h"
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "common/exception.h"
+#include "execution/pipeline.h"
+#include "sql/Expr.h"
+
+namespace bustub {
+
+ProjectionExecutor::ProjectionExecutor(
+    std::unique_ptr<Executor> child,
+    const std::vector<hsql::Expr*>& select_list, const Schema* input_schema)
+  : child_(std::move(child)), input_schema_(input_schema) {
+  std::vector<Column> columns;
+  for (const hsql::Expr* item : select_list) {
+    if (item == nullptr) {
+      throw Exception(ExceptionType::EXECUTION, "incomplete select list");
+    }
+    // * 展开成全部输入列
+    if (item->type == hsql::kExprStar) {
+      for (uint32_t i = 0; i < input_schema->GetColumnCount(); i++) {
+        exprs_.push_back(ExprCompiler::CompileColumn(i, input_schema));
+        columns.push_back(ExprCompiler::OutputColumn(input_schema->GetColumn(i).GetName(),
+                                       *exprs_.back(), input_schema));
+      }
+      continue;
+    }
+    exprs_.push_back(ExprCompiler::Compile(item, input_schema));
+    std::string name = "?column?";
+    if (item->alias != nullptr) {
+      name = item->alias;
+    } else if (item->type == hsql::kExprColumnRef && item->name != nullptr) {
+      name = item->name;
+    }
+    columns.push_back(
+        ExprCompiler::OutputColumn(std::move(name), *exprs_.back(), input_schema));
+  }
+  output_schema_ = std::make_unique<Schema>(input_schema->GetName(), columns);
+
+  for (const auto& expr : exprs_) {
+    expr->CollectColumns(&input_columns_);
+  }
+}
+
+void ProjectionExecutor::Init(ExecutionContext* exec_ctx) {
+  Executor::Init(exec_ctx);
+  child_->Init(exec_ctx);
+  input_ = std::make_unique<DataChunk>(input_schema_);
+  input_->SetNeededColumns(input_columns_);
+}
+
+bool ProjectionExecutor::Next(Tuple* tuple) {
+  Tuple input;
+  if (!child_->Next(&input)) {
+    return false;
+  }
+  ExprInput row(&input, input_schema_, exec_ctx_->catalog_->GetBPM());
+  std::vector<Value> values;
+  values.reserve(exprs_.size());
+  for (uint32_t i = 0; i < exprs_.size(); i++) {
+    Value val = exprs_[i]->Evaluate(row);
+    if (val.IsNull()) {
+      val = Value(output_schema_->GetColumn(i).GetType());
+    }
+    values.push_back(std::move(val));
+  }
+  *tuple = Tuple(values, output_schema_.get());
+  tuple->SetRid(input.GetRid());
+  return true;
+}
+
+bool ProjectionExecutor::NextBatch(DataChunk* chunk) {
+  while (child_->NextBatch(input_.get())) {
+    if (input_->GetSelectedCount() == 0) continue;
+    Project(*input_, chunk);
+    return true;
+  }
+  chunk->Reset();
+  return false;
+}
+
+void ProjectionExecutor::Project(const DataChunk& input,
+                                 DataChunk* output) const {
+  output->Reset();
+  uint32_t count = input.GetSelectedCount();
+  for (uint32_t k = 0; k < count; k++) {
+    output->AppendRow(input.GetRid(input.GetSelectedRow(k)));
+  }
+
+  // 按列求值：列引用直接搬值槽，其他表达式逐行求值
+  for (uint32_t i = 0; i < exprs_.size(); i++) {
+    ColumnVector& out = output->GetColumn(i);
+    uint32_t col_idx;
+    if (exprs_[i]->AsColumnRef(&col_idx)) {
+      const ColumnVector& in = input.GetColumn(col_idx);
+      for (uint32_t k = 0; k < count; k++) {
+        uint32_t row = input.GetSelectedRow(k);
+        if (in.IsNull(row)) {
+          out.SetNull(k);
+        } else if (in.GetType() == TypeId::VARCHAR) {
+          std::string_view str = in.GetString(row);
+          out.SetString(k, str.data(), static_cast<uint32_t>(str.size()));
+        } else {
+          out.SetRaw(k, in.GetData() +
+                            static_cast<std::size_t>(row) * in.GetWidth());
+        }
+      }
+      continue;
+    }
+
+    char storage[sizeof(int64_t)];
+    for (uint32_t k = 0; k < count; k++) {
+      Value val =
+          exprs_[i]->Evaluate(ExprInput(&input, input.GetSelectedRow(k)));
+      if (val.IsNull()) {
+        out.SetNull(k);
+      } else if (val.GetTypeId() == TypeId::VARCHAR) {
+        out.SetString(k, val.GetAsVarChar(), val.GetLogicLength());
+      } else {
+        val.SerializeTo(storage);
+        out.SetRaw(k, storage);
+      }
+    }
+  }
+}
+
+void ProjectionExecutor::BuildPipeline(PipelineBuilder* builder,
+                                       const Schema* schema) {
+  builder->AddOperator(this);
+  child_->BuildPipeline(builder, input_schema_);
+}
+
+void ProjectionExecutor::OpenOperator(ExecutionContext* exec_ctx) {
+  Executor::OpenOperator(exec_ctx);
+  output_ = std::make_unique<DataChunk>(output_schema_.get());
+}
+
+bool ProjectionExecutor::PushBatch(DataChunk* chunk, Pipeline* pipeline,
+                                   std::size_t next) {
+  Project(*chunk, output_.get());
+  return pipeline->Push(output_.get(), next);
+}
+
+bool ProjectionExecutor::PushInputColumns(bool partial,
+                                          std::vector<uint32_t>* cols) const {
+  *cols = input_columns_;
+  return true;
+}
+
+}  // namespace bustub
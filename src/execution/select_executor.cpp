@@ -11,4 +11,8 @@ bool SelectExecutor::Next(Tuple* tuple) {
   return source_->Next(tuple);
 }
 
+bool SelectExecutor::NextBatch(DataChunk* chunk) {
+  return source_->NextBatch(chunk);
+}
+
 }  // namespace bustub
@@ -0,0 +1,286 @@
+#include "execution/sort_executor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "common/config.h"
+#include "execution/pipeline.h"
+#include "sql/statements.h"
+#include "type/key_encoder.h"
+
+namespace bustub {
+
+namespace {
+constexpr uint32_t INVALID_RUN = UINT32_MAX;
+// 每行除了 tuple 字节和 key 之外的开销 (Tuple、SortEntry)
+constexpr std::size_t ROW_OVERHEAD = sizeof(Tuple) + sizeof(uint64_t) * 3;
+
+uint64_t KeyPrefix(const char* key, uint32_t len) {
+  uint64_t prefix = 0;
+  for (uint32_t i = 0; i < 8 && i < len; i++) {
+    prefix |= static_cast<uint64_t>(static_cast<uint8_t>(key[i])) << (56 - 8 * i);
+  }
+  return prefix;
+}
+
+// memcmp 顺序，前缀短的排前面
+bool KeyLess(const char* a, uint32_t a_len, const char* b, uint32_t b_len) {
+  int cmp = std::memcmp(a, b, std::min(a_len, b_len));
+  return cmp < 0 || (cmp == 0 && a_len < b_len);
+}
+}  // namespace
+
+SortKey::SortKey(const std::vector<hsql::OrderDescription*>& order_by,
+                 const Schema* schema) {
+  for (const hsql::OrderDescription* order : order_by) {
+    keys_.push_back(ExprCompiler::Compile(order->expr, schema));
+    descending_.push_back(order->type == hsql::kOrderDesc);
+  }
+}
+
+void SortKey::Encode(const ExprInput& input, std::string* key) const {
+  for (uint32_t i = 0; i < keys_.size(); i++) {
+    Value val = keys_[i]->Evaluate(input);
+    TypeId type_id = keys_[i]->GetReturnType();
+    if (!val.IsNull() && val.GetTypeId() != type_id &&
+        type_id != TypeId::INVALID) {
+      val = val.CastAs(type_id);
+    }
+    KeyEncoder::EncodeValue(val, key, descending_[i]);
+  }
+}
+
+SortExecutor::SortExecutor(
+    std::unique_ptr<Executor> child,
+    const std::vector<hsql::OrderDescription*>& order_by, const Schema* schema)
+  : child_(std::move(child)), schema_(schema), sort_key_(order_by, schema) {}
+
+void SortExecutor::Init(ExecutionContext* exec_ctx) {
+  OpenSink(exec_ctx);
+  child_->Init(exec_ctx);
+  BufferPoolManager* bpm = exec_ctx_->catalog_->GetBPM();
+  Tuple tuple;
+  while (child_->Next(&tuple)) {
+    ExprInput input(&tuple, schema_, bpm);
+    AddRow(input, std::move(tuple));
+  }
+  FinishSink();
+}
+
+void SortExecutor::OpenSink(ExecutionContext* exec_ctx) {
+  Executor::Init(exec_ctx);
+  ClearBuffer();
+  runs_.clear();
+  cursors_.clear();
+  tree_.clear();
+  run_count_ = 0;
+  merge_passes_ = 0;
+}
+
+void SortExecutor::Sink(const DataChunk& chunk) {
+  uint32_t count = chunk.GetSelectedCount();
+  for (uint32_t k = 0; k < count; k++) {
+    uint32_t row = chunk.GetSelectedRow(k);
+    AddRow(ExprInput(&chunk, row), chunk.GetTuple(row));
+  }
+}
+
+void SortExecutor::BuildPipeline(PipelineBuilder* builder,
+                                 const Schema* schema) {
+  builder->SetSource(this, schema, false);
+  builder->AddChildPipeline(this, child_.get(), schema_);
+}
+
+void SortExecutor::AddRow(const ExprInput& input, Tuple&& tuple) {
+  key_buffer_.clear();
+  sort_key_.Encode(input, &key_buffer_);
+  auto key_len = static_cast<uint32_t>(key_buffer_.size());
+  entries_.push_back(SortEntry{KeyPrefix(key_buffer_.data(), key_len),
+                               static_cast<uint32_t>(key_arena_.size()),
+                               key_len, static_cast<uint32_t>(rows_.size())});
+  key_arena_.append(key_buffer_);
+  buffer_bytes_ += tuple.GetStorageSize() + key_len + ROW_OVERHEAD;
+  rows_.push_back(std::move(tuple));
+  if (buffer_bytes_ > exec_ctx_->memory_limit_) {
+    FlushRun();
+  }
+}
+
+void SortExecutor::FinishSink() {
+  if (runs_.empty()) {
+    SortBuffer();
+    output_pos_ = 0;
+    return;
+  }
+  if (!entries_.empty()) {
+    FlushRun();
+  }
+
+  // 每一路归并要一页缓冲，run 比 fan-in 多时先把最早的几个 run 归并成一个
+  std::size_t fan_in = std::clamp<std::size_t>(
+      exec_ctx_->memory_limit_ / PAGE_SIZE, 2, MAX_MERGE_FAN_IN);
+  DiskManager* disk_manager = exec_ctx_->catalog_->GetDiskManager();
+  std::size_t first = 0;
+  while (runs_.size() - first > fan_in) {
+    auto output = std::make_unique<SpillFile>(disk_manager);
+    std::vector<SpillFile*> inputs;
+    for (std::size_t i = first; i < first + fan_in; i++) {
+      inputs.push_back(runs_[i].get());
+    }
+    MergeInto(std::move(inputs), output.get());
+    for (std::size_t i = first; i < first + fan_in; i++) {
+      runs_[i].reset();  // 尽早删掉临时文件
+    }
+    first += fan_in;
+    output->Rewind();
+    runs_.push_back(std::move(output));
+    merge_passes_++;
+  }
+
+  std::vector<SpillFile*> inputs;
+  for (std::size_t i = first; i < runs_.size(); i++) {
+    inputs.push_back(runs_[i].get());
+  }
+  StartMerge(std::move(inputs));
+  merge_passes_++;
+}
+
+// ============ 内存排序 ============
+
+void SortExecutor::SortBuffer() {
+  const char* arena = key_arena_.data();
+  std::sort(entries_.begin(), entries_.end(),
+            [arena](const SortEntry& a, const SortEntry& b) {
+              if (a.prefix_ != b.prefix_) return a.prefix_ < b.prefix_;
+              return KeyLess(arena + a.key_offset_, a.key_len_,
+                             arena + b.key_offset_, b.key_len_);
+            });
+}
+
+void SortExecutor::ClearBuffer() {
+  rows_.clear();
+  entries_.clear();
+  key_arena_.clear();
+  buffer_bytes_ = 0;
+  output_pos_ = 0;
+}
+
+void SortExecutor::FlushRun() {
+  SortBuffer();
+  auto run = std::make_unique<SpillFile>(exec_ctx_->catalog_->GetDiskManager());
+  for (const SortEntry& entry : entries_) {
+    const Tuple& row = rows_[entry.row_];
+    std::size_t size =
+        sizeof(uint32_t) + entry.key_len_ + row.GetStorageSize();
+    merge_buffer_.resize(size);
+    char* out = merge_buffer_.data();
+    std::memcpy(out, &entry.key_len_, sizeof(uint32_t));
+    std::memcpy(out + sizeof(uint32_t), key_arena_.data() + entry.key_offset_,
+                entry.key_len_);
+    std::memcpy(out + sizeof(uint32_t) + entry.key_len_, row.GetData(),
+                row.GetStorageSize());
+    run->Append(out, static_cast<uint32_t>(size));
+  }
+  run->Rewind();
+  runs_.push_back(std::move(run));
+  run_count_++;
+  ClearBuffer();
+}
+
+// ============ 败者树归并 ============
+
+void SortExecutor::StartMerge(std::vector<SpillFile*> inputs) {
+  cursors_.clear();
+  for (SpillFile* file : inputs) {
+    cursors_.push_back(RunCursor{file});
+  }
+  for (uint32_t i = 0; i < cursors_.size(); i++) {
+    Advance(i);
+  }
+  // 建树：一个结点先到的一路停在这里，第二路到了再比，胜者继续往上
+  tree_.assign(cursors_.size(), INVALID_RUN);
+  for (auto i = static_cast<uint32_t>(cursors_.size()); i-- > 0;) {
+    Adjust(i);
+  }
+}
+
+void SortExecutor::Advance(uint32_t run) {
+  RunCursor& cursor = cursors_[run];
+  const char* data;
+  uint32_t size;
+  if (!cursor.file_->Next(&data, &size)) {
+    cursor.done_ = true;
+    return;
+  }
+  std::memcpy(&cursor.key_len_, data, sizeof(uint32_t));
+  cursor.key_ = data + sizeof(uint32_t);
+  cursor.tuple_ = cursor.key_ + cursor.key_len_;
+  cursor.tuple_len_ = size - sizeof(uint32_t) - cursor.key_len_;
+}
+
+void SortExecutor::Adjust(uint32_t run) {
+  // 叶子 i 在完全二叉树里的编号是 i + k，内部结点是 1..k-1
+  uint32_t winner = run;
+  auto k = static_cast<uint32_t>(cursors_.size());
+  for (uint32_t node = (run + k) / 2; node > 0; node /= 2) {
+    if (tree_[node] == INVALID_RUN) {
+      tree_[node] = winner;
+      return;
+    }
+    if (RunLess(tree_[node], winner)) {
+      std::swap(tree_[node], winner);
+    }
+  }
+  tree_[0] = winner;
+}
+
+bool SortExecutor::RunLess(uint32_t a, uint32_t b) const {
+  const RunCursor& x = cursors_[a];
+  const RunCursor& y = cursors_[b];
+  // 读完的一路比什么都大
+  if (x.done_ || y.done_) {
+    return !x.done_ && y.done_;
+  }
+  int cmp = std::memcmp(x.key_, y.key_, std::min(x.key_len_, y.key_len_));
+  if (cmp != 0) return cmp < 0;
+  if (x.key_len_ != y.key_len_) return x.key_len_ < y.key_len_;
+  return a < b;
+}
+
+void SortExecutor::MergeInto(std::vector<SpillFile*> inputs,
+                             SpillFile* output) {
+  StartMerge(std::move(inputs));
+  while (!cursors_[tree_[0]].done_) {
+    uint32_t winner = tree_[0];
+    const RunCursor& cursor = cursors_[winner];
+    // 记录在 run 的缓冲里是连续的，原样写出
+    output->Append(cursor.key_ - sizeof(uint32_t),
+                   sizeof(uint32_t) + cursor.key_len_ + cursor.tuple_len_);
+    Advance(winner);
+    Adjust(winner);
+  }
+  cursors_.clear();
+}
+
+bool SortExecutor::Next(Tuple* tuple) {
+  if (cursors_.empty()) {
+    if (output_pos_ >= entries_.size()) {
+      return false;
+    }
+    *tuple = std::move(rows_[entries_[output_pos_++].row_]);
+    return true;
+  }
+
+  uint32_t winner = tree_[0];
+  RunCursor& cursor = cursors_[winner];
+  if (cursor.done_) {
+    return false;
+  }
+  *tuple = Tuple(RID(), const_cast<char*>(cursor.tuple_), cursor.tuple_len_);
+  Advance(winner);
+  Adjust(winner);
+  return true;
+}
+
+}  // namespace bustub
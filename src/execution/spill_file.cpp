@@ -0,0 +1,90 @@
+#include "execution/spill_file.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/config.h"
+#include "storage/disk/disk_manager.h"
+
+namespace bustub {
+
+SpillFile::SpillFile(DiskManager* disk_manager)
+  : disk_manager_(disk_manager),
+    file_id_(disk_manager->CreateTempFile()),
+    page_(PAGE_SIZE) {}
+
+SpillFile::~SpillFile() { disk_manager_->DeleteTempFile(file_id_); }
+
+void SpillFile::Append(const Tuple& tuple) {
+  Append(tuple.GetData(), tuple.GetStorageSize());
+}
+
+void SpillFile::Append(const char* data, uint32_t size) {
+  Write(reinterpret_cast<const char*>(&size), sizeof(size));
+  Write(data, size);
+  tuple_count_++;
+}
+
+void SpillFile::Write(const char* data, std::size_t len) {
+  bytes_ += len;
+  while (len > 0) {
+    std::size_t n = std::min(len, page_.size() - offset_);
+    std::memcpy(page_.data() + offset_, data, n);
+    offset_ += n;
+    data += n;
+    len -= n;
+    if (offset_ == page_.size()) {
+      disk_manager_->WriteTempPage(file_id_, page_no_++, page_.data());
+      offset_ = 0;
+    }
+  }
+}
+
+void SpillFile::Rewind() {
+  if (offset_ > 0) {
+    disk_manager_->WriteTempPage(file_id_, page_no_, page_.data());
+    offset_ = 0;
+  }
+  // 读第一个字节时再装入第 0 页
+  page_no_ = 0;
+  offset_ = page_.size();
+  read_bytes_ = 0;
+}
+
+void SpillFile::Read(char* data, std::size_t len) {
+  read_bytes_ += len;
+  while (len > 0) {
+    if (offset_ == page_.size()) {
+      disk_manager_->ReadTempPage(file_id_, page_no_++, page_.data());
+      offset_ = 0;
+    }
+    std::size_t n = std::min(len, page_.size() - offset_);
+    std::memcpy(data, page_.data() + offset_, n);
+    offset_ += n;
+    data += n;
+    len -= n;
+  }
+}
+
+bool SpillFile::Next(Tuple* tuple) {
+  const char* data;
+  uint32_t size;
+  if (!Next(&data, &size)) {
+    return false;
+  }
+  *tuple = Tuple(RID(), tuple_buffer_.data(), size);
+  return true;
+}
+
+bool SpillFile::Next(const char** data, uint32_t* size) {
+  if (read_bytes_ >= bytes_) {
+    return false;
+  }
+  Read(reinterpret_cast<char*>(size), sizeof(*size));
+  tuple_buffer_.resize(*size);
+  Read(tuple_buffer_.data(), *size);
+  *data = tuple_buffer_.data();
+  return true;
+}
+
+}  // namespace bustub
@@ -15,10 +15,21 @@ void TableScanExecutor::Init(ExecutionContext* exec_ctx) {
 
   // 创建 TableHeap 程文
   table_heap_ = std::make_unique<TableHeap>(
-      exec_ctx->catalog_->GetBPM(), table_id_, table_info->GetFirstPageId());
+      exec_ctx->catalog_->GetBPM(), table_id_, &table_info->GetSchema(),
+      table_info->GetDirectoryPageId());
 
-  // 创建迭代器，从表头开始
-  iter_ = std::make_unique<TableHeap::TableIterator>(table_heap_->Begin());
+  // 创建迭代器，从范围的第一页开始 (有下推的谓词时由迭代器在页上过滤)
+  iter_ = std::make_unique<TableHeap::TableIterator>(
+      table_heap_->Begin(range_begin_, range_end_, predicate_.get()));
+}
+
+void TableScanExecutor::SetPageRange(std::size_t begin, std::size_t end) {
+  range_begin_ = begin;
+  range_end_ = end;
+  if (table_heap_ != nullptr) {
+    iter_ = std::make_unique<TableHeap::TableIterator>(
+        table_heap_->Begin(range_begin_, range_end_, predicate_.get()));
+  }
 }
 
 bool TableScanExecutor::Next(Tuple* tuple) {
@@ -43,4 +54,19 @@ bool TableScanExecutor::Next(Tuple* tuple) {
   return true;
 }
 
+bool TableScanExecutor::NextBatch(DataChunk* chunk) {
+  chunk->Reset();
+  if (!iter_ || !table_heap_) {
+    return false;
+  }
+
+  auto end_iter = table_heap_->End();
+  BufferPoolManager* bpm = exec_ctx_->catalog_->GetBPM();
+  while (!chunk->IsFull() && *iter_ != end_iter) {
+    chunk->AppendTuple(**iter_, bpm);
+    ++(*iter_);
+  }
+  return chunk->GetSize() > 0;
+}
+
 }  // namespace bustub
@@ -0,0 +1,96 @@
+#include "execution/topn_executor.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "execution/pipeline.h"
+
+namespace bustub {
+
+TopNExecutor::TopNExecutor(std::unique_ptr<Executor> child,
+                           const std::vector<hsql::OrderDescription*>& order_by,
+                           const Schema* schema, uint64_t n)
+  : child_(std::move(child)),
+    schema_(schema),
+    sort_key_(order_by, schema),
+    n_(n) {}
+
+namespace {
+// std::string 的 < 就是 memcmp 顺序
+template <typename Entry>
+bool KeyLess(const Entry& a, const Entry& b) {
+  return a.key_ < b.key_;
+}
+}  // namespace
+
+void TopNExecutor::Init(ExecutionContext* exec_ctx) {
+  OpenSink(exec_ctx);
+  if (n_ == 0) {
+    return;
+  }
+  child_->Init(exec_ctx);
+  BufferPoolManager* bpm = exec_ctx_->catalog_->GetBPM();
+  Tuple tuple;
+  while (child_->Next(&tuple)) {
+    Offer(ExprInput(&tuple, schema_, bpm), [&]() { return std::move(tuple); });
+  }
+  FinishSink();
+}
+
+void TopNExecutor::OpenSink(ExecutionContext* exec_ctx) {
+  Executor::Init(exec_ctx);
+  heap_.clear();
+  output_pos_ = 0;
+}
+
+void TopNExecutor::Sink(const DataChunk& chunk) {
+  uint32_t count = chunk.GetSelectedCount();
+  for (uint32_t k = 0; k < count; k++) {
+    uint32_t row = chunk.GetSelectedRow(k);
+    Offer(ExprInput(&chunk, row), [&]() { return chunk.GetTuple(row); });
+  }
+}
+
+void TopNExecutor::FinishSink() {
+  std::sort_heap(heap_.begin(), heap_.end(), KeyLess<HeapEntry>);
+}
+
+void TopNExecutor::BuildPipeline(PipelineBuilder* builder,
+                                 const Schema* schema) {
+  // LIMIT 0 不需要子树
+  if (n_ == 0) {
+    builder->SetSource(this, schema, true);
+    return;
+  }
+  builder->SetSource(this, schema, false);
+  builder->AddChildPipeline(this, child_.get(), schema_);
+}
+
+template <typename MakeTuple>
+void TopNExecutor::Offer(const ExprInput& input, MakeTuple make_tuple) {
+  key_buffer_.clear();
+  sort_key_.Encode(input, &key_buffer_);
+  if (heap_.size() < n_) {
+    heap_.push_back(HeapEntry{key_buffer_, make_tuple()});
+    std::push_heap(heap_.begin(), heap_.end(), KeyLess<HeapEntry>);
+    return;
+  }
+  // 堆满：只有比当前第 n 小的行更小才替换堆顶
+  if (!(key_buffer_ < heap_.front().key_)) {
+    return;
+  }
+  std::pop_heap(heap_.begin(), heap_.end(), KeyLess<HeapEntry>);
+  heap_.back().key_.swap(key_buffer_);
+  heap_.back().row_ = make_tuple();
+  std::push_heap(heap_.begin(), heap_.end(), KeyLess<HeapEntry>);
+}
+
+bool TopNExecutor::Next(Tuple* tuple) {
+  if (output_pos_ >= heap_.size()) {
+    return false;
+  }
+  *tuple = std::move(heap_[output_pos_++].row_);
+  return true;
+}
+
+}  // namespace bustub
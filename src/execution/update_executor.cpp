@@ -1,38 +1,108 @@
 #include "execution/update_executor.h"
 
-#include "storage/table/table_heap.h"
+#include <string>
+
+#include "common/exception.h"
+#include "sql/statements.h"
 
 namespace bustub {
 
+UpdateExecutor::UpdateExecutor(std::unique_ptr<Executor> child,
+                               table_id_t table_id,
+                               const std::vector<hsql::UpdateClause*>& updates,
+                               const Schema* schema)
+  : child_(std::move(child)), table_id_(table_id), schema_(schema) {
+  if (updates.empty()) {
+    throw Exception(ExceptionType::EXECUTION, "UPDATE requires SET clause");
+  }
+  for (const hsql::UpdateClause* clause : updates) {
+    if (clause == nullptr || clause->column == nullptr ||
+        clause->value == nullptr) {
+      throw Exception(ExceptionType::EXECUTION, "invalid UPDATE clause");
+    }
+    uint32_t col_idx = 0;
+    while (col_idx < schema_->GetColumnCount() &&
+           schema_->GetColumn(col_idx).GetName() != clause->column) {
+      col_idx++;
+    }
+    if (col_idx == schema_->GetColumnCount()) {
+      throw Exception(ExceptionType::CATALOG,
+                      "unknown column '" + std::string(clause->column) + "'");
+    }
+    for (uint32_t prev : columns_) {
+      if (prev == col_idx) {
+        throw Exception(ExceptionType::EXECUTION,
+                        "column '" + std::string(clause->column) +
+                            "' assigned more than once");
+      }
+    }
+    const Column& col = schema_->GetColumn(col_idx);
+    in_place_ = in_place_ && col.IsInlined() && !col.IsDictEncoded();
+    columns_.push_back(col_idx);
+    exprs_.push_back(ExprCompiler::Compile(clause->value, schema_));
+    exprs_.back()->CollectColumns(&input_columns_);
+  }
+}
+
 void UpdateExecutor::Init(ExecutionContext* exec_ctx) {
   Executor::Init(exec_ctx);
+  auto table_info = exec_ctx_->catalog_->GetTable(table_id_);
+  if (!table_info) {
+    throw Exception(ExceptionType::CATALOG, "table to update not found");
+  }
+  // 整条语句共用一个 TableHeap，维护 TableInfo 的统计
+  table_heap_ = std::make_unique<TableHeap>(
+      exec_ctx_->catalog_->GetBPM(), table_id_, schema_,
+      table_info->GetDirectoryPageId(), table_info->GetStats());
+  // 整行更新时其余列由 TableHeap 从存储的旧行原样拷贝，这里也只解码 SET 用到的列
+  input_ = std::make_unique<DataChunk>(schema_);
+  input_->SetNeededColumns(input_columns_);
+  values_.resize(columns_.size(), Value(TypeId::INVALID));
+  affected_rows_ = 0;
+  updated_ = false;
+  child_->Init(exec_ctx);
 }
 
-bool UpdateExecutor::Next(Tuple* tuple) {
-  if (updated_) {
-    return false;
+Value UpdateExecutor::Evaluate(uint32_t i, const DataChunk& chunk,
+                               uint32_t row) const {
+  const Column& col = schema_->GetColumn(columns_[i]);
+  Value val = exprs_[i]->Evaluate(ExprInput(&chunk, row));
+  if (val.IsNull()) {
+    return Value(col.GetType());
   }
+  if (val.GetTypeId() != col.GetType()) {
+    val = val.CastAs(col.GetType());
+  }
+  if (col.GetType() == TypeId::VARCHAR &&
+      val.GetLogicLength() > col.GetStorageSize()) {
+    throw Exception(ExceptionType::OUT_OF_RANGE,
+                    "value too long for column '" + col.GetName() + "'");
+  }
+  return val;
+}
 
-  auto table_info = exec_ctx_->catalog_->GetTable(table_id_);
-  if (!table_info) {
+bool UpdateExecutor::Next(Tuple* tuple) {
+  if (updated_) {
     return false;
   }
-
-  TableHeap table_heap(exec_ctx_->catalog_->GetBPM(), table_id_,
-                       table_info->GetFirstPageId());
-
-  // 遍历所有行并更新
-  auto iter = table_heap.Begin();
-  auto end_iter = table_heap.End();
-
-  while (iter != end_iter) {
-    Tuple old_tuple = *iter;
-    Tuple new_tuple(new_values_, const_cast<Schema*>(&table_info->GetSchema()));
-    new_tuple.SetRid(old_tuple.GetRid());
-    table_heap.UpdateTuple(new_tuple, old_tuple.GetRid());
-    ++iter;
+  // 扫描按页拷贝行：原地改写不影响后面的扫描，
+  // 搬走的行放在表尾并标记为搬迁，扫描会跳过，不会被更新两次
+  while (child_->NextBatch(input_.get())) {
+    uint32_t count = input_->GetSelectedCount();
+    for (uint32_t k = 0; k < count; k++) {
+      uint32_t row = input_->GetSelectedRow(k);
+      for (uint32_t i = 0; i < columns_.size(); i++) {
+        values_[i] = Evaluate(i, *input_, row);
+      }
+      RID rid = input_->GetRid(row);
+      bool updated = in_place_
+                         ? table_heap_->UpdateColumns(rid, columns_, values_)
+                         : table_heap_->ReplaceColumns(rid, columns_, values_);
+      if (updated) {
+        affected_rows_++;
+      }
+    }
   }
-
   updated_ = true;
   return true;
 }
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
 #include <iostream>
@@ -14,20 +15,14 @@
 #include "main/sql_handlers.h"
 #include "parser/sql_parser.h"
 #include "storage/disk/disk_manager.h"
+#include "storage/table/dictionary.h"
 #include "type/type_id.h"
 #include "type/value.h"
 
 namespace bustub {
 
 std::string TypeIdToString(TypeId type) {
-  switch (type) {
-    case TypeId::INTEGER:
-      return "INT";
-    case TypeId::VARCHAR:
-      return "VARCHAR";
-    default:
-      return "UNKNOWN";
-  }
+  return Type::TypeIdToString(type);
 }
 
 std::string Trim(const std::string& str) {
@@ -65,14 +60,25 @@ bustub::Value EvaluateExpr(const hsql::Expr* expr) {
 
   switch (expr->type) {
     case hsql::kExprLiteralInt:
-      return bustub::Value(static_cast<int32_t>(expr->ival));
+      if (expr->isBoolLiteral) {
+        return bustub::Value(bustub::TypeId::BOOLEAN, expr->ival);
+      }
+      // 放得下 int32 的仍是 INTEGER，否则是 BIGINT
+      if (expr->ival >= INT32_MIN && expr->ival <= INT32_MAX) {
+        return bustub::Value(static_cast<int32_t>(expr->ival));
+      }
+      return bustub::Value(bustub::TypeId::BIGINT, expr->ival);
     case hsql::kExprLiteralFloat:
-      return bustub::Value(static_cast<int32_t>(expr->fval));
+      return bustub::Value(expr->fval);
+    case hsql::kExprLiteralDate:
+      // DATE '2024-01-31'：按字符串带出，插入时再按列类型解析
+      return bustub::Value(
+          std::string(expr->name != nullptr ? expr->name : ""));
     case hsql::kExprLiteralString:
       return bustub::Value(
           std::string(expr->name != nullptr ? expr->name : ""));
     case hsql::kExprLiteralNull:
-      return bustub::Value(std::string(""));  // NULL 用空字符串表示
+      return bustub::Value(bustub::TypeId::INVALID);  // NULL 字面量，类型由列决定
     default:
       // 复杂表达式（操作符、函数等）不支持
       return bustub::Value(0);
@@ -84,6 +90,10 @@ void PrintHelp() {
   std::cout << "  help                    Show this help" << std::endl;
   std::cout << "  tables                  List all tables" << std::endl;
   std::cout << "  desc <table>            Show table schema" << std::endl;
+  std::cout << "  parallelism [n]         Show or set query threads (0 = cores)"
+            << std::endl;
+  std::cout << "  engine [volcano|push]   Show or set SELECT execution engine"
+            << std::endl;
   std::cout
       << "  [SQL statement]         Execute SQL (with or without semicolon)"
       << std::endl;
@@ -178,10 +188,42 @@ int main(int argc, char* argv[]) {
               if (col.GetType() == bustub::TypeId::VARCHAR) {
                 std::cout << "(" << col.GetStorageSize() << ")";
               }
+              if (col.IsDictEncoded()) {
+                std::cout << " [dict, " << col.GetDictionary()->Size()
+                          << " entries]";
+              }
               std::cout << std::endl;
             }
+            const auto& stats = *table_info->GetStats();
+            std::cout << "  rows=" << stats.live_tuples_
+                      << ", dead=" << stats.dead_tuples_
+                      << ", pages=" << stats.page_count_ << ", fill="
+                      << static_cast<int>(stats.FillFactor() * 100 + 0.5)
+                      << "%" << std::endl;
           }
         }
+      } else if (command.rfind("parallelism", 0) == 0) {
+        std::string rest = bustub::Trim(command.substr(11));
+        if (!rest.empty()) {
+          if (rest.find_first_not_of("0123456789") != std::string::npos ||
+              rest.size() > 4) {
+            std::cout << "Error: Use: parallelism <threads>" << std::endl;
+            continue;
+          }
+          bustub::SetParallelism(static_cast<uint32_t>(std::stoul(rest)));
+        }
+        std::cout << "parallelism = " << bustub::GetParallelism() << std::endl;
+      } else if (command.rfind("engine", 0) == 0) {
+        std::string rest = bustub::Trim(command.substr(6));
+        if (rest == "push" || rest == "volcano") {
+          bustub::SetPushExecution(rest == "push");
+        } else if (!rest.empty()) {
+          std::cout << "Error: Use: engine volcano|push" << std::endl;
+          continue;
+        }
+        std::cout << "engine = "
+                  << (bustub::GetPushExecution() ? "push" : "volcano")
+                  << std::endl;
       } else if (command.rfind("exec", 0) == 0) {
         // exec may be used with quotes or without. Allow: exec "sql" OR exec
         // sql
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "buffer/buffer_pool_manager.h"
+#include "catalog/catalog_manager.h"
+#include "common/exception.h"
+#include "parser/sql_parser.h"
+#include "storage/disk/disk_manager.h"
+
+/*
+  基准测试程序共用的小工具：一个用完即删的数据库目录、取 SELECT 语句、计时。
+  所有程序都在同一个进程里建表、灌数据、跑查询，页全部缓存在 buffer pool 里。
+*/
+
+namespace bustub {
+
+class BenchDatabase {
+ public:
+  explicit BenchDatabase(const std::string& dir,
+                         std::size_t pool_pages = 1 << 18)
+    : dir_(dir) {
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+    disk_manager_ = std::make_unique<DiskManager>(dir_);
+    bpm_ = std::make_unique<BufferPoolManager>(pool_pages, 2,
+                                               disk_manager_.get());
+    catalog_ = std::make_unique<CatalogManager>(
+        bpm_.get(), disk_manager_.get(), (dir_ / "catalog.meta").string());
+  }
+  ~BenchDatabase() {
+    catalog_.reset();
+    bpm_.reset();
+    disk_manager_.reset();
+    std::filesystem::remove_all(dir_);
+  }
+
+  CatalogManager* GetCatalog() const { return catalog_.get(); }
+  BufferPoolManager* GetBPM() const { return bpm_.get(); }
+
+ private:
+  std::filesystem::path dir_;
+  std::unique_ptr<DiskManager> disk_manager_;
+  std::unique_ptr<BufferPoolManager> bpm_;
+  std::unique_ptr<CatalogManager> catalog_;
+};
+
+// 解析一条 SELECT，语句归 parser 所有
+inline const hsql::SelectStatement* ParseSelect(SQLParser* parser,
+                                               const std::string& sql) {
+  if (!parser->Parse(sql) || parser->GetResult().getStatements().empty() ||
+      parser->GetResult().getStatements()[0]->type() != hsql::kStmtSelect) {
+    throw Exception(ExceptionType::EXECUTION, "cannot parse: " + sql);
+  }
+  return static_cast<const hsql::SelectStatement*>(
+      parser->GetResult().getStatements()[0]);
+}
+
+// 跑 reps 次取最快的一次 (毫秒)
+template <typename Func>
+double BestOfMs(int reps, Func&& func) {
+  double best = 1e300;
+  for (int i = 0; i < reps; i++) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+}  // namespace bustub
@@ -0,0 +1,130 @@
+// 按 morsel 并行的 "扫描 -> 过滤 -> 分组聚合"：不同线程数下的耗时和加速比
+// 用法: parallel_aggregate_benchmark [行数，默认 1000000]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "common/thread_pool.h"
+#include "execution/aggregation_executor.h"
+#include "execution/execution_context.h"
+#include "execution/filter_executor.h"
+#include "execution/table_scan_executor.h"
+#include "storage/table/table_heap.h"
+
+using namespace bustub;
+
+namespace {
+
+// g INT (1000 个分组), a INT, b BIGINT, c DOUBLE
+TableInfo* CreateTable(CatalogManager* catalog, int rows) {
+  std::vector<Column> columns;
+  columns.emplace_back("g", TypeId::INTEGER);
+  columns.emplace_back("a", TypeId::INTEGER);
+  columns.emplace_back("b", TypeId::BIGINT);
+  columns.emplace_back("c", TypeId::DOUBLE);
+  TableInfo* info =
+      catalog->CreateTable("t", Schema("t", columns), TableLayout::ROW);
+  auto schema = const_cast<Schema*>(&info->GetSchema());
+  TableHeap heap(catalog->GetBPM(), info->GetId(), schema,
+                 info->GetDirectoryPageId(), info->GetStats());
+  std::vector<Value> values;
+  for (int r = 0; r < rows; r++) {
+    uint32_t hash = static_cast<uint32_t>(r) * 2654435761u;
+    values.clear();
+    values.emplace_back(static_cast<int32_t>(hash % 1000));
+    values.emplace_back(static_cast<int32_t>(r % 100));
+    values.emplace_back(TypeId::BIGINT, static_cast<int64_t>(hash % 100000));
+    values.emplace_back(static_cast<double>(hash % 1000) / 8);
+    heap.InsertTuple(Tuple(values, schema));
+  }
+  return info;
+}
+
+// 和 SELECT 的计划一样：聚合的子执行器是串行的流水线，并行时每个线程用 factory 另建一份。
+// 返回排好序的结果行，用来和单线程的结果比较
+std::vector<std::string> RunQuery(CatalogManager* catalog, TableInfo* info,
+                                  const hsql::SelectStatement* select,
+                                  ThreadPool* pool) {
+  ExecutionContext exec_ctx(catalog);
+  exec_ctx.thread_pool_ = pool;
+  const Schema* schema = &info->GetSchema();
+  table_id_t table_id = info->GetId();
+  hsql::Expr* where = select->whereClause;
+  auto make_pipeline = [table_id, where, schema](TableScanExecutor** scan) {
+    auto scan_exec = std::make_unique<TableScanExecutor>(table_id);
+    if (scan != nullptr) *scan = scan_exec.get();
+    std::unique_ptr<Executor> pipeline = std::move(scan_exec);
+    if (where != nullptr) {
+      pipeline = std::make_unique<FilterExecutor>(std::move(pipeline), where,
+                                                  schema);
+    }
+    return pipeline;
+  };
+  auto aggregation = std::make_unique<AggregationExecutor>(
+      make_pipeline(nullptr), *select->selectList,
+      select->groupBy != nullptr ? select->groupBy->columns : nullptr,
+      schema);
+  aggregation->SetParallelSource(make_pipeline);
+  aggregation->Init(&exec_ctx);
+
+  const Schema& output_schema = aggregation->GetOutputSchema();
+  std::vector<std::string> rows;
+  Tuple tuple;
+  while (aggregation->Next(&tuple)) {
+    std::string row;
+    for (uint32_t i = 0; i < output_schema.GetColumnCount(); i++) {
+      row += tuple.GetValue(&output_schema, i).ToString() + "|";
+    }
+    rows.push_back(std::move(row));
+  }
+  std::sort(rows.begin(), rows.end());
+  return rows;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int rows = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  BenchDatabase db("parallel_aggregate_benchmark_db");
+  CatalogManager* catalog = db.GetCatalog();
+  TableInfo* table = CreateTable(catalog, rows);
+  std::printf("%d rows, %zu pages, %u hardware threads\n", rows,
+              table->GetStats()->page_count_,
+              std::thread::hardware_concurrency());
+
+  const char* queries[] = {
+      "SELECT g, COUNT(*), SUM(b) FROM t WHERE a < 50 GROUP BY g",
+      "SELECT g, SUM(b), MIN(c), MAX(c) FROM t WHERE b >= 20000 GROUP BY g",
+      "SELECT COUNT(*), SUM(b) FROM t WHERE a < 10",
+  };
+  const uint32_t dops[] = {1, 2, 4, 8};
+  for (const char* sql : queries) {
+    SQLParser parser;
+    const hsql::SelectStatement* select = ParseSelect(&parser, sql);
+    std::printf("%s\n  %-4s %10s %8s\n", sql, "dop", "ms", "speedup");
+    std::vector<std::string> expected;
+    double serial_ms = 0;
+    for (uint32_t dop : dops) {
+      ThreadPool pool(dop);
+      std::vector<std::string> out;
+      double ms = BestOfMs(3, [&] {
+        out = RunQuery(catalog, table, select, &pool);
+      });
+      if (dop == 1) {
+        expected = out;
+        serial_ms = ms;
+      } else if (out != expected) {
+        std::printf("  dop %u: result differs from dop 1\n", dop);
+        return 1;
+      }
+      std::printf("  %-4u %10.1f %7.2fx\n", dop, ms, serial_ms / ms);
+    }
+  }
+  return 0;
+}
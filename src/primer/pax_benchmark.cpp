@@ -0,0 +1,124 @@
+// 行存和 PAX 布局在单列过滤、单列聚合上的对比
+// 用法: pax_benchmark [行数，默认 1000000]
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "execution/aggregation_executor.h"
+#include "execution/data_chunk.h"
+#include "execution/execution_context.h"
+#include "execution/filter_executor.h"
+#include "execution/projection_executor.h"
+#include "execution/table_scan_executor.h"
+#include "storage/table/table_heap.h"
+
+using namespace bustub;
+
+namespace {
+
+constexpr uint32_t NUM_COLUMNS = 8;
+
+TableInfo* CreateTable(CatalogManager* catalog, const std::string& name,
+                       TableLayout layout, int rows) {
+  std::vector<Column> columns;
+  for (uint32_t i = 0; i < NUM_COLUMNS; i++) {
+    columns.emplace_back("c" + std::to_string(i), TypeId::INTEGER);
+  }
+  TableInfo* info = catalog->CreateTable(name, Schema(name, columns), layout);
+  auto schema = const_cast<Schema*>(&info->GetSchema());
+  TableHeap heap(catalog->GetBPM(), info->GetId(), schema,
+                 info->GetDirectoryPageId(), info->GetStats());
+  std::vector<Value> values;
+  for (int r = 0; r < rows; r++) {
+    values.clear();
+    for (uint32_t i = 0; i < NUM_COLUMNS; i++) {
+      // 每列各自打散到 [0, 1000)
+      uint32_t hash = (static_cast<uint32_t>(r) + i * 7919u) * 2654435761u;
+      values.emplace_back(static_cast<int32_t>(hash % 1000));
+    }
+    heap.InsertTuple(Tuple(values, schema));
+  }
+  return info;
+}
+
+// 跑一条 "扫描 -> [过滤] -> 投影 / 聚合"，返回输出行数
+uint64_t RunQuery(CatalogManager* catalog, TableInfo* info,
+                  const hsql::SelectStatement* select) {
+  ExecutionContext exec_ctx(catalog);
+  const Schema* schema = &info->GetSchema();
+  std::unique_ptr<Executor> exec =
+      std::make_unique<TableScanExecutor>(info->GetId());
+  if (select->whereClause != nullptr) {
+    exec = std::make_unique<FilterExecutor>(std::move(exec),
+                                            select->whereClause, schema);
+  }
+  if (AggregationExecutor::HasAggregate(*select->selectList)) {
+    exec = std::make_unique<AggregationExecutor>(
+        std::move(exec), *select->selectList, nullptr, schema);
+  } else {
+    exec = std::make_unique<ProjectionExecutor>(std::move(exec),
+                                                *select->selectList, schema);
+  }
+  exec->Init(&exec_ctx);
+  uint64_t rows = 0;
+  Tuple tuple;
+  if (AggregationExecutor::HasAggregate(*select->selectList)) {
+    while (exec->Next(&tuple)) rows++;
+    return rows;
+  }
+  const Schema& output_schema =
+      static_cast<ProjectionExecutor*>(exec.get())->GetOutputSchema();
+  DataChunk chunk(&output_schema);
+  while (exec->NextBatch(&chunk)) {
+    rows += chunk.GetSelectedCount();
+  }
+  return rows;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int rows = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  BenchDatabase db("pax_benchmark_db");
+  CatalogManager* catalog = db.GetCatalog();
+  TableInfo* row_table = CreateTable(catalog, "row_t", TableLayout::ROW, rows);
+  TableInfo* pax_table = CreateTable(catalog, "pax_t", TableLayout::PAX, rows);
+  std::printf("%d rows x %u INTEGER columns: row %zu pages, pax %zu pages\n",
+              rows, NUM_COLUMNS, row_table->GetStats()->page_count_,
+              pax_table->GetStats()->page_count_);
+
+  const char* queries[] = {
+      "SELECT c0 FROM t WHERE c3 < 10",
+      "SELECT c0 FROM t WHERE c3 < 100",
+      "SELECT c0 FROM t WHERE c3 < 500",
+      "SELECT SUM(c5) FROM t",
+      "SELECT SUM(c5) FROM t WHERE c3 < 100",
+  };
+  std::printf("%-40s %12s %12s %8s\n", "query (best of 3)", "row ms", "pax ms",
+              "speedup");
+  for (const char* sql : queries) {
+    SQLParser parser;
+    const hsql::SelectStatement* select = ParseSelect(&parser, sql);
+    uint64_t row_out = 0;
+    uint64_t pax_out = 0;
+    double row_ms = BestOfMs(3, [&] {
+      row_out = RunQuery(catalog, row_table, select);
+    });
+    double pax_ms = BestOfMs(3, [&] {
+      pax_out = RunQuery(catalog, pax_table, select);
+    });
+    if (row_out != pax_out) {
+      std::printf("%s: row layout returned %llu rows, pax %llu\n", sql,
+                  static_cast<unsigned long long>(row_out),
+                  static_cast<unsigned long long>(pax_out));
+      return 1;
+    }
+    std::printf("%-40s %12.1f %12.1f %7.2fx\n", sql, row_ms, pax_ms,
+                row_ms / pax_ms);
+  }
+  return 0;
+}
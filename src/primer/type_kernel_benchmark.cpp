@@ -0,0 +1,97 @@
+// 比较一次 "值 < 常量" 的开销：Type 单例的虚函数、Value::CompareLessThan、
+// 计划阶段选定的 ValueKernels 函数指针、编译期已知类型的 TypeKernel
+// 用法: type_kernel_benchmark [值的个数，默认 65536] [遍数，默认 50]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "type/type.h"
+#include "type/type_kernels.h"
+#include "type/value.h"
+
+using namespace bustub;
+
+namespace {
+
+// 每种方式跑 passes 遍，打印每次比较的纳秒数；四种方式的匹配数必须一致
+template <TypeId type_id>
+bool Run(const char* name, const std::vector<Value>& values,
+         const Value& constant, int passes) {
+  auto per_compare = [&](double ms) {
+    return ms * 1e6 / (static_cast<double>(values.size()) * passes);
+  };
+  uint64_t matches[4] = {0, 0, 0, 0};
+
+  double virtual_ms = BestOfMs(3, [&] {
+    matches[0] = 0;
+    for (int p = 0; p < passes; p++) {
+      for (const Value& val : values) {
+        matches[0] += Type::GetInstance(val.GetTypeId())
+                          ->CompareLessThan(val, constant);
+      }
+    }
+  });
+  double value_ms = BestOfMs(3, [&] {
+    matches[1] = 0;
+    for (int p = 0; p < passes; p++) {
+      for (const Value& val : values) {
+        matches[1] += val.CompareLessThan(constant);
+      }
+    }
+  });
+  const ValueKernels* kernels = ValueKernels::Get(type_id);
+  double pointer_ms = BestOfMs(3, [&] {
+    matches[2] = 0;
+    for (int p = 0; p < passes; p++) {
+      for (const Value& val : values) {
+        matches[2] += kernels->less_than_(val, constant);
+      }
+    }
+  });
+  double kernel_ms = BestOfMs(3, [&] {
+    matches[3] = 0;
+    for (int p = 0; p < passes; p++) {
+      for (const Value& val : values) {
+        matches[3] += TypeKernel<type_id>::LessThan(val, constant);
+      }
+    }
+  });
+
+  if (matches[1] != matches[0] || matches[2] != matches[0] ||
+      matches[3] != matches[0]) {
+    std::printf("%s: results differ\n", name);
+    return false;
+  }
+  std::printf("%-8s %20.2f %16.2f %12.2f %12.2f\n", name,
+              per_compare(virtual_ms), per_compare(value_ms),
+              per_compare(pointer_ms), per_compare(kernel_ms));
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int count = argc > 1 ? std::atoi(argv[1]) : 65536;
+  int passes = argc > 2 ? std::atoi(argv[2]) : 50;
+
+  std::vector<Value> integers;
+  std::vector<Value> varchars;
+  for (int i = 0; i < count; i++) {
+    auto hash = static_cast<uint32_t>(i) * 2654435761u;
+    integers.emplace_back(static_cast<int32_t>(hash % 100000));
+    varchars.emplace_back("key_" + std::to_string(hash % 100000));
+  }
+
+  std::printf("%d values x %d passes, ns per LessThan against a constant\n",
+              count, passes);
+  std::printf("%-8s %20s %16s %12s %12s\n", "type", "GetInstance+virtual",
+              "Value::Compare", "kernel ptr", "TypeKernel");
+  bool ok = Run<TypeId::INTEGER>("INTEGER", integers, Value(50000), passes) &&
+            Run<TypeId::VARCHAR>("VARCHAR", varchars, Value(std::string("key_50000")),
+                                 passes);
+  return ok ? 0 : 1;
+}
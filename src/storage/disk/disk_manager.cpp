@@ -18,6 +18,8 @@ DiskManager::DiskManager(const std::filesystem::path& data_dir)
     if (!std::filesystem::exists(data_dir)) {
       std::filesystem::create_directories(data_dir);
     }
+    // temp files left by a crashed process
+    std::filesystem::remove_all(data_dir_ + "/tmp");
   } catch (const std::exception& e) {
     std::cerr << e.what() << std::endl;
     throw Exception("Failed to create data directory.");
@@ -31,6 +33,11 @@ DiskManager::~DiskManager() {
       file.close();
     }
   }
+  for (auto& [file_id, file] : temp_files_) {
+    file.close();
+  }
+  std::error_code ec;
+  std::filesystem::remove_all(data_dir_ + "/tmp", ec);
 }
 
 std::string DiskManager::GetTableFilePath(table_id_t table_id,
@@ -150,4 +157,64 @@ void DiskManager::WritePage(table_id_t table_id, page_id_t page_id,
   file.flush();
 }
 
-}  // namespace bustub
\ No newline at end of file
+uint32_t DiskManager::CreateTempFile() {
+  std::lock_guard<std::mutex> guard(temp_latch_);
+  uint32_t file_id = next_temp_id_++;
+  std::string dir = data_dir_ + "/tmp";
+  std::filesystem::create_directories(dir);
+  std::string file_path = dir + "/spill_" + std::to_string(file_id) + ".tmp";
+  std::fstream& file = temp_files_[file_id];
+  file.open(file_path, std::ios::binary | std::ios::in | std::ios::out |
+                           std::ios::trunc);
+  if (!file.is_open()) {
+    temp_files_.erase(file_id);
+    throw Exception(ExceptionType::EXECUTION,
+                    "cannot create temp file " + file_path);
+  }
+  return file_id;
+}
+
+std::fstream& DiskManager::GetTempFile(uint32_t file_id) {
+  std::lock_guard<std::mutex> guard(temp_latch_);
+  auto it = temp_files_.find(file_id);
+  if (it == temp_files_.end()) {
+    throw Exception("Temp file not open: " + std::to_string(file_id));
+  }
+  // unordered_map 的节点地址在插入/删除别的元素时不变
+  return it->second;
+}
+
+void DiskManager::WriteTempPage(uint32_t file_id, std::size_t page_no,
+                                const char* page_data) {
+  std::fstream& file = GetTempFile(file_id);
+  file.seekp(page_no * PAGE_SIZE);
+  file.write(page_data, PAGE_SIZE);
+  if (!file) {
+    file.clear();
+    throw Exception(ExceptionType::EXECUTION, "failed to write temp file");
+  }
+}
+
+void DiskManager::ReadTempPage(uint32_t file_id, std::size_t page_no,
+                               char* page_data) {
+  std::fstream& file = GetTempFile(file_id);
+  file.seekg(page_no * PAGE_SIZE);
+  file.read(page_data, PAGE_SIZE);
+  if (!file) {
+    file.clear();
+    throw Exception(ExceptionType::EXECUTION, "failed to read temp file");
+  }
+}
+
+void DiskManager::DeleteTempFile(uint32_t file_id) {
+  std::lock_guard<std::mutex> guard(temp_latch_);
+  auto it = temp_files_.find(file_id);
+  if (it == temp_files_.end()) return;
+  it->second.close();
+  temp_files_.erase(it);
+  std::error_code ec;
+  std::filesystem::remove(
+      data_dir_ + "/tmp/spill_" + std::to_string(file_id) + ".tmp", ec);
+}
+
+}  // namespace bustub
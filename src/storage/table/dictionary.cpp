@@ -0,0 +1,207 @@
+#include "storage/table/dictionary.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/exception.h"
+#include "storage/table/dictionary_page.h"
+
+namespace bustub {
+
+auto Dictionary::Attach(BufferPoolManager* bpm, table_id_t table_id) -> bool {
+  std::unique_lock<std::shared_mutex> guard(latch_);
+  if (first_page_id_ == INVALID_PAGE_ID) {
+    page_id_t page_id;
+    auto page = static_cast<DictionaryPage*>(bpm->NewPage(table_id, &page_id));
+    if (page == nullptr) {
+      return false;
+    }
+    page->Init(page_id);
+    bpm->FlushPage(table_id, page_id);
+    bpm->UnpinPage(table_id, page_id, false);
+    bpm_ = bpm;
+    table_id_ = table_id;
+    first_page_id_ = page_id;
+    last_page_id_ = page_id;
+    return std::all_of(values_.begin(), values_.end(),
+                       [this](const std::string& value) {
+                         return Persist(value);
+                       });
+  }
+
+  // 读出整条链再按顺序切出条目 (条目可能跨页)
+  std::string log;
+  std::vector<std::pair<page_id_t, uint32_t>> pages;  // 每页的 id 和数据量
+  page_id_t page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page =
+        static_cast<DictionaryPage*>(bpm->FetchPage(table_id, page_id));
+    if (page == nullptr) {
+      return false;
+    }
+    uint32_t size = std::min(page->GetDataSize(), DictionaryPage::CAPACITY);
+    log.append(page->GetPayload(), size);
+    pages.emplace_back(page_id, size);
+    page_id_t next_page_id = page->GetNextPageId();
+    bpm->UnpinPage(table_id, page_id, false);
+    page_id = next_page_id;
+  }
+
+  values_.clear();
+  index_.clear();
+  std::size_t pos = 0;
+  while (pos + sizeof(uint32_t) <= log.size()) {
+    uint32_t len;
+    std::memcpy(&len, log.data() + pos, sizeof(len));
+    if (len > log.size() - pos - sizeof(len)) {
+      break;
+    }
+    auto code = static_cast<uint32_t>(values_.size());
+    values_.emplace_back(log, pos + sizeof(len), len);
+    index_.emplace(values_.back(), code);
+    pos += sizeof(len) + len;
+  }
+
+  // 链尾停在最后一个完整条目之后：写到一半的条目 (崩溃时) 没有数据页用到，
+  // 截掉它，后面追加的条目从这里接着写
+  std::size_t page_begin = 0;
+  for (std::size_t i = 0; i < pages.size(); i++) {
+    auto [id, size] = pages[i];
+    bool last = i + 1 == pages.size();
+    if (pos > page_begin + size || (pos == page_begin + size && !last)) {
+      page_begin += size;
+      continue;
+    }
+    if (pos < page_begin + size || !last) {
+      auto page = static_cast<DictionaryPage*>(bpm->FetchPage(table_id, id));
+      if (page == nullptr) {
+        return false;
+      }
+      page->Init(id);
+      page->Append(log.data() + page_begin,
+                   static_cast<uint32_t>(pos - page_begin));
+      bpm->FlushPage(table_id, id);
+      bpm->UnpinPage(table_id, id, false);
+    }
+    last_page_id_ = id;
+    break;
+  }
+  bpm_ = bpm;
+  table_id_ = table_id;
+  return true;
+}
+
+auto Dictionary::Persist(std::string_view entry) -> bool {
+  auto len = static_cast<uint32_t>(entry.size());
+  std::string record(sizeof(len), '\0');
+  std::memcpy(record.data(), &len, sizeof(len));
+  record.append(entry);
+
+  auto last = static_cast<DictionaryPage*>(
+      bpm_->FetchPage(table_id_, last_page_id_));
+  if (last == nullptr) {
+    return false;
+  }
+  // 先把需要的新页都分配好，失败时链尾还没有改动
+  auto size = static_cast<uint32_t>(record.size());
+  uint32_t room = DictionaryPage::CAPACITY - last->GetDataSize();
+  std::vector<std::pair<page_id_t, DictionaryPage*>> new_pages;
+  for (uint32_t need = size > room ? size - room : 0; need > 0;
+       need -= std::min(need, DictionaryPage::CAPACITY)) {
+    page_id_t page_id;
+    auto page =
+        static_cast<DictionaryPage*>(bpm_->NewPage(table_id_, &page_id));
+    if (page == nullptr) {
+      for (auto [id, unused] : new_pages) {
+        bpm_->UnpinPage(table_id_, id, false);
+        bpm_->DeletePage(table_id_, id);
+      }
+      bpm_->UnpinPage(table_id_, last_page_id_, false);
+      return false;
+    }
+    page->Init(page_id);
+    new_pages.emplace_back(page_id, page);
+  }
+
+  uint32_t written = last->Append(record.data(), size);
+  DictionaryPage* prev = last;
+  for (auto [id, page] : new_pages) {
+    prev->SetNextPageId(id);
+    written += page->Append(record.data() + written, size - written);
+    prev = page;
+  }
+  // 从后往前刷盘，原来的链尾最后写：它写盘之后新条目才接进链里。
+  // 刷完才 unpin，免得原来的链尾先被换出写盘
+  for (auto it = new_pages.rbegin(); it != new_pages.rend(); ++it) {
+    bpm_->FlushPage(table_id_, it->first);
+  }
+  bpm_->FlushPage(table_id_, last_page_id_);
+  bpm_->UnpinPage(table_id_, last_page_id_, false);
+  for (auto [id, unused] : new_pages) {
+    bpm_->UnpinPage(table_id_, id, false);
+  }
+  if (!new_pages.empty()) {
+    last_page_id_ = new_pages.back().first;
+  }
+  return true;
+}
+
+auto Dictionary::GetOrAdd(const char* data, uint32_t len) -> uint32_t {
+  std::string_view key(data, len);
+  {
+    std::shared_lock<std::shared_mutex> guard(latch_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      return it->second;
+    }
+  }
+  std::unique_lock<std::shared_mutex> guard(latch_);
+  // 拿写锁期间可能已被别的线程加进来
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    return it->second;
+  }
+  if (values_.size() >= INVALID_CODE) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "dictionary is full");
+  }
+  if (bpm_ != nullptr && !Persist(key)) {
+    throw Exception(ExceptionType::EXECUTION,
+                    "failed to write dictionary page");
+  }
+  auto code = static_cast<uint32_t>(values_.size());
+  values_.emplace_back(key);
+  index_.emplace(values_.back(), code);
+  return code;
+}
+
+auto Dictionary::Lookup(const char* data, uint32_t len, uint32_t* code) const
+    -> bool {
+  std::shared_lock<std::shared_mutex> guard(latch_);
+  auto it = index_.find(std::string_view(data, len));
+  if (it == index_.end()) {
+    return false;
+  }
+  *code = it->second;
+  return true;
+}
+
+auto Dictionary::Decode(uint32_t code) const -> std::string_view {
+  std::shared_lock<std::shared_mutex> guard(latch_);
+  if (code >= values_.size()) {
+    throw Exception(ExceptionType::OUT_OF_RANGE,
+                    "dictionary code " + std::to_string(code) +
+                        " out of range");
+  }
+  return values_[code];
+}
+
+auto Dictionary::Size() const -> uint32_t {
+  std::shared_lock<std::shared_mutex> guard(latch_);
+  return static_cast<uint32_t>(values_.size());
+}
+
+}  // namespace bustub
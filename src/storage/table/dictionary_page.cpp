@@ -0,0 +1,23 @@
+#include "storage/table/dictionary_page.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace bustub {
+
+auto DictionaryPage::Init(page_id_t page_id) -> void {
+  Header* header = GetHeader();
+  header->page_id_ = page_id;
+  header->next_page_id_ = INVALID_PAGE_ID;
+  header->data_size_ = 0;
+}
+
+auto DictionaryPage::Append(const char* data, uint32_t size) -> uint32_t {
+  Header* header = GetHeader();
+  uint32_t chunk = std::min(CAPACITY - header->data_size_, size);
+  std::memcpy(GetPayload() + header->data_size_, data, chunk);
+  header->data_size_ += chunk;
+  return chunk;
+}
+
+}  // namespace bustub
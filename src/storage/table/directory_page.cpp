@@ -0,0 +1,50 @@
+#include "storage/table/directory_page.h"
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+
+namespace bustub {
+
+auto DirectoryPage::Init(page_id_t page_id) -> void {
+  Header* header = GetHeader();
+  header->page_id_ = page_id;
+  header->next_page_id_ = INVALID_PAGE_ID;
+  header->entry_count_ = 0;
+  header->layout_ = TableLayout::ROW;
+}
+
+auto DirectoryPage::Append(page_id_t page_id) -> bool {
+  Header* header = GetHeader();
+  if (header->entry_count_ >= CAPACITY) return false;
+  GetEntries()[header->entry_count_++] = page_id;
+  return true;
+}
+
+auto DirectoryPage::LoadChain(BufferPoolManager* bpm, table_id_t table_id,
+                              page_id_t first_page_id,
+                              std::vector<page_id_t>* pages,
+                              page_id_t* last_page_id,
+                              TableLayout* layout) -> bool {
+  page_id_t page_id = first_page_id;
+  *last_page_id = INVALID_PAGE_ID;
+
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = static_cast<DirectoryPage*>(bpm->FetchPage(table_id, page_id));
+    if (page == nullptr) return false;
+    if (page_id == first_page_id) *layout = page->GetLayout();
+
+    uint32_t count = page->GetEntryCount();
+    pages->insert(pages->end(), page->GetEntries(),
+                  page->GetEntries() + count);
+
+    auto next_page_id = page->GetNextPageId();
+    bpm->UnpinPage(table_id, page_id, false);
+    *last_page_id = page_id;
+    page_id = next_page_id;
+  }
+  return true;
+}
+
+}  // namespace bustub
@@ -0,0 +1,90 @@
+#include "storage/table/overflow_page.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+
+namespace bustub {
+
+auto OverflowPage::Init(page_id_t page_id) -> void {
+  Header* header = GetHeader();
+  header->page_id_ = page_id;
+  header->next_page_id_ = INVALID_PAGE_ID;
+  header->data_size_ = 0;
+}
+
+auto OverflowPage::WriteChain(BufferPoolManager* bpm, table_id_t table_id,
+                              const char* data, uint32_t size) -> page_id_t {
+  page_id_t first_page_id = INVALID_PAGE_ID;
+  page_id_t prev_page_id = INVALID_PAGE_ID;
+  OverflowPage* prev_page = nullptr;
+  uint32_t written = 0;
+
+  do {
+    page_id_t page_id;
+    auto page = static_cast<OverflowPage*>(bpm->NewPage(table_id, &page_id));
+    if (page == nullptr) {
+      if (prev_page != nullptr) bpm->UnpinPage(table_id, prev_page_id, true);
+      FreeChain(bpm, table_id, first_page_id);
+      return INVALID_PAGE_ID;
+    }
+    page->Init(page_id);
+
+    // fill this segment
+    uint32_t chunk = std::min(CAPACITY, size - written);
+    std::memcpy(page->GetPayload(), data + written, chunk);
+    page->GetHeader()->data_size_ = chunk;
+    written += chunk;
+
+    // link from previous segment
+    if (prev_page != nullptr) {
+      prev_page->SetNextPageId(page_id);
+      bpm->UnpinPage(table_id, prev_page_id, true);
+    } else {
+      first_page_id = page_id;
+    }
+    prev_page = page;
+    prev_page_id = page_id;
+  } while (written < size);
+
+  bpm->UnpinPage(table_id, prev_page_id, true);
+  return first_page_id;
+}
+
+auto OverflowPage::ReadChain(BufferPoolManager* bpm, table_id_t table_id,
+                             page_id_t first_page_id, char* out,
+                             uint32_t size) -> bool {
+  page_id_t page_id = first_page_id;
+  uint32_t read = 0;
+
+  while (read < size && page_id != INVALID_PAGE_ID) {
+    auto page = static_cast<OverflowPage*>(bpm->FetchPage(table_id, page_id));
+    if (page == nullptr) return false;
+
+    uint32_t chunk = std::min(page->GetDataSize(), size - read);
+    std::memcpy(out + read, page->GetPayload(), chunk);
+    read += chunk;
+
+    auto next_page_id = page->GetNextPageId();
+    bpm->UnpinPage(table_id, page_id, false);
+    page_id = next_page_id;
+  }
+  return read == size;
+}
+
+auto OverflowPage::FreeChain(BufferPoolManager* bpm, table_id_t table_id,
+                             page_id_t first_page_id) -> void {
+  page_id_t page_id = first_page_id;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = static_cast<OverflowPage*>(bpm->FetchPage(table_id, page_id));
+    if (page == nullptr) return;
+    auto next_page_id = page->GetNextPageId();
+    bpm->UnpinPage(table_id, page_id, false);
+    bpm->DeletePage(table_id, page_id);
+    page_id = next_page_id;
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,223 @@
+#include "storage/table/pax_page.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "common/config.h"
+#include "common/rid.h"
+#include "storage/table/scan_predicate.h"
+
+namespace bustub {
+
+namespace {
+inline auto BitmapBytes(uint32_t bits) -> uint32_t { return (bits + 7) / 8; }
+inline auto Align4(uint32_t n) -> uint32_t { return (n + 3) & ~3U; }
+}  // namespace
+
+auto PaxPage::MinipageOffset(const Schema *schema, uint32_t col_idx,
+                             uint32_t capacity) -> uint32_t {
+  uint32_t bitmap = Align4(BitmapBytes(capacity));
+  uint32_t offset = Align4(sizeof(Header) + BitmapBytes(capacity));
+  for (uint32_t i = 0; i < col_idx; i++) {
+    uint32_t width = schema->GetColumn(i).GetFixedLength();
+    offset += bitmap + Align4(capacity * width);
+  }
+  return offset;
+}
+
+auto PaxPage::ComputeCapacity(const Schema *schema) -> uint32_t {
+  if (!schema->IsInlined() || schema->GetColumnCount() == 0) return 0;
+  // per row: fixed-width bytes + one live bit + one null bit per column
+  uint32_t num_col = schema->GetColumnCount();
+  uint32_t capacity = (PAGE_SIZE - sizeof(Header)) * 8 /
+                      (schema->GetStorageSize() * 8 + 1 + num_col);
+  // then shrink until the padding fits as well
+  while (capacity > 0 &&
+         MinipageOffset(schema, num_col, capacity) > PAGE_SIZE) {
+    capacity--;
+  }
+  return capacity;
+}
+
+auto PaxPage::Init(const Schema *schema, page_id_t page_id,
+                   page_id_t prev_page_id, page_id_t next_page_id) -> void {
+  Header *header = GetHeader();
+  header->page_id_ = page_id;
+  header->prev_page_id_ = prev_page_id;
+  header->next_page_id_ = next_page_id;
+  header->tuple_count_ = 0;
+  header->capacity_ = ComputeCapacity(schema);
+}
+
+auto PaxPage::IsLive(uint32_t slot_id) -> bool {
+  return slot_id < GetHeader()->tuple_count_ &&
+         (GetLiveBitmap()[slot_id >> 3] & (1 << (slot_id % 8)));
+}
+
+auto PaxPage::IsNull(const Schema *schema, uint32_t col_idx,
+                     uint32_t slot_id) -> bool {
+  const uint8_t *null_bitmap = reinterpret_cast<const uint8_t *>(
+      data_ + MinipageOffset(schema, col_idx, GetHeader()->capacity_));
+  return null_bitmap[slot_id >> 3] & (1 << (slot_id % 8));
+}
+
+auto PaxPage::GetColumnData(const Schema *schema,
+                            uint32_t col_idx) -> const char * {
+  uint32_t capacity = GetHeader()->capacity_;
+  return data_ + MinipageOffset(schema, col_idx, capacity) +
+         Align4(BitmapBytes(capacity));
+}
+
+auto PaxPage::InsertTuple(const Schema *schema, const Tuple &tuple) -> RID {
+  Header *header = GetHeader();
+  if (header->tuple_count_ >= header->capacity_) return RID();
+
+  uint32_t slot_id = header->tuple_count_++;
+  GetLiveBitmap()[slot_id >> 3] |= (1 << (slot_id % 8));
+  RID rid(page_id_, slot_id);
+  UpdateTuple(schema, tuple, rid);
+  return rid;
+}
+
+auto PaxPage::GetTuple(const Schema *schema, RID rid) -> Tuple {
+  if (!IsLive(rid.GetSlotId())) return Tuple();
+
+  // rebuild the row format: | null bitmap | fixed-width section |
+  uint32_t num_col = schema->GetColumnCount();
+  uint32_t bitmap_size = BitmapBytes(num_col);
+  std::vector<char> row(bitmap_size + schema->GetStorageSize(), 0);
+  for (uint32_t i = 0; i < num_col; i++) {
+    const Column &col = schema->GetColumn(i);
+    if (IsNull(schema, i, rid.GetSlotId())) {
+      row[i >> 3] |= (1 << (i % 8));
+      continue;
+    }
+    std::memcpy(row.data() + bitmap_size + col.GetOffset(),
+                GetColumnData(schema, i) +
+                    rid.GetSlotId() * col.GetFixedLength(),
+                col.GetFixedLength());
+  }
+  return Tuple(rid, row.data(), row.size());
+}
+
+auto PaxPage::CollectTuples(const Schema *schema, std::vector<Tuple> *out,
+                            const ScanPredicate *predicate) -> void {
+  uint32_t num_col = schema->GetColumnCount();
+  uint32_t bitmap_size = BitmapBytes(num_col);
+  uint32_t row_size = bitmap_size + schema->GetStorageSize();
+  uint32_t capacity = GetHeader()->capacity_;
+  uint32_t tuple_count = GetHeader()->tuple_count_;
+
+  // the predicate column's minipage is already a contiguous array: compare
+  // in place, then AND with the live bitmap below
+  std::vector<uint64_t> match;
+  if (predicate != nullptr) {
+    uint32_t col_idx = predicate->GetColumnIndex();
+    match.resize((tuple_count + 63) / 64);
+    predicate->Evaluate(
+        GetColumnData(schema, col_idx),
+        reinterpret_cast<const uint8_t *>(
+            data_ + MinipageOffset(schema, col_idx, capacity)),
+        tuple_count, match.data());
+  }
+
+  std::vector<uint32_t> live;
+  live.reserve(tuple_count);
+  for (uint32_t slot_id = 0; slot_id < tuple_count; slot_id++) {
+    if (predicate != nullptr &&
+        !(match[slot_id >> 6] & (uint64_t{1} << (slot_id & 63)))) {
+      continue;
+    }
+    if (GetLiveBitmap()[slot_id >> 3] & (1 << (slot_id % 8))) {
+      live.push_back(slot_id);
+    }
+  }
+
+  // rebuild rows column by column, each minipage is read sequentially
+  std::vector<char> rows(live.size() * row_size, 0);
+  uint32_t values_offset = Align4(BitmapBytes(capacity));
+  for (uint32_t i = 0; i < num_col; i++) {
+    const Column &col = schema->GetColumn(i);
+    uint32_t width = col.GetFixedLength();
+    const char *minipage = data_ + MinipageOffset(schema, i, capacity);
+    const char *values = minipage + values_offset;
+    for (std::size_t r = 0; r < live.size(); r++) {
+      uint32_t slot_id = live[r];
+      char *row = rows.data() + r * row_size;
+      if (minipage[slot_id >> 3] & (1 << (slot_id % 8))) {
+        row[i >> 3] |= (1 << (i % 8));
+      } else if (width == sizeof(int32_t)) {
+        std::memcpy(row + bitmap_size + col.GetOffset(),
+                    values + slot_id * sizeof(int32_t), sizeof(int32_t));
+      } else if (width == sizeof(int64_t)) {
+        std::memcpy(row + bitmap_size + col.GetOffset(),
+                    values + slot_id * sizeof(int64_t), sizeof(int64_t));
+      } else {
+        std::memcpy(row + bitmap_size + col.GetOffset(),
+                    values + slot_id * width, width);
+      }
+    }
+  }
+
+  out->reserve(out->size() + live.size());
+  for (std::size_t r = 0; r < live.size(); r++) {
+    out->emplace_back(RID(page_id_, live[r]), rows.data() + r * row_size,
+                      row_size);
+  }
+}
+
+auto PaxPage::MarkDeleted(RID rid) -> bool {
+  if (!IsLive(rid.GetSlotId())) return false;
+  GetLiveBitmap()[rid.GetSlotId() >> 3] &= ~(1 << (rid.GetSlotId() % 8));
+  return true;
+}
+
+auto PaxPage::UpdateTuple(const Schema *schema, const Tuple &new_tuple,
+                          RID rid) -> bool {
+  uint32_t slot_id = rid.GetSlotId();
+  if (rid.GetPageId() != page_id_ || !IsLive(slot_id)) return false;
+
+  // scatter the row into the minipages, always in place (fixed width)
+  uint32_t num_col = schema->GetColumnCount();
+  uint32_t bitmap_size = BitmapBytes(num_col);
+  uint32_t capacity = GetHeader()->capacity_;
+  const char *row = new_tuple.GetData();
+  for (uint32_t i = 0; i < num_col; i++) {
+    const Column &col = schema->GetColumn(i);
+    char *minipage = data_ + MinipageOffset(schema, i, capacity);
+    auto *null_bitmap = reinterpret_cast<uint8_t *>(minipage);
+    if (row[i >> 3] & (1 << (i % 8))) {
+      null_bitmap[slot_id >> 3] |= (1 << (slot_id % 8));
+      continue;
+    }
+    null_bitmap[slot_id >> 3] &= ~(1 << (slot_id % 8));
+    std::memcpy(minipage + Align4(BitmapBytes(capacity)) +
+                    slot_id * col.GetFixedLength(),
+                row + bitmap_size + col.GetOffset(), col.GetFixedLength());
+  }
+  return true;
+}
+
+auto PaxPage::UpdateColumns(const Schema *schema, RID rid,
+                            const std::vector<uint32_t> &cols,
+                            const std::vector<Value> &values) -> bool {
+  uint32_t slot_id = rid.GetSlotId();
+  if (rid.GetPageId() != page_id_ || !IsLive(slot_id)) return false;
+  uint32_t capacity = GetHeader()->capacity_;
+  for (std::size_t i = 0; i < cols.size(); i++) {
+    const Column &col = schema->GetColumn(cols[i]);
+    char *minipage = data_ + MinipageOffset(schema, cols[i], capacity);
+    auto *null_bitmap = reinterpret_cast<uint8_t *>(minipage);
+    if (values[i].IsNull()) {
+      null_bitmap[slot_id >> 3] |= (1 << (slot_id % 8));
+      continue;
+    }
+    null_bitmap[slot_id >> 3] &= ~(1 << (slot_id % 8));
+    values[i].SerializeTo(minipage + Align4(BitmapBytes(capacity)) +
+                          slot_id * col.GetFixedLength());
+  }
+  return true;
+}
+
+}  // namespace bustub
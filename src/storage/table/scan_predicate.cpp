@@ -0,0 +1,235 @@
+#include "storage/table/scan_predicate.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace bustub {
+
+namespace {
+
+// 六种比较都归结为 "== 或 >"，再决定是否交换两边、结果是否取反：
+// EQ: v == c   NE: !(v == c)   GT: v > c   LE: !(v > c)   LT: c > v   GE: !(c > v)
+struct CompareMode {
+  bool eq_;
+  bool swap_;
+  bool invert_;
+};
+
+auto GetCompareMode(CompareOp op) -> CompareMode {
+  switch (op) {
+    case CompareOp::EQ:
+      return {true, false, false};
+    case CompareOp::NE:
+      return {true, false, true};
+    case CompareOp::GT:
+      return {false, false, false};
+    case CompareOp::LE:
+      return {false, false, true};
+    case CompareOp::LT:
+      return {false, true, false};
+    case CompareOp::GE:
+      return {false, true, true};
+  }
+  return {true, false, false};
+}
+
+template <typename T>
+auto CompareOne(T v, T c, CompareMode mode) -> bool {
+  bool r = mode.eq_ ? v == c : (mode.swap_ ? c > v : v > c);
+  return r != mode.invert_;
+}
+
+// 从 begin 开始的标量循环，SIMD 内核用它处理尾部
+template <typename T>
+auto CompareScalar(const char *values, uint32_t begin, uint32_t count, T c,
+                   CompareMode mode, uint64_t *match) -> void {
+  for (uint32_t i = begin; i < count; i++) {
+    T v;
+    std::memcpy(&v, values + static_cast<std::size_t>(i) * sizeof(T),
+                sizeof(T));
+    if (CompareOne(v, c, mode)) {
+      match[i >> 6] |= uint64_t{1} << (i & 63);
+    }
+  }
+}
+
+#if defined(__x86_64__)
+// 每次比较的 lane 数整除 64，一次的结果不会跨 match 的字
+
+__attribute__((target("avx2"))) auto CompareInt32Avx2(
+    const char *values, uint32_t count, int32_t c, CompareMode mode,
+    uint64_t *match) -> void {
+  const __m256i vc = _mm256_set1_epi32(c);
+  const uint64_t flip = mode.invert_ ? 0xFF : 0;
+  uint32_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(values + i * sizeof(int32_t)));
+    __m256i m = mode.eq_     ? _mm256_cmpeq_epi32(v, vc)
+                : mode.swap_ ? _mm256_cmpgt_epi32(vc, v)
+                             : _mm256_cmpgt_epi32(v, vc);
+    auto bits = static_cast<uint64_t>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(m)));
+    match[i >> 6] |= (bits ^ flip) << (i & 63);
+  }
+  CompareScalar<int32_t>(values, i, count, c, mode, match);
+}
+
+__attribute__((target("avx2"))) auto CompareInt64Avx2(
+    const char *values, uint32_t count, int64_t c, CompareMode mode,
+    uint64_t *match) -> void {
+  const __m256i vc = _mm256_set1_epi64x(c);
+  const uint64_t flip = mode.invert_ ? 0xF : 0;
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(values + i * sizeof(int64_t)));
+    __m256i m = mode.eq_     ? _mm256_cmpeq_epi64(v, vc)
+                : mode.swap_ ? _mm256_cmpgt_epi64(vc, v)
+                             : _mm256_cmpgt_epi64(v, vc);
+    auto bits = static_cast<uint64_t>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(m)));
+    match[i >> 6] |= (bits ^ flip) << (i & 63);
+  }
+  CompareScalar<int64_t>(values, i, count, c, mode, match);
+}
+
+// int32 比较 SSE2 就有，int64 的 _mm_cmpgt_epi64 要 SSE4.2
+__attribute__((target("sse4.2"))) auto CompareInt32Sse42(
+    const char *values, uint32_t count, int32_t c, CompareMode mode,
+    uint64_t *match) -> void {
+  const __m128i vc = _mm_set1_epi32(c);
+  const uint64_t flip = mode.invert_ ? 0xF : 0;
+  uint32_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(values + i * sizeof(int32_t)));
+    __m128i m = mode.eq_     ? _mm_cmpeq_epi32(v, vc)
+                : mode.swap_ ? _mm_cmpgt_epi32(vc, v)
+                             : _mm_cmpgt_epi32(v, vc);
+    auto bits = static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(m)));
+    match[i >> 6] |= (bits ^ flip) << (i & 63);
+  }
+  CompareScalar<int32_t>(values, i, count, c, mode, match);
+}
+
+__attribute__((target("sse4.2"))) auto CompareInt64Sse42(
+    const char *values, uint32_t count, int64_t c, CompareMode mode,
+    uint64_t *match) -> void {
+  const __m128i vc = _mm_set1_epi64x(c);
+  const uint64_t flip = mode.invert_ ? 0x3 : 0;
+  uint32_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(values + i * sizeof(int64_t)));
+    __m128i m = mode.eq_     ? _mm_cmpeq_epi64(v, vc)
+                : mode.swap_ ? _mm_cmpgt_epi64(vc, v)
+                             : _mm_cmpgt_epi64(v, vc);
+    auto bits = static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(m)));
+    match[i >> 6] |= (bits ^ flip) << (i & 63);
+  }
+  CompareScalar<int64_t>(values, i, count, c, mode, match);
+}
+#endif
+
+}  // namespace
+
+auto ScanPredicate::Supports(const Column &col, CompareOp op) -> bool {
+  if (col.IsDictEncoded()) {
+    return op == CompareOp::EQ || op == CompareOp::NE;
+  }
+  switch (col.GetType()) {
+    case TypeId::INTEGER:
+    case TypeId::DATE:
+    case TypeId::BIGINT:
+    case TypeId::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+auto ScanPredicate::DetectSimdLevel() -> SimdLevel {
+#if defined(__x86_64__)
+  static const SimdLevel level = [] {
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse4.2")) return SimdLevel::SSE42;
+    return SimdLevel::SCALAR;
+  }();
+  return level;
+#else
+  return SimdLevel::SCALAR;
+#endif
+}
+
+ScanPredicate::ScanPredicate(const Schema *schema, uint32_t col_idx,
+                             CompareOp op, int64_t constant)
+    : col_idx_(col_idx),
+      op_(op),
+      constant_(constant),
+      width_(schema->GetColumn(col_idx).GetFixedLength()),
+      value_offset_((schema->GetColumnCount() + 7) / 8 +
+                    schema->GetColOffset(col_idx)),
+      level_(DetectSimdLevel()) {}
+
+auto ScanPredicate::SetSimdLevel(SimdLevel level) -> void {
+  level_ = level <= DetectSimdLevel() ? level : DetectSimdLevel();
+}
+
+auto ScanPredicate::Evaluate(const char *values, const uint8_t *nulls,
+                             uint32_t count, uint64_t *match) const -> void {
+  uint32_t words = (count + 63) / 64;
+  std::memset(match, 0, words * sizeof(uint64_t));
+  CompareMode mode = GetCompareMode(op_);
+  if (width_ == sizeof(int32_t)) {
+    auto c = static_cast<int32_t>(constant_);
+#if defined(__x86_64__)
+    if (level_ == SimdLevel::AVX2) {
+      CompareInt32Avx2(values, count, c, mode, match);
+    } else if (level_ == SimdLevel::SSE42) {
+      CompareInt32Sse42(values, count, c, mode, match);
+    } else {
+      CompareScalar<int32_t>(values, 0, count, c, mode, match);
+    }
+#else
+    CompareScalar<int32_t>(values, 0, count, c, mode, match);
+#endif
+  } else {
+#if defined(__x86_64__)
+    if (level_ == SimdLevel::AVX2) {
+      CompareInt64Avx2(values, count, constant_, mode, match);
+    } else if (level_ == SimdLevel::SSE42) {
+      CompareInt64Sse42(values, count, constant_, mode, match);
+    } else {
+      CompareScalar<int64_t>(values, 0, count, constant_, mode, match);
+    }
+#else
+    CompareScalar<int64_t>(values, 0, count, constant_, mode, match);
+#endif
+  }
+
+  // NULL 不满足任何比较
+  if (nulls != nullptr) {
+    for (uint32_t w = 0; w < words; w++) {
+      uint64_t null_word = 0;
+      uint32_t bytes = std::min<uint32_t>(8, (count - w * 64 + 7) / 8);
+      for (uint32_t b = 0; b < bytes; b++) {
+        null_word |= static_cast<uint64_t>(nulls[w * 8 + b]) << (b * 8);
+      }
+      match[w] &= ~null_word;
+    }
+  }
+}
+
+auto ScanPredicate::Matches(const char *tuple_data) const -> bool {
+  if (tuple_data[col_idx_ >> 3] & (1 << (col_idx_ % 8))) return false;
+  uint64_t match;
+  Evaluate(tuple_data + value_offset_, nullptr, 1, &match);
+  return match != 0;
+}
+
+}  // namespace bustub
@@ -1,10 +1,19 @@
 #include "storage/table/table_heap.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "common/config.h"
 #include "common/rid.h"
+#include "storage/table/directory_page.h"
+#include "storage/table/overflow_page.h"
+#include "storage/table/pax_page.h"
+#include "storage/table/scan_predicate.h"
 #include "storage/table/table_page.h"
 #include "storage/table/tuple.h"
 
@@ -13,78 +22,160 @@ namespace bustub {
 // ====================================
 // ============= Iterator =============
 // ====================================
-TableHeap::TableIterator::TableIterator(TableHeap* table_heap, RID rid)
-  : table_heap_(table_heap), rid_(rid) {}
-
-const Tuple TableHeap::TableIterator::operator*() {
-  if (!tuple_cache_.has_value()) {
-    tuple_cache_ = table_heap_->GetTuple(rid_);
-  }
-  return tuple_cache_.value();
-}
-
-const Tuple* TableHeap::TableIterator::operator->() {
-  if (!tuple_cache_.has_value()) {
-    tuple_cache_ = table_heap_->GetTuple(rid_);
-  }
-  return &tuple_cache_.value();
+TableHeap::TableIterator::TableIterator(TableHeap* table_heap,
+                                        std::size_t ordinal,
+                                        std::size_t end_ordinal,
+                                        const ScanPredicate* predicate)
+  : table_heap_(table_heap), predicate_(predicate), end_ordinal_(end_ordinal) {
+  LoadPage(ordinal);
 }
 
-auto TableHeap::TableIterator::operator++() -> TableIterator& {
-  page_id_t page_id = rid_.GetPageId();
-  uint32_t slot_id = rid_.GetSlotId() + 1;  // next slot
-
-  // get TablePage
-  while (true) {
-    // fetch and pin page
+void TableHeap::TableIterator::LoadPage(std::size_t ordinal) {
+  page_tuples_.clear();
+  cursor_ = 0;
+
+  // the directory may grow during the scan (relocated rows), so re-check size
+  for (; ordinal < end_ordinal_ && ordinal < table_heap_->pages_.size();
+       ordinal++) {
+    page_id_t page_id = table_heap_->pages_[ordinal];
+    if (table_heap_->layout_ == TableLayout::PAX) {
+      LoadPaxPage(page_id);
+      if (page_tuples_.empty()) continue;
+      rid_ = page_tuples_.front().GetRid();
+      next_ordinal_ = ordinal + 1;
+      return;
+    }
+    // fetch and pin page (once per page)
     TablePage* table_page = static_cast<TablePage*>(
         table_heap_->bpm_->FetchPage(table_heap_->table_id_, page_id));
-    // prepare unppin page
-    auto require_to_unpin = page_id;
     if (table_page == nullptr) break;
 
+    // with a predicate: gather the predicate column of every live slot into
+    // pred_values_ first, compare them all at once, then copy only the
+    // matching tuples. forwarded rows live on other pages and are checked
+    // one by one after this page is released
     TablePage::Header* header = table_page->GetHeader();
+    uint32_t width = 0;
+    uint32_t value_offset = 0;
+    uint32_t col_idx = 0;
+    if (predicate_ != nullptr) {
+      width = predicate_->GetWidth();
+      value_offset = predicate_->GetValueOffset();
+      col_idx = predicate_->GetColumnIndex();
+      pred_values_.resize(static_cast<std::size_t>(header->tuple_count_) *
+                          width);
+      pred_nulls_.assign((header->tuple_count_ + 7) / 8, 0);
+      pred_match_.resize((header->tuple_count_ + 63) / 64);
+    }
 
-    for (; slot_id < header->tuple_count_; slot_id++) {
-      // get slot
+    // copy out all live tuples of this page (or the ones to be checked)
+    std::vector<uint32_t> candidates;
+    std::vector<std::size_t> forwarded;
+    candidates.reserve(header->tuple_count_);
+    for (uint32_t slot_id = 0; slot_id < header->tuple_count_; slot_id++) {
       TablePage::Slot* slot = table_page->GetSlot(slot_id);
-      // skip the deleted tuple
-      if (slot->storage_size_ == 0) continue;
-
-      // else get it
-      // alter rid regresh cache
-      rid_ = RID{page_id, slot_id};
-      tuple_cache_ = table_page->GetTuple(rid_);
-      // unpin the page
-      table_heap_->bpm_->UnpinPage(table_heap_->table_id_, require_to_unpin,
-                                   false);
-      return *this;
+      // skip the deleted tuple, and relocated ones (reached via their stub)
+      if (slot->IsDeleted() || slot->IsMoved()) continue;
+      if (predicate_ == nullptr || slot->IsForward()) {
+        candidates.push_back(slot_id);
+        continue;
+      }
+      const char* data = table_page->GetData() + slot->offset_;
+      auto n = static_cast<uint32_t>(candidates.size());
+      std::memcpy(pred_values_.data() + static_cast<std::size_t>(n) * width,
+                  data + value_offset, width);
+      if (data[col_idx >> 3] & (1 << (col_idx % 8))) {
+        pred_nulls_[n >> 3] |= (1 << (n % 8));
+      }
+      candidates.push_back(slot_id);
+    }
+    if (predicate_ != nullptr) {
+      predicate_->Evaluate(pred_values_.data(), pred_nulls_.data(),
+                           static_cast<uint32_t>(candidates.size()),
+                           pred_match_.data());
     }
 
-    // not in this page
-    auto next_page_id = header->next_page_id_;
-    // unpin the page
-    table_heap_->bpm_->UnpinPage(table_heap_->table_id_, require_to_unpin,
-                                 false);
+    page_tuples_.reserve(candidates.size());
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+      uint32_t slot_id = candidates[i];
+      if (table_page->GetSlot(slot_id)->IsForward()) {
+        forwarded.push_back(page_tuples_.size());
+        page_tuples_.emplace_back();
+        page_tuples_.back().SetRid(RID{page_id, slot_id});
+        continue;
+      }
+      if (predicate_ != nullptr &&
+          !(pred_match_[i >> 6] & (uint64_t{1} << (i & 63)))) {
+        continue;
+      }
+      page_tuples_.push_back(table_page->GetTuple(RID{page_id, slot_id}));
+    }
+    table_heap_->bpm_->UnpinPage(table_heap_->table_id_, page_id, false);
 
-    // has next page
-    if (next_page_id != INVALID_PAGE_ID) {
-      // next page & refresh slot id
-      page_id = next_page_id;
-      slot_id = 0;
+    // follow forwarding stubs after releasing this page
+    for (auto idx : forwarded) {
+      page_tuples_[idx] = table_heap_->GetTuple(page_tuples_[idx].GetRid());
+    }
+    if (predicate_ != nullptr && !forwarded.empty()) {
+      std::size_t kept = 0;
+      std::size_t next_forwarded = 0;
+      for (std::size_t i = 0; i < page_tuples_.size(); i++) {
+        if (next_forwarded < forwarded.size() &&
+            forwarded[next_forwarded] == i) {
+          next_forwarded++;
+          if (page_tuples_[i].GetData() == nullptr ||
+              !predicate_->Matches(page_tuples_[i].GetData())) {
+            continue;
+          }
+        }
+        if (kept != i) page_tuples_[kept] = std::move(page_tuples_[i]);
+        kept++;
+      }
+      page_tuples_.resize(kept);
+    }
 
-    } else {
-      break;
+    if (!page_tuples_.empty()) {
+      rid_ = page_tuples_.front().GetRid();
+      next_ordinal_ = ordinal + 1;
+      return;
     }
+    // empty page, go on
   }
+
   // end
   rid_ = RID();
-  tuple_cache_ = std::nullopt;
+  next_ordinal_ = end_ordinal_;
+}
+
+void TableHeap::TableIterator::LoadPaxPage(page_id_t page_id) {
+  PaxPage* pax_page = static_cast<PaxPage*>(
+      table_heap_->bpm_->FetchPage(table_heap_->table_id_, page_id));
+  if (pax_page == nullptr) return;
+  pax_page->CollectTuples(table_heap_->schema_, &page_tuples_, predicate_);
+  table_heap_->bpm_->UnpinPage(table_heap_->table_id_, page_id, false);
+}
+
+auto TableHeap::TableIterator::operator*() const -> const Tuple& {
+  return page_tuples_[cursor_];
+}
+
+auto TableHeap::TableIterator::operator->() const -> const Tuple* {
+  return &page_tuples_[cursor_];
+}
+
+auto TableHeap::TableIterator::operator++() -> TableIterator& {
+  // still in current page
+  if (++cursor_ < page_tuples_.size()) {
+    rid_ = page_tuples_[cursor_].GetRid();
+    return *this;
+  }
+  // current page drained
+  LoadPage(next_ordinal_);
   return *this;
 }
 
 auto TableHeap::TableIterator::operator++(int) -> TableIterator {
-  TableIterator to_ret(table_heap_, rid_);
+  TableIterator to_ret = *this;
   ++(*this);
   return to_ret;
 }
@@ -105,105 +196,273 @@ auto TableHeap::TableIterator::operator!=(const TableIterator& itr) const
 
 // iterator
 auto TableHeap::Begin() -> TableIterator {
-  auto fetch_page_id = first_page_id_;
+  return TableIterator(this, 0, std::numeric_limits<std::size_t>::max());
+}
+auto TableHeap::Begin(std::size_t begin_ordinal, std::size_t end_ordinal,
+                      const ScanPredicate* predicate) -> TableIterator {
+  return TableIterator(this, begin_ordinal, end_ordinal, predicate);
+}
+auto TableHeap::End() -> TableIterator {
+  return TableIterator(this, 0, 0);
+}
 
-  while (true) {
-    if (fetch_page_id == INVALID_PAGE_ID) break;
-    TablePage* page =
-        static_cast<TablePage*>(bpm_->FetchPage(table_id_, fetch_page_id));
+auto TableHeap::GetPageId(std::size_t ordinal) const -> page_id_t {
+  return ordinal < pages_.size() ? pages_[ordinal] : INVALID_PAGE_ID;
+}
+
+// construct with new table: first data page + directory page
+TableHeap::TableHeap(BufferPoolManager* bpm, table_id_t table_id,
+                     const Schema* schema, TableLayout layout)
+  : bpm_(bpm),
+    table_id_(table_id),
+    schema_(schema),
+    first_page_id_(INVALID_PAGE_ID),
+    last_page_id_(INVALID_PAGE_ID),
+    layout_(layout) {
+  // PAX needs a fixed-width schema
+  if (layout_ == TableLayout::PAX && PaxPage::ComputeCapacity(schema_) == 0) {
+    return;
+  }
+  page_id_t first_page_id;
+  Page* first_page = bpm_->NewPage(table_id_, &first_page_id);
+  if (first_page == nullptr) return;
+  InitPage(first_page, first_page_id, INVALID_PAGE_ID);
+  bpm_->UnpinPage(table_id_, first_page_id, true);
+
+  page_id_t directory_page_id;
+  DirectoryPage* directory_page = reinterpret_cast<DirectoryPage*>(
+      bpm_->NewPage(table_id_, &directory_page_id));
+  if (directory_page == nullptr) return;
+  directory_page->Init(directory_page_id);
+  directory_page->SetLayout(layout_);
+  directory_page->Append(first_page_id);
+  bpm_->UnpinPage(table_id_, directory_page_id, true);
+
+  first_page_id_ = first_page_id;
+  last_page_id_ = first_page_id;
+  directory_page_id_ = directory_page_id;
+  last_directory_page_id_ = directory_page_id;
+  pages_.push_back(first_page_id);
+  GetStats()->page_count_ = 1;
+}
+
+// open a table: read the page directory instead of walking the page chain
+TableHeap::TableHeap(BufferPoolManager* bpm, table_id_t table_id,
+                     const Schema* schema, page_id_t directory_page_id,
+                     TableStats* stats)
+  : bpm_(bpm),
+    table_id_(table_id),
+    schema_(schema),
+    first_page_id_(INVALID_PAGE_ID),
+    last_page_id_(INVALID_PAGE_ID),
+    directory_page_id_(directory_page_id),
+    external_stats_(stats) {
+  if (!DirectoryPage::LoadChain(bpm_, table_id_, directory_page_id_, &pages_,
+                                &last_directory_page_id_, &layout_) ||
+      pages_.empty()) {
+    pages_.clear();
+    return;
+  }
+  first_page_id_ = pages_.front();
+  last_page_id_ = pages_.back();
+}
 
-    if (page == nullptr) {
-      return End();
+auto TableHeap::AppendToDirectory(page_id_t page_id) -> bool {
+  DirectoryPage* directory_page = static_cast<DirectoryPage*>(
+      bpm_->FetchPage(table_id_, last_directory_page_id_));
+  if (directory_page == nullptr) return false;
+
+  if (!directory_page->Append(page_id)) {
+    // last directory page is full, chain a new one
+    page_id_t new_directory_page_id;
+    DirectoryPage* new_directory_page = reinterpret_cast<DirectoryPage*>(
+        bpm_->NewPage(table_id_, &new_directory_page_id));
+    if (new_directory_page == nullptr) {
+      bpm_->UnpinPage(table_id_, last_directory_page_id_, false);
+      return false;
     }
-    TablePage::Header* header = page->GetHeader();
-    for (uint32_t slot_id = 0; slot_id < header->tuple_count_; slot_id++) {
-      TablePage::Slot* slot = page->GetSlot(slot_id);
-      // get it
-      if (slot->storage_size_ != 0) {
-        bpm_->UnpinPage(table_id_, fetch_page_id, false);
-        return TableIterator(this, {fetch_page_id, slot_id});
+    new_directory_page->Init(new_directory_page_id);
+    new_directory_page->Append(page_id);
+    directory_page->SetNextPageId(new_directory_page_id);
+    bpm_->UnpinPage(table_id_, new_directory_page_id, true);
+    bpm_->UnpinPage(table_id_, last_directory_page_id_, true);
+    last_directory_page_id_ = new_directory_page_id;
+  } else {
+    bpm_->UnpinPage(table_id_, last_directory_page_id_, true);
+  }
+
+  pages_.push_back(page_id);
+  GetStats()->page_count_++;
+  return true;
+}
+
+auto TableHeap::ToastTuple(const Tuple& tuple) -> Tuple {
+  uint32_t num_col = schema_->GetColumnCount();
+  uint32_t bitmap_size = (num_col + 7) / 8;
+  uint32_t heap_begin = bitmap_size + schema_->GetStorageSize();
+  const char* old_data = tuple.GetData();
+
+  // locate every inline varchar entry: (entry size, column)
+  std::vector<std::pair<uint32_t, uint32_t>> candidates;
+  std::vector<uint32_t> old_offsets(num_col, 0);
+  for (uint32_t i = 0; i < num_col; i++) {
+    const Column& col = schema_->GetColumn(i);
+    if (col.IsInlined() || (old_data[i >> 3] & (1 << (i % 8)))) continue;
+    std::memcpy(&old_offsets[i], old_data + bitmap_size + col.GetOffset(),
+                sizeof(uint32_t));
+    if (old_offsets[i] & Tuple::EXTERNAL_FLAG) continue;
+    uint32_t len;
+    std::memcpy(&len, old_data + old_offsets[i], sizeof(len));
+    candidates.emplace_back(sizeof(len) + len, i);
+  }
+
+  // largest first, until the tuple is small enough
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+  std::vector<bool> externalize(num_col, false);
+  uint32_t new_size = tuple.GetStorageSize();
+  for (const auto& [entry_size, col_idx] : candidates) {
+    if (new_size <= TUPLE_TOAST_THRESHOLD) break;
+    if (entry_size <= sizeof(Tuple::ExternalRef)) break;
+    externalize[col_idx] = true;
+    new_size -= entry_size - sizeof(Tuple::ExternalRef);
+  }
+
+  // rebuild: bitmap and fixed-width section unchanged, heap re-packed
+  std::vector<char> buf(new_size);
+  std::memcpy(buf.data(), old_data, heap_begin);
+  std::vector<page_id_t> written_chains;
+  uint32_t heap_offset = heap_begin;
+  for (uint32_t i = 0; i < num_col; i++) {
+    if (old_offsets[i] == 0) continue;
+    char* slot = buf.data() + bitmap_size + schema_->GetColumn(i).GetOffset();
+    const char* entry = old_data + (old_offsets[i] & ~Tuple::EXTERNAL_FLAG);
+
+    uint32_t entry_size;
+    uint32_t new_slot = heap_offset;
+    if (externalize[i]) {
+      Tuple::ExternalRef ref;
+      std::memcpy(&ref.length_, entry, sizeof(uint32_t));
+      ref.table_id_ = table_id_;
+      ref.first_page_id_ = OverflowPage::WriteChain(
+          bpm_, table_id_, entry + sizeof(uint32_t), ref.length_);
+      if (ref.first_page_id_ == INVALID_PAGE_ID) {
+        // 前面已经写好的溢出链不会再被引用，丢掉
+        for (page_id_t chain : written_chains) {
+          OverflowPage::FreeChain(bpm_, table_id_, chain);
+        }
+        return Tuple();
       }
+      written_chains.push_back(ref.first_page_id_);
+      std::memcpy(buf.data() + heap_offset, &ref, sizeof(ref));
+      entry_size = sizeof(ref);
+      new_slot |= Tuple::EXTERNAL_FLAG;
+    } else if (old_offsets[i] & Tuple::EXTERNAL_FLAG) {
+      // already external, keep the reference
+      entry_size = sizeof(Tuple::ExternalRef);
+      std::memcpy(buf.data() + heap_offset, entry, entry_size);
+      new_slot |= Tuple::EXTERNAL_FLAG;
+    } else {
+      uint32_t len;
+      std::memcpy(&len, entry, sizeof(len));
+      entry_size = sizeof(len) + len;
+      std::memcpy(buf.data() + heap_offset, entry, entry_size);
     }
-    auto next_page_id = header->next_page_id_;
-    bpm_->UnpinPage(table_id_, fetch_page_id, false);
-    fetch_page_id = next_page_id;
+    std::memcpy(slot, &new_slot, sizeof(new_slot));
+    heap_offset += entry_size;
   }
 
-  return End();
-}
-auto TableHeap::End() -> TableIterator {
-  return TableIterator(this, RID());
+  return Tuple(tuple.GetRid(), buf.data(), heap_offset);
 }
 
-// construct with new table
-TableHeap::TableHeap(BufferPoolManager* bpm, table_id_t table_id)
-  : bpm_(bpm), table_id_(table_id) {
-  page_id_t first_page_id;
-  TablePage* table_page =
-      reinterpret_cast<TablePage*>(bpm_->NewPage(table_id_, &first_page_id));
-  if (table_page == nullptr) {
-    first_page_id_ = INVALID_PAGE_ID;
-    last_page_id_ = INVALID_PAGE_ID;
-    return;
+auto TableHeap::HasVarlenColumns() const -> bool {
+  for (uint32_t i = 0; i < schema_->GetColumnCount(); i++) {
+    if (!schema_->GetColumn(i).IsInlined()) return true;
   }
-  first_page_id_ = table_page->GetPageId();
-  last_page_id_ = first_page_id_;
-  table_page->Init(first_page_id_);
-  bpm_->UnpinPage(table_id_, first_page_id_, true);
+  return false;
 }
 
-// open a table
-TableHeap::TableHeap(BufferPoolManager* bpm, table_id_t table_id,
-                     page_id_t first_page_id)
-  : bpm_(bpm), table_id_(table_id), first_page_id_(first_page_id) {
-  // traverse the delist to get the last_page_id
-  auto fetch_page_id = first_page_id;
-  while (true) {
-    TablePage* page =
-        static_cast<TablePage*>(bpm_->FetchPage(table_id_, fetch_page_id));
-    if (page == nullptr) break;
-    TablePage::Header* header = page->GetHeader();
-    auto next_page_id = header->next_page_id_;
-
-    bpm_->UnpinPage(table_id_, fetch_page_id, false);
+auto TableHeap::ExternalChains(const Tuple& tuple) const
+    -> std::vector<page_id_t> {
+  std::vector<page_id_t> chains;
+  const char* data = tuple.GetData();
+  if (data == nullptr || layout_ == TableLayout::PAX) return chains;
+  uint32_t bitmap_size = (schema_->GetColumnCount() + 7) / 8;
+  for (uint32_t i = 0; i < schema_->GetColumnCount(); i++) {
+    const Column& col = schema_->GetColumn(i);
+    if (col.IsInlined() || (data[i >> 3] & (1 << (i % 8)))) continue;
+    uint32_t heap_offset;
+    std::memcpy(&heap_offset, data + bitmap_size + col.GetOffset(),
+                sizeof(heap_offset));
+    if (!(heap_offset & Tuple::EXTERNAL_FLAG)) continue;
+    Tuple::ExternalRef ref;
+    std::memcpy(&ref, data + (heap_offset & ~Tuple::EXTERNAL_FLAG),
+                sizeof(ref));
+    chains.push_back(ref.first_page_id_);
+  }
+  return chains;
+}
 
-    if (next_page_id == INVALID_PAGE_ID) {
-      last_page_id_ = fetch_page_id;
-      break;
+auto TableHeap::FreeChains(const std::vector<page_id_t>& chains,
+                           const std::vector<page_id_t>& keep) -> void {
+  for (page_id_t chain : chains) {
+    if (std::find(keep.begin(), keep.end(), chain) == keep.end()) {
+      OverflowPage::FreeChain(bpm_, table_id_, chain);
     }
-    fetch_page_id = next_page_id;
   }
 }
 
 // Logic fuctions
-RID TableHeap::InsertTuple(const Tuple& tuple) {
+RID TableHeap::InsertTuple(const Tuple& raw_tuple) {
+  // move large varchar values out to overflow pages first
+  Tuple toasted;
+  if (raw_tuple.GetStorageSize() > TUPLE_TOAST_THRESHOLD) {
+    toasted = ToastTuple(raw_tuple);
+    if (toasted.GetData() == nullptr) return RID();
+  }
+  const Tuple& tuple = toasted.GetData() != nullptr ? toasted : raw_tuple;
+
+  RID rid = InsertIntoLastPage(tuple, false);
+  if (rid.GetPageId() != INVALID_PAGE_ID) {
+    GetStats()->live_tuples_++;
+    GetStats()->tuple_bytes_ += tuple.GetStorageSize();
+  } else {
+    FreeChains(ExternalChains(toasted), {});
+  }
+  return rid;
+}
+
+auto TableHeap::InsertIntoLastPage(const Tuple& tuple, bool is_moved) -> RID {
   // prepare to unpin
   auto fetch_page_id = last_page_id_;
   RID ret_rid{};
 
   // open the last page
-  TablePage* last_page =
-      static_cast<TablePage*>(bpm_->FetchPage(table_id_, fetch_page_id));
+  Page* last_page = bpm_->FetchPage(table_id_, fetch_page_id);
   if (last_page == nullptr) return ret_rid;
   // try insert
-  ret_rid = last_page->InsertTuple(tuple);
+  ret_rid = InsertIntoPage(last_page, tuple, is_moved);
 
   // has not enough room
   if (ret_rid.GetPageId() == INVALID_PAGE_ID) {
     page_id_t new_page_id;
-    TablePage* new_page =
-        static_cast<TablePage*>(bpm_->NewPage(table_id_, &new_page_id));
+    Page* new_page = bpm_->NewPage(table_id_, &new_page_id);
+    // register in the page directory first, give the page back on failure
+    if (new_page != nullptr && !AppendToDirectory(new_page_id)) {
+      bpm_->UnpinPage(table_id_, new_page_id, false);
+      bpm_->DeletePage(table_id_, new_page_id);
+      new_page = nullptr;
+    }
     // success allocate
     if (new_page != nullptr) {
       // to be next
-      new_page->Init(new_page_id, last_page_id_);  // push
+      InitPage(new_page, new_page_id, last_page_id_);  // push
       // to be prev
-      TablePage::Header* header = last_page->GetHeader();
-      header->next_page_id_ = new_page_id;
+      SetNextPageId(last_page, new_page_id);
       // change last_page_id
       last_page_id_ = new_page_id;
       // insert in new page
-      ret_rid = new_page->InsertTuple(tuple);
+      ret_rid = InsertIntoPage(new_page, tuple, is_moved);
       // unpin new page and fetched page
       bpm_->UnpinPage(table_id_, new_page_id, true);
       bpm_->UnpinPage(table_id_, fetch_page_id, true);
@@ -218,42 +477,305 @@ RID TableHeap::InsertTuple(const Tuple& tuple) {
   return ret_rid;
 }
 
+auto TableHeap::InitPage(Page* page, page_id_t page_id,
+                         page_id_t prev_page_id) -> void {
+  if (layout_ == TableLayout::PAX) {
+    static_cast<PaxPage*>(page)->Init(schema_, page_id, prev_page_id);
+  } else {
+    static_cast<TablePage*>(page)->Init(page_id, prev_page_id);
+  }
+}
+
+auto TableHeap::SetNextPageId(Page* page, page_id_t next_page_id) -> void {
+  if (layout_ == TableLayout::PAX) {
+    static_cast<PaxPage*>(page)->GetHeader()->next_page_id_ = next_page_id;
+  } else {
+    static_cast<TablePage*>(page)->GetHeader()->next_page_id_ = next_page_id;
+  }
+}
+
+auto TableHeap::InsertIntoPage(Page* page, const Tuple& tuple,
+                               bool is_moved) -> RID {
+  // PAX rows are fixed width and never relocated
+  if (layout_ == TableLayout::PAX) {
+    return static_cast<PaxPage*>(page)->InsertTuple(schema_, tuple);
+  }
+  return static_cast<TablePage*>(page)->InsertTuple(tuple, is_moved);
+}
+
 auto TableHeap::MarkDeleted(const RID rid) -> bool {
   // prepare to unpin
   auto fetch_page_id = rid.GetPageId();
+  if (layout_ == TableLayout::PAX) {
+    auto pax_page =
+        static_cast<PaxPage*>(bpm_->FetchPage(table_id_, fetch_page_id));
+    if (pax_page == nullptr) return false;
+    bool deleted = pax_page->MarkDeleted(rid);
+    bpm_->UnpinPage(table_id_, fetch_page_id, deleted);
+    if (deleted) {
+      GetStats()->live_tuples_--;
+      GetStats()->dead_tuples_++;
+      GetStats()->tuple_bytes_ -= PaxRowSize();
+    }
+    return deleted;
+  }
+
+  // overflow chains of the row, freed once the delete has happened
+  std::vector<page_id_t> chains;
+  if (HasVarlenColumns()) {
+    chains = ExternalChains(GetTuple(rid));
+  }
+
   TablePage* page =
       static_cast<TablePage*>(bpm_->FetchPage(table_id_, fetch_page_id));
-  if (page != nullptr) {
-    if (page->MarkDeleted(rid)) {
-      bpm_->UnpinPage(table_id_, fetch_page_id, true);
-      return true;
+  if (page == nullptr) return false;
+
+  RID target;
+  bool is_forward = page->GetForward(rid.GetSlotId(), &target);
+  uint32_t old_size = 0;
+  if (!is_forward && rid.GetSlotId() < page->GetHeader()->tuple_count_) {
+    old_size = page->GetSlot(rid.GetSlotId())->GetSize();
+  }
+  bool deleted = page->MarkDeleted(rid);
+  bpm_->UnpinPage(table_id_, fetch_page_id, deleted);
+
+  // the row itself lives behind the stub
+  if (deleted && is_forward) {
+    TablePage* target_page = static_cast<TablePage*>(
+        bpm_->FetchPage(table_id_, target.GetPageId()));
+    if (target_page != nullptr) {
+      old_size = target_page->GetSlot(target.GetSlotId())->GetSize();
+      target_page->MarkDeleted(target);
+      bpm_->UnpinPage(table_id_, target.GetPageId(), true);
+      GetStats()->dead_tuples_++;
     }
-    bpm_->UnpinPage(table_id_, fetch_page_id, false);
   }
-  return false;
+  if (deleted) {
+    GetStats()->live_tuples_--;
+    GetStats()->dead_tuples_++;
+    GetStats()->tuple_bytes_ -= old_size;
+    FreeChains(chains, {});
+  }
+  return deleted;
+}
+
+auto TableHeap::UpdateTuple(const Tuple& raw_tuple, RID rid) -> bool {
+  // PAX rows are fixed width: always in place
+  if (layout_ == TableLayout::PAX) {
+    auto pax_page =
+        static_cast<PaxPage*>(bpm_->FetchPage(table_id_, rid.GetPageId()));
+    if (pax_page == nullptr) return false;
+    bool updated = pax_page->UpdateTuple(schema_, raw_tuple, rid);
+    bpm_->UnpinPage(table_id_, rid.GetPageId(), updated);
+    return updated;
+  }
+
+  // the row must still be there before anything is written for it;
+  // its image also tells which overflow chains the old values own
+  Tuple old_tuple = GetTuple(rid);
+  if (old_tuple.GetData() == nullptr) return false;
+  return UpdateRow(raw_tuple, rid, old_tuple);
+}
+
+auto TableHeap::UpdateRow(const Tuple& raw_tuple, RID rid,
+                          const Tuple& old_tuple) -> bool {
+  Tuple toasted;
+  if (raw_tuple.GetStorageSize() > TUPLE_TOAST_THRESHOLD) {
+    toasted = ToastTuple(raw_tuple);
+    if (toasted.GetData() == nullptr) return false;
+  }
+  const Tuple& new_tuple = toasted.GetData() != nullptr ? toasted : raw_tuple;
+
+  // chains only one side refers to: the old values' after a successful
+  // update, the ones just written on failure (carried-over refs are shared)
+  std::vector<page_id_t> old_chains = ExternalChains(old_tuple);
+  std::vector<page_id_t> new_chains = ExternalChains(new_tuple);
+  bool updated = UpdateStored(new_tuple, rid);
+  FreeChains(updated ? old_chains : new_chains,
+             updated ? new_chains : old_chains);
+  return updated;
 }
 
-auto TableHeap::UpdateTuple(const Tuple& new_tuple, RID rid) -> bool {
+auto TableHeap::UpdateStored(const Tuple& new_tuple, RID rid) -> bool {
   // prepare to unpin
   auto fetch_page_id = rid.GetPageId();
   TablePage* page =
       static_cast<TablePage*>(bpm_->FetchPage(table_id_, fetch_page_id));
-  if (page != nullptr) {
-    // ok to insert
-    if (page->UpdateTuple(new_tuple, rid)) {
+  if (page == nullptr) return false;
+  if (rid.GetSlotId() >= page->GetHeader()->tuple_count_ ||
+      page->GetSlot(rid.GetSlotId())->IsDeleted()) {
+    bpm_->UnpinPage(table_id_, fetch_page_id, false);
+    return false;
+  }
+
+  RID old_target;
+  bool is_forward = page->GetForward(rid.GetSlotId(), &old_target);
+  uint32_t old_size = 0;
+  uint32_t new_size = new_tuple.GetStorageSize();
+  if (!is_forward) {
+    old_size = page->GetSlot(rid.GetSlotId())->GetSize();
+    // ok to update in place (maybe after compaction)
+    uint32_t reclaimed = 0;
+    bool updated = page->UpdateTuple(new_tuple, rid, &reclaimed);
+    ReclaimDead(reclaimed);
+    if (updated) {
       bpm_->UnpinPage(table_id_, fetch_page_id, true);
+      GetStats()->tuple_bytes_ += static_cast<int64_t>(new_size) - old_size;
       return true;
     }
+    bpm_->UnpinPage(table_id_, fetch_page_id, true);
+  } else {
     bpm_->UnpinPage(table_id_, fetch_page_id, false);
+    // already relocated: try the relocated image first
+    TablePage* target_page = static_cast<TablePage*>(
+        bpm_->FetchPage(table_id_, old_target.GetPageId()));
+    if (target_page == nullptr) return false;
+    old_size = target_page->GetSlot(old_target.GetSlotId())->GetSize();
+    uint32_t reclaimed = 0;
+    bool updated = target_page->UpdateTuple(new_tuple, old_target, &reclaimed);
+    bpm_->UnpinPage(table_id_, old_target.GetPageId(), true);
+    ReclaimDead(reclaimed);
+    if (updated) {
+      GetStats()->tuple_bytes_ += static_cast<int64_t>(new_size) - old_size;
+      return true;
+    }
   }
-  return false;
+
+  // does not fit: relocate the row and leave a forwarding stub,
+  // so the RID seen by everyone else stays the same
+  RID new_target = InsertIntoLastPage(new_tuple, true);
+  if (new_target.GetPageId() == INVALID_PAGE_ID) return false;
+
+  page = static_cast<TablePage*>(bpm_->FetchPage(table_id_, fetch_page_id));
+  if (page == nullptr) return false;
+  page->SetForward(rid.GetSlotId(), new_target);
+  bpm_->UnpinPage(table_id_, fetch_page_id, true);
+  GetStats()->tuple_bytes_ += static_cast<int64_t>(new_size) - old_size;
+
+  // keep chains one hop long: drop the previous relocated image
+  if (is_forward) {
+    TablePage* target_page = static_cast<TablePage*>(
+        bpm_->FetchPage(table_id_, old_target.GetPageId()));
+    if (target_page != nullptr) {
+      target_page->MarkDeleted(old_target);
+      bpm_->UnpinPage(table_id_, old_target.GetPageId(), true);
+      GetStats()->dead_tuples_++;
+    }
+  }
+  return true;
+}
+
+auto TableHeap::ReplaceColumns(RID rid, const std::vector<uint32_t>& cols,
+                               const std::vector<Value>& values) -> bool {
+  Tuple old_tuple = GetTuple(rid);
+  if (old_tuple.GetData() == nullptr) return false;
+
+  // serialize the new values on their own (other columns NULL),
+  // then take each column from either that row or the stored one
+  uint32_t num_col = schema_->GetColumnCount();
+  std::vector<Value> patch_values;
+  patch_values.reserve(num_col);
+  for (uint32_t i = 0; i < num_col; i++) {
+    patch_values.emplace_back(schema_->GetColumn(i).GetType());
+  }
+  std::vector<bool> replaced(num_col, false);
+  for (std::size_t k = 0; k < cols.size(); k++) {
+    patch_values[cols[k]] = values[k];
+    replaced[cols[k]] = true;
+  }
+  Tuple patch(patch_values, const_cast<Schema*>(schema_));
+
+  // bitmap and fixed-width section first, var-len entries appended
+  uint32_t bitmap_size = (num_col + 7) / 8;
+  uint32_t heap_begin = bitmap_size + schema_->GetStorageSize();
+  std::vector<char> buf(old_tuple.GetData(), old_tuple.GetData() + heap_begin);
+  for (uint32_t i = 0; i < num_col; i++) {
+    const Column& col = schema_->GetColumn(i);
+    const char* src = replaced[i] ? patch.GetData() : old_tuple.GetData();
+    uint32_t slot = bitmap_size + col.GetOffset();
+    bool is_null = src[i >> 3] & (1 << (i % 8));
+    if (is_null) {
+      buf[i >> 3] |= (1 << (i % 8));
+    } else {
+      buf[i >> 3] &= ~(1 << (i % 8));
+    }
+    if (col.IsInlined()) {
+      if (replaced[i]) {
+        std::memcpy(buf.data() + slot, src + slot, col.GetFixedLength());
+      }
+      continue;
+    }
+    uint32_t heap_offset = 0;
+    if (!is_null) {
+      // an external value keeps its ExternalRef, the chain is not read
+      std::memcpy(&heap_offset, src + slot, sizeof(heap_offset));
+      const char* entry = src + (heap_offset & ~Tuple::EXTERNAL_FLAG);
+      uint32_t entry_size = sizeof(Tuple::ExternalRef);
+      if (!(heap_offset & Tuple::EXTERNAL_FLAG)) {
+        std::memcpy(&entry_size, entry, sizeof(uint32_t));
+        entry_size += sizeof(uint32_t);
+      }
+      heap_offset = static_cast<uint32_t>(buf.size()) |
+                    (heap_offset & Tuple::EXTERNAL_FLAG);
+      buf.insert(buf.end(), entry, entry + entry_size);
+    }
+    std::memcpy(buf.data() + slot, &heap_offset, sizeof(heap_offset));
+  }
+
+  Tuple new_tuple(rid, buf.data(), static_cast<uint32_t>(buf.size()));
+  if (layout_ == TableLayout::PAX) return UpdateTuple(new_tuple, rid);
+  return UpdateRow(new_tuple, rid, old_tuple);
+}
+
+auto TableHeap::UpdateColumns(RID rid, const std::vector<uint32_t>& cols,
+                              const std::vector<Value>& values) -> bool {
+  if (layout_ == TableLayout::PAX) {
+    auto pax_page =
+        static_cast<PaxPage*>(bpm_->FetchPage(table_id_, rid.GetPageId()));
+    if (pax_page == nullptr) return false;
+    bool updated = pax_page->UpdateColumns(schema_, rid, cols, values);
+    bpm_->UnpinPage(table_id_, rid.GetPageId(), updated);
+    return updated;
+  }
+
+  // the row length does not change: never relocates, stats stay the same
+  TablePage* page =
+      static_cast<TablePage*>(bpm_->FetchPage(table_id_, rid.GetPageId()));
+  if (page == nullptr) return false;
+  RID target;
+  if (page->GetForward(rid.GetSlotId(), &target)) {
+    bpm_->UnpinPage(table_id_, rid.GetPageId(), false);
+    page = static_cast<TablePage*>(
+        bpm_->FetchPage(table_id_, target.GetPageId()));
+    if (page == nullptr) return false;
+    rid = target;
+  }
+  bool updated = page->UpdateColumns(schema_, rid, cols, values);
+  bpm_->UnpinPage(table_id_, rid.GetPageId(), updated);
+  return updated;
 }
 
 auto TableHeap::GetTuple(const RID& rid) -> Tuple {
   auto fetch_page_id = rid.GetPageId();
+  if (layout_ == TableLayout::PAX) {
+    auto pax_page =
+        static_cast<PaxPage*>(bpm_->FetchPage(table_id_, fetch_page_id));
+    if (pax_page == nullptr) return Tuple();
+    Tuple tuple = pax_page->GetTuple(schema_, rid);
+    bpm_->UnpinPage(table_id_, fetch_page_id, false);
+    return tuple;
+  }
   TablePage* page =
       static_cast<TablePage*>(bpm_->FetchPage(table_id_, fetch_page_id));
   if (page != nullptr) {
+    RID target;
+    if (page->GetForward(rid.GetSlotId(), &target)) {
+      bpm_->UnpinPage(table_id_, fetch_page_id, false);
+      // one hop: the relocated image is never a stub itself
+      Tuple tuple = GetTuple(target);
+      tuple.SetRid(rid);
+      return tuple;
+    }
     Tuple tuple = page->GetTuple(rid);
     bpm_->UnpinPage(table_id_, fetch_page_id, false);
     return tuple;
@@ -261,4 +783,54 @@ auto TableHeap::GetTuple(const RID& rid) -> Tuple {
   return Tuple();
 }
 
-}  // namespace bustub
\ No newline at end of file
+auto TableHeap::CollapseForwarding() -> uint32_t {
+  uint32_t collapsed = 0;
+  // PAX pages never relocate rows
+  if (layout_ == TableLayout::PAX) return collapsed;
+
+  // pages appended from here on only hold relocated rows, no stubs
+  std::size_t page_count = pages_.size();
+
+  for (std::size_t ordinal = 0; ordinal < page_count; ordinal++) {
+    page_id_t page_id = pages_[ordinal];
+    TablePage* page =
+        static_cast<TablePage*>(bpm_->FetchPage(table_id_, page_id));
+    if (page == nullptr) break;
+    // collect the stubs of this page
+    std::vector<std::pair<uint32_t, RID>> stubs;
+    TablePage::Header* header = page->GetHeader();
+    for (uint32_t slot_id = 0; slot_id < header->tuple_count_; slot_id++) {
+      RID target;
+      if (page->GetForward(slot_id, &target)) {
+        stubs.emplace_back(slot_id, target);
+      }
+    }
+    bpm_->UnpinPage(table_id_, page_id, false);
+
+    for (const auto& [slot_id, target] : stubs) {
+      Tuple moved = GetTuple(target);
+      if (moved.GetData() == nullptr) continue;
+
+      // move the row home if the page has room now (after compaction)
+      page = static_cast<TablePage*>(bpm_->FetchPage(table_id_, page_id));
+      if (page == nullptr) break;
+      uint32_t reclaimed = 0;
+      bool restored = page->Unforward(slot_id, moved, &reclaimed);
+      bpm_->UnpinPage(table_id_, page_id, true);
+      ReclaimDead(reclaimed);
+      if (!restored) continue;
+
+      TablePage* target_page = static_cast<TablePage*>(
+          bpm_->FetchPage(table_id_, target.GetPageId()));
+      if (target_page != nullptr) {
+        target_page->MarkDeleted(target);
+        bpm_->UnpinPage(table_id_, target.GetPageId(), true);
+        GetStats()->dead_tuples_++;
+      }
+      collapsed++;
+    }
+  }
+  return collapsed;
+}
+
+}  // namespace bustub
@@ -1,7 +1,9 @@
 #include "storage/table/table_page.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <vector>
 
 #include "common/config.h"
 #include "common/rid.h"
@@ -42,7 +44,7 @@ auto TablePage::GetFreeSpaceRemaining() -> uint32_t {
   return header->free_space_ptr_ - used_header_slot_space;
 }
 
-auto TablePage::InsertTuple(const Tuple &tuple) -> RID {
+auto TablePage::InsertTuple(const Tuple &tuple, bool is_moved) -> RID {
   // enough size
   if (GetFreeSpaceRemaining() >= tuple.GetStorageSize() + sizeof(Slot)) {
     Header *header = GetHeader();
@@ -55,7 +57,7 @@ auto TablePage::InsertTuple(const Tuple &tuple) -> RID {
 
     // set slot
 
-    Slot slot{data_offset, data_size};
+    Slot slot{data_offset, data_size | (is_moved ? SLOT_MOVED_FLAG : 0)};
     std::memcpy(data_ + sizeof(Header) + sizeof(Slot) * (header->tuple_count_),
                 &slot, sizeof(Slot));
     RID rid(page_id_, (header->tuple_count_)++);
@@ -71,12 +73,12 @@ auto TablePage::GetTuple(const RID rid) -> Tuple {
     return Tuple();
   }
   Slot *slot = GetSlot(rid.GetSlotId());
-  // is delete?
-  if (slot->storage_size_ == 0) {
+  // is delete? (forwarding stub is resolved by TableHeap)
+  if (slot->IsDeleted() || slot->IsForward()) {
     return Tuple();
   }
 
-  Tuple ret_tuple(rid, data_ + slot->offset_, slot->storage_size_);
+  Tuple ret_tuple(rid, data_ + slot->offset_, slot->GetSize());
   return ret_tuple;
 }
 
@@ -87,7 +89,10 @@ auto TablePage::MarkDeleted(const RID rid) -> bool {
     return false;
   }
   Slot *slot = GetSlot(rid.GetSlotId());
-  if (slot->storage_size_ == 0) return false;
+  if (slot->IsDeleted()) return false;
+  // a stub has no bytes, but keeps a non-zero offset so Compact still
+  // counts the deleted slot once
+  if (slot->IsForward()) slot->offset_ = PAGE_SIZE;
   slot->storage_size_ = 0;
   return true;
 }
@@ -108,30 +113,124 @@ auto TablePage::MoveInsertTuple(const Tuple &tuple) -> uint32_t {
   }
 }
 
-auto TablePage::UpdateTuple(const Tuple &new_tuple, RID rid) -> bool {
+auto TablePage::UpdateTuple(const Tuple &new_tuple, RID rid,
+                            uint32_t *reclaimed) -> bool {
   Header *header = GetHeader();
   if (rid.GetPageId() != page_id_ || rid.GetSlotId() >= header->tuple_count_)
     return false;
   Slot *slot = GetSlot(rid.GetSlotId());
+  if (slot->IsDeleted() || slot->IsForward()) return false;
+  uint32_t moved_flag = slot->storage_size_ & SLOT_MOVED_FLAG;
   // just memcpy
-  if (new_tuple.GetStorageSize() <= slot->storage_size_) {
-    Slot *slot = GetSlot(rid.GetSlotId());
+  if (new_tuple.GetStorageSize() <= slot->GetSize()) {
     uint32_t offset = slot->offset_;
     memcpy(data_ + offset, new_tuple.GetData(), new_tuple.GetStorageSize());
-    slot->storage_size_ = new_tuple.GetStorageSize();
+    slot->storage_size_ = new_tuple.GetStorageSize() | moved_flag;
     return true;
   }
   // insert
   else {
     uint32_t offset = MoveInsertTuple(new_tuple);
-    if (offset != INVALID_OFFSET) {
-      // alter slot
-      slot->offset_ = offset;
-      slot->storage_size_ = new_tuple.GetStorageSize();
-      return true;
-    } else
-      return false;
+    if (offset == INVALID_OFFSET) {
+      // reclaim holes left by other slots and retry once,
+      // the old image is kept so a failure loses nothing
+      uint32_t count = Compact();
+      if (reclaimed != nullptr) *reclaimed += count;
+      offset = MoveInsertTuple(new_tuple);
+      if (offset == INVALID_OFFSET) return false;
+    }
+    // alter slot
+    slot->offset_ = offset;
+    slot->storage_size_ = new_tuple.GetStorageSize() | moved_flag;
+    return true;
+  }
+}
+
+auto TablePage::UpdateColumns(const Schema *schema, RID rid,
+                              const std::vector<uint32_t> &cols,
+                              const std::vector<Value> &values) -> bool {
+  Header *header = GetHeader();
+  if (rid.GetPageId() != page_id_ || rid.GetSlotId() >= header->tuple_count_)
+    return false;
+  Slot *slot = GetSlot(rid.GetSlotId());
+  if (slot->IsDeleted() || slot->IsForward()) return false;
+  // | null bitmap | fixed-width section | var-len heap |
+  char *row = data_ + slot->offset_;
+  char *fixed = row + (schema->GetColumnCount() + 7) / 8;
+  for (std::size_t i = 0; i < cols.size(); i++) {
+    uint32_t col_idx = cols[i];
+    if (values[i].IsNull()) {
+      row[col_idx >> 3] |= (1 << (col_idx % 8));
+      continue;
+    }
+    row[col_idx >> 3] &= ~(1 << (col_idx % 8));
+    values[i].SerializeTo(fixed + schema->GetColumn(col_idx).GetOffset());
+  }
+  return true;
+}
+
+auto TablePage::GetForward(uint32_t slot_id, RID *target) -> bool {
+  if (slot_id >= GetHeader()->tuple_count_) return false;
+  Slot *slot = GetSlot(slot_id);
+  if (!slot->IsForward()) return false;
+  target->Set(slot->offset_, slot->storage_size_ & ~SLOT_FORWARD_FLAG);
+  return true;
+}
+
+auto TablePage::SetForward(uint32_t slot_id, RID target) -> void {
+  Slot *slot = GetSlot(slot_id);
+  slot->offset_ = target.GetPageId();
+  slot->storage_size_ = SLOT_FORWARD_FLAG | target.GetSlotId();
+}
+
+auto TablePage::Unforward(uint32_t slot_id, const Tuple &tuple,
+                          uint32_t *reclaimed) -> bool {
+  Slot *slot = GetSlot(slot_id);
+  if (!slot->IsForward()) return false;
+  if (GetFreeSpaceRemaining() < tuple.GetStorageSize()) {
+    uint32_t count = Compact();
+    if (reclaimed != nullptr) *reclaimed += count;
+  }
+  uint32_t offset = MoveInsertTuple(tuple);
+  if (offset == INVALID_OFFSET) return false;
+  slot->offset_ = offset;
+  slot->storage_size_ = tuple.GetStorageSize();
+  return true;
+}
+
+auto TablePage::Compact() -> uint32_t {
+  Header *header = GetHeader();
+
+  // live images, highest offset first so they can be slid toward the end;
+  // deleted slots still holding an offset have their bytes reclaimed here
+  std::vector<uint32_t> live;
+  uint32_t reclaimed = 0;
+  for (uint32_t slot_id = 0; slot_id < header->tuple_count_; slot_id++) {
+    Slot *slot = GetSlot(slot_id);
+    if (slot->IsDeleted()) {
+      if (slot->offset_ != 0) {
+        slot->offset_ = 0;
+        reclaimed++;
+      }
+    } else if (!slot->IsForward()) {
+      live.push_back(slot_id);
+    }
+  }
+  std::sort(live.begin(), live.end(), [this](uint32_t a, uint32_t b) {
+    return GetSlot(a)->offset_ > GetSlot(b)->offset_;
+  });
+
+  uint32_t free_ptr = PAGE_SIZE;
+  for (auto slot_id : live) {
+    Slot *slot = GetSlot(slot_id);
+    uint32_t size = slot->GetSize();
+    free_ptr -= size;
+    // regions only ever move toward the end, memmove handles overlap
+    std::memmove(data_ + free_ptr, data_ + slot->offset_, size);
+    slot->offset_ = free_ptr;
   }
+  header->free_space_ptr_ = free_ptr;
+  return reclaimed;
 }
 
 }  // namespace bustub
\ No newline at end of file
@@ -5,7 +5,10 @@
 #include <cstring>
 #include <vector>
 
+#include "common/exception.h"
 #include "common/rid.h"
+#include "storage/table/dictionary.h"
+#include "storage/table/overflow_page.h"
 
 namespace bustub {
 
@@ -18,7 +21,7 @@ Tuple::Tuple(RID rid, char *data, uint32_t size)
   std::memcpy(data_, data, storage_size_);
 }
 
-Tuple::Tuple(std::vector<Value> values, Schema *schema) {
+Tuple::Tuple(const std::vector<Value> &values, Schema *schema) {
   is_allocated_ = true;
 
   assert(values.size() == schema->GetColumnCount());
@@ -28,10 +31,17 @@ Tuple::Tuple(std::vector<Value> values, Schema *schema) {
 
   // caculate bitmap size
   uint32_t bitmap_size = (num_col + 7) / 8;
-  // data size
-  uint32_t data_size = schema->GetStorageSize();
+  // fixed-width section size
+  uint32_t fixed_size = schema->GetStorageSize();
+  // var-len heap size: only the real length of each non-null varchar
+  uint32_t varlen_size = 0;
+  for (uint32_t i = 0; i < num_col; ++i) {
+    if (!schema->GetColumn(i).IsInlined() && !values[i].IsNull()) {
+      varlen_size += values[i].GetStorageSize();
+    }
+  }
   // storage size
-  storage_size_ = bitmap_size + data_size;
+  storage_size_ = bitmap_size + fixed_size + varlen_size;
 
   // == allocate and initial ==
   data_ = new char[storage_size_];
@@ -40,22 +50,36 @@ Tuple::Tuple(std::vector<Value> values, Schema *schema) {
   std::memset(data_, 0, storage_size_);
 
   // == serialize ==
-
+  // | null bitmap | fixed-width section | var-len heap |
   char *data_ptr = data_ + bitmap_size;  // skip bitmap
+  uint32_t heap_offset = bitmap_size + fixed_size;
 
   for (uint32_t i = 0; i < num_col; ++i) {
     auto &col = schema->GetColumn(i);
     auto &val = values[i];
 
-    if (col.GetType() == TypeId::VARCHAR) {
-      assert(val.GetStorageSize() <= col.GetStorageSize() &&
-             "Varchar data too long for column definition!");
-    }
-
     if (val.IsNull()) {
       data_[i >> 3] |= (1 << (i % 8));
-    } else {
+      continue;
+    }
+
+    if (col.IsDictEncoded()) {
+      assert(val.GetLogicLength() <= col.GetStorageSize() &&
+             "Varchar data too long for column definition!");
+      // 字典编码列：定长槽里直接放编码
+      uint32_t code = col.GetDictionary()->GetOrAdd(val.GetAsVarChar(),
+                                                    val.GetLogicLength());
+      std::memcpy(data_ptr + col.GetOffset(), &code, sizeof(code));
+    } else if (col.IsInlined()) {
       val.SerializeTo(data_ptr + col.GetOffset());
+    } else {
+      assert(val.GetLogicLength() <= col.GetStorageSize() &&
+             "Varchar data too long for column definition!");
+      // fixed slot keeps the offset of [len][bytes] in the heap
+      std::memcpy(data_ptr + col.GetOffset(), &heap_offset,
+                  sizeof(heap_offset));
+      val.SerializeTo(data_ + heap_offset);
+      heap_offset += val.GetStorageSize();
     }
   }
 }
@@ -112,7 +136,8 @@ Tuple& Tuple::operator=(const Tuple &other) {
   return *this;
 }
 
-Value Tuple::GetValue(const Schema *schema, uint32_t column_idx) const {
+Value Tuple::GetValue(const Schema *schema, uint32_t column_idx,
+                      BufferPoolManager *bpm) const {
   assert(schema != nullptr);
   assert(data_ != nullptr);
 
@@ -135,9 +160,43 @@ Value Tuple::GetValue(const Schema *schema, uint32_t column_idx) const {
   uint32_t bitmap_size = (schema->GetColumnCount() + 7) / 8;
 
   // 数据指针 = data_ + bitmap_size + 列的偏移量
-  // col.GetOffset() 返回的是相对于数据区起点的偏移
+  // col.GetOffset() 返回的是相对于定长区起点的偏移
   const char *val_ptr = data_ + bitmap_size + col.GetOffset();
 
+  // 字典编码列：定长区里是编码，查字典解码
+  if (col.IsDictEncoded()) {
+    uint32_t code;
+    std::memcpy(&code, val_ptr, sizeof(code));
+    std::string_view str = col.GetDictionary()->Decode(code);
+    return Value(str.data(), static_cast<uint32_t>(str.size()));
+  }
+
+  // 变长列：定长区里是变长区的偏移，再跳一次即可，仍然 O(1)
+  if (!col.IsInlined()) {
+    uint32_t heap_offset;
+    std::memcpy(&heap_offset, val_ptr, sizeof(heap_offset));
+
+    // 溢出列：按需读出溢出链
+    if (heap_offset & EXTERNAL_FLAG) {
+      if (bpm == nullptr) {
+        throw Exception(ExceptionType::EXECUTION,
+                        "column '" + col.GetName() +
+                            "' is stored externally, need a buffer pool");
+      }
+      ExternalRef ref;
+      std::memcpy(&ref, data_ + (heap_offset & ~EXTERNAL_FLAG), sizeof(ref));
+      std::string str(ref.length_, '\0');
+      if (!OverflowPage::ReadChain(bpm, ref.table_id_, ref.first_page_id_,
+                                   str.data(), ref.length_)) {
+        throw Exception(ExceptionType::EXECUTION,
+                        "failed to read overflow chain of column '" +
+                            col.GetName() + "'");
+      }
+      return Value(str);
+    }
+    val_ptr = data_ + heap_offset;
+  }
+
   // 反序列化
   return Value::DeserializeFrom(val_ptr, col.GetType());
 }
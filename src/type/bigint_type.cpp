@@ -0,0 +1,40 @@
+#include "type/bigint_type.h"
+
+#include <cstring>
+
+#include "type/type_kernels.h"
+
+namespace bustub {
+
+// constructor
+BigIntType::BigIntType() : Type(TypeId::BIGINT) {
+  // nothing
+}
+
+void BigIntType::SerializeTo(const Value &val, char *storage) const {
+  TypeKernel<TypeId::BIGINT>::Serialize(val, storage);
+}
+
+Value BigIntType::DeserializeFrom(const char *storage) const {
+  int64_t raw_val;
+  std::memcpy(&raw_val, storage, sizeof(raw_val));
+  return Value(TypeId::BIGINT, raw_val);
+}
+
+bool BigIntType::CompareEquals(const Value &left, const Value &right) const {
+  return TypeKernel<TypeId::BIGINT>::Equals(left, right);
+}
+
+bool BigIntType::CompareLessThan(const Value &left, const Value &right) const {
+  return TypeKernel<TypeId::BIGINT>::LessThan(left, right);
+}
+
+uint64_t BigIntType::Hash(const Value &val) const {
+  return TypeKernel<TypeId::BIGINT>::Hash(val);
+}
+
+std::string BigIntType::ToString(const Value &val) const {
+  return std::to_string(val.GetAsBigInt());
+}
+
+}  // namespace bustub
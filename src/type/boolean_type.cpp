@@ -0,0 +1,56 @@
+#include "type/boolean_type.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "type/type_kernels.h"
+
+namespace bustub {
+
+// constructor
+BooleanType::BooleanType() : Type(TypeId::BOOLEAN) {
+  // nothing
+}
+
+void BooleanType::SerializeTo(const Value &val, char *storage) const {
+  TypeKernel<TypeId::BOOLEAN>::Serialize(val, storage);
+}
+
+Value BooleanType::DeserializeFrom(const char *storage) const {
+  bool raw_val;
+  std::memcpy(&raw_val, storage, sizeof(raw_val));
+  return Value(TypeId::BOOLEAN, raw_val);
+}
+
+bool BooleanType::CompareEquals(const Value &left, const Value &right) const {
+  return TypeKernel<TypeId::BOOLEAN>::Equals(left, right);
+}
+
+bool BooleanType::CompareLessThan(const Value &left, const Value &right) const {
+  return TypeKernel<TypeId::BOOLEAN>::LessThan(left, right);
+}
+
+uint64_t BooleanType::Hash(const Value &val) const {
+  return TypeKernel<TypeId::BOOLEAN>::Hash(val);
+}
+
+std::string BooleanType::ToString(const Value &val) const {
+  return val.GetAsBoolean() ? "true" : "false";
+}
+
+bool BooleanType::Parse(const std::string &str, bool *result) {
+  std::string lower(str);
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  if (lower == "true" || lower == "t" || lower == "1") {
+    *result = true;
+  } else if (lower == "false" || lower == "f" || lower == "0") {
+    *result = false;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace bustub
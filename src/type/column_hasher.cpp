@@ -0,0 +1,167 @@
+#include "type/column_hasher.h"
+
+#include <cstring>
+
+#include "common/exception.h"
+#include "common/hash_util.h"
+#include "storage/table/dictionary.h"
+#include "type/type_kernels.h"
+
+namespace bustub {
+
+namespace {
+inline void Store(uint64_t *slot, uint64_t hash, bool combine) {
+  *slot = combine ? HashUtil::CombineHashes(*slot, hash) : hash;
+}
+
+template <TypeId type_id>
+void HashTuplesImpl(const Schema *schema, uint32_t col_idx,
+                    const Tuple *tuples, std::size_t count, uint64_t *hashes,
+                    bool combine, BufferPoolManager *bpm) {
+  const Column &col = schema->GetColumn(col_idx);
+  uint32_t slot_offset = (schema->GetColumnCount() + 7) / 8 + col.GetOffset();
+  uint8_t null_mask = 1 << (col_idx % 8);
+  for (std::size_t i = 0; i < count; i++) {
+    const char *data = tuples[i].GetData();
+    uint64_t hash;
+    if (data[col_idx >> 3] & null_mask) {
+      hash = HashUtil::NULL_HASH;
+    } else if (col.IsInlined()) {
+      hash = TypeKernel<type_id>::HashRaw(data + slot_offset);
+    } else {
+      uint32_t heap_offset;
+      std::memcpy(&heap_offset, data + slot_offset, sizeof(heap_offset));
+      if (heap_offset & Tuple::EXTERNAL_FLAG) {
+        hash = tuples[i].GetValue(schema, col_idx, bpm).Hash();
+      } else {
+        hash = TypeKernel<type_id>::HashRaw(data + heap_offset);
+      }
+    }
+    Store(&hashes[i], hash, combine);
+  }
+}
+
+// 字典编码列：解码成字符串再哈希，和同值的普通 VARCHAR 哈希相同
+void HashDecodedImpl(const Schema *schema, uint32_t col_idx,
+                     const Tuple *tuples, std::size_t count, uint64_t *hashes,
+                     bool combine) {
+  const Column &col = schema->GetColumn(col_idx);
+  const Dictionary *dict = col.GetDictionary();
+  uint32_t slot_offset = (schema->GetColumnCount() + 7) / 8 + col.GetOffset();
+  uint8_t null_mask = 1 << (col_idx % 8);
+  for (std::size_t i = 0; i < count; i++) {
+    const char *data = tuples[i].GetData();
+    uint64_t hash = HashUtil::NULL_HASH;
+    if (!(data[col_idx >> 3] & null_mask)) {
+      uint32_t code;
+      std::memcpy(&code, data + slot_offset, sizeof(code));
+      std::string_view str = dict->Decode(code);
+      hash = HashUtil::HashBytes(str.data(), str.size());
+    }
+    Store(&hashes[i], hash, combine);
+  }
+}
+
+template <TypeId type_id>
+void HashFixedImpl(const char *values, uint32_t width,
+                   const uint8_t *null_bitmap, std::size_t count,
+                   uint64_t *hashes, bool combine) {
+  for (std::size_t i = 0; i < count; i++) {
+    uint64_t hash = null_bitmap != nullptr &&
+                            (null_bitmap[i >> 3] & (1 << (i % 8)))
+                        ? HashUtil::NULL_HASH
+                        : TypeKernel<type_id>::HashRaw(values + i * width);
+    Store(&hashes[i], hash, combine);
+  }
+}
+}  // namespace
+
+void ColumnHasher::HashTuples(const Schema *schema, uint32_t col_idx,
+                              const Tuple *tuples, std::size_t count,
+                              uint64_t *hashes, bool combine,
+                              BufferPoolManager *bpm) {
+  TypeId type_id = schema->GetColumn(col_idx).GetType();
+  if (schema->GetColumn(col_idx).IsDictEncoded()) {
+    return HashDecodedImpl(schema, col_idx, tuples, count, hashes, combine);
+  }
+  switch (type_id) {
+    case TypeId::INTEGER:
+      return HashTuplesImpl<TypeId::INTEGER>(schema, col_idx, tuples, count,
+                                             hashes, combine, bpm);
+    case TypeId::VARCHAR:
+      return HashTuplesImpl<TypeId::VARCHAR>(schema, col_idx, tuples, count,
+                                             hashes, combine, bpm);
+    case TypeId::BIGINT:
+      return HashTuplesImpl<TypeId::BIGINT>(schema, col_idx, tuples, count,
+                                            hashes, combine, bpm);
+    case TypeId::DOUBLE:
+      return HashTuplesImpl<TypeId::DOUBLE>(schema, col_idx, tuples, count,
+                                            hashes, combine, bpm);
+    case TypeId::BOOLEAN:
+      return HashTuplesImpl<TypeId::BOOLEAN>(schema, col_idx, tuples, count,
+                                             hashes, combine, bpm);
+    case TypeId::DATE:
+      return HashTuplesImpl<TypeId::DATE>(schema, col_idx, tuples, count,
+                                          hashes, combine, bpm);
+    case TypeId::TIMESTAMP:
+      return HashTuplesImpl<TypeId::TIMESTAMP>(schema, col_idx, tuples, count,
+                                               hashes, combine, bpm);
+    default:
+      throw Exception(ExceptionType::UNKNOWN_TYPE,
+                      "cannot hash type " + Type::TypeIdToString(type_id));
+  }
+}
+
+void ColumnHasher::HashDictCodes(const Schema *schema, uint32_t col_idx,
+                                 const Tuple *tuples, std::size_t count,
+                                 uint64_t *hashes, bool combine) {
+  const Column &col = schema->GetColumn(col_idx);
+  if (!col.IsDictEncoded()) {
+    throw Exception(ExceptionType::MISMATCH_TYPE,
+                    "column '" + col.GetName() + "' is not dictionary encoded");
+  }
+  uint32_t slot_offset = (schema->GetColumnCount() + 7) / 8 + col.GetOffset();
+  uint8_t null_mask = 1 << (col_idx % 8);
+  for (std::size_t i = 0; i < count; i++) {
+    const char *data = tuples[i].GetData();
+    uint64_t hash = HashUtil::NULL_HASH;
+    if (!(data[col_idx >> 3] & null_mask)) {
+      uint32_t code;
+      std::memcpy(&code, data + slot_offset, sizeof(code));
+      hash = HashUtil::HashInt(code);
+    }
+    Store(&hashes[i], hash, combine);
+  }
+}
+
+void ColumnHasher::HashFixed(TypeId type_id, const char *values,
+                             const uint8_t *null_bitmap, std::size_t count,
+                             uint64_t *hashes, bool combine) {
+  uint32_t width = GetFixedTypeSize(type_id);
+  switch (type_id) {
+    case TypeId::INTEGER:
+      return HashFixedImpl<TypeId::INTEGER>(values, width, null_bitmap, count,
+                                            hashes, combine);
+    case TypeId::BIGINT:
+      return HashFixedImpl<TypeId::BIGINT>(values, width, null_bitmap, count,
+                                           hashes, combine);
+    case TypeId::DOUBLE:
+      return HashFixedImpl<TypeId::DOUBLE>(values, width, null_bitmap, count,
+                                           hashes, combine);
+    case TypeId::BOOLEAN:
+      return HashFixedImpl<TypeId::BOOLEAN>(values, width, null_bitmap, count,
+                                            hashes, combine);
+    case TypeId::DATE:
+      return HashFixedImpl<TypeId::DATE>(values, width, null_bitmap, count,
+                                         hashes, combine);
+    case TypeId::TIMESTAMP:
+      return HashFixedImpl<TypeId::TIMESTAMP>(values, width, null_bitmap,
+                                              count, hashes, combine);
+    default:
+      throw Exception(ExceptionType::UNKNOWN_TYPE,
+                      "cannot hash fixed-width values of type " +
+                          Type::TypeIdToString(type_id));
+  }
+}
+
+}  // namespace bustub
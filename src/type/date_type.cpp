@@ -0,0 +1,92 @@
+#include "type/date_type.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "type/type_kernels.h"
+
+namespace bustub {
+
+// constructor
+DateType::DateType() : Type(TypeId::DATE) {
+  // nothing
+}
+
+void DateType::SerializeTo(const Value &val, char *storage) const {
+  TypeKernel<TypeId::DATE>::Serialize(val, storage);
+}
+
+Value DateType::DeserializeFrom(const char *storage) const {
+  int32_t raw_val;
+  std::memcpy(&raw_val, storage, sizeof(raw_val));
+  return Value(TypeId::DATE, raw_val);
+}
+
+bool DateType::CompareEquals(const Value &left, const Value &right) const {
+  return TypeKernel<TypeId::DATE>::Equals(left, right);
+}
+
+bool DateType::CompareLessThan(const Value &left, const Value &right) const {
+  return TypeKernel<TypeId::DATE>::LessThan(left, right);
+}
+
+uint64_t DateType::Hash(const Value &val) const {
+  return TypeKernel<TypeId::DATE>::Hash(val);
+}
+
+std::string DateType::ToString(const Value &val) const {
+  return Format(val.GetAsInteger());
+}
+
+// 算法见 Howard Hinnant, "chrono-Compatible Low-Level Date Algorithms"
+int32_t DateType::DaysFromCivil(int32_t year, uint32_t month, uint32_t day) {
+  year -= month <= 2;
+  const int32_t era = (year >= 0 ? year : year - 399) / 400;
+  const uint32_t yoe = static_cast<uint32_t>(year - era * 400);        // [0, 399]
+  const uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 +
+                       day - 1;                                        // [0, 365]
+  const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;          // [0, 146096]
+  return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+void DateType::CivilFromDays(int32_t days, int32_t *year, uint32_t *month,
+                             uint32_t *day) {
+  days += 719468;
+  const int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const uint32_t doe = static_cast<uint32_t>(days - era * 146097);
+  const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const uint32_t mp = (5 * doy + 2) / 153;
+  *day = doy - (153 * mp + 2) / 5 + 1;
+  *month = mp < 10 ? mp + 3 : mp - 9;
+  *year = static_cast<int32_t>(yoe) + era * 400 + (*month <= 2);
+}
+
+bool DateType::Parse(const std::string &str, int32_t *days) {
+  int year;
+  unsigned month, day;
+  int consumed = 0;
+  if (std::sscanf(str.c_str(), "%d-%u-%u%n", &year, &month, &day,
+                  &consumed) != 3 ||
+      static_cast<std::size_t>(consumed) != str.size()) {
+    return false;
+  }
+  if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+  *days = DaysFromCivil(year, month, day);
+  // 2 月 30 日之类的日期换算回来对不上
+  int32_t y;
+  uint32_t m, d;
+  CivilFromDays(*days, &y, &m, &d);
+  return y == year && m == month && d == day;
+}
+
+std::string DateType::Format(int32_t days) {
+  int32_t year;
+  uint32_t month, day;
+  CivilFromDays(days, &year, &month, &day);
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%04d-%02u-%02u", year, month, day);
+  return buf;
+}
+
+}  // namespace bustub
@@ -0,0 +1,44 @@
+#include "type/double_type.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "type/type_kernels.h"
+
+namespace bustub {
+
+// constructor
+DoubleType::DoubleType() : Type(TypeId::DOUBLE) {
+  // nothing
+}
+
+void DoubleType::SerializeTo(const Value &val, char *storage) const {
+  TypeKernel<TypeId::DOUBLE>::Serialize(val, storage);
+}
+
+Value DoubleType::DeserializeFrom(const char *storage) const {
+  double raw_val;
+  std::memcpy(&raw_val, storage, sizeof(raw_val));
+  return Value(raw_val);
+}
+
+bool DoubleType::CompareEquals(const Value &left, const Value &right) const {
+  return TypeKernel<TypeId::DOUBLE>::Equals(left, right);
+}
+
+bool DoubleType::CompareLessThan(const Value &left, const Value &right) const {
+  return TypeKernel<TypeId::DOUBLE>::LessThan(left, right);
+}
+
+uint64_t DoubleType::Hash(const Value &val) const {
+  return TypeKernel<TypeId::DOUBLE>::Hash(val);
+}
+
+std::string DoubleType::ToString(const Value &val) const {
+  // 最多 15 位有效数字，整数值不带小数点
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.15g", val.GetAsDouble());
+  return buf;
+}
+
+}  // namespace bustub
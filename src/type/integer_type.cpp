@@ -2,6 +2,8 @@
 
 #include <cstring>
 
+#include "type/type_kernels.h"
+
 namespace bustub {
 
 // constructor
@@ -11,8 +13,7 @@ IntegerType::IntegerType() : Type(TypeId::INTEGER) {
 
 // 获取Value内对应整数值，将整数值ccopy到对应内存中
 void IntegerType::SerializeTo(const Value &val, char *storage) const {
-  _integer raw_val = val.GetAsInteger();
-  memcpy(storage, &raw_val, sizeof(_integer));
+  TypeKernel<TypeId::INTEGER>::Serialize(val, storage);
 }
 
 // 将对应内存的值封装为Value
@@ -24,12 +25,16 @@ Value IntegerType::DeserializeFrom(const char *storage) const {
 
 bool IntegerType::CompareEquals(const Value &left,
                                 const Value &right) const {
-  return left.GetAsInteger() == right.GetAsInteger();
+  return TypeKernel<TypeId::INTEGER>::Equals(left, right);
 }
 
 bool IntegerType::CompareLessThan(const Value &left,
                                   const Value &right) const {
-  return left.GetAsInteger() < right.GetAsInteger();
+  return TypeKernel<TypeId::INTEGER>::LessThan(left, right);
+}
+
+uint64_t IntegerType::Hash(const Value &val) const {
+  return TypeKernel<TypeId::INTEGER>::Hash(val);
 }
 
 std::string IntegerType::ToString(const Value &val) const {
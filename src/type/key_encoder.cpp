@@ -0,0 +1,162 @@
+#include "type/key_encoder.h"
+
+#include <cstring>
+#include <utility>
+
+#include "common/exception.h"
+#include "storage/table/dictionary.h"
+
+namespace bustub {
+
+namespace {
+constexpr char kNullMarker = 0x00;
+constexpr char kValueMarker = 0x01;
+
+// 按大端写出低 bytes 个字节
+inline void AppendBigEndian(uint64_t bits, uint32_t bytes, std::string *out) {
+  for (uint32_t i = bytes; i > 0; i--) {
+    out->push_back(static_cast<char>((bits >> ((i - 1) * 8)) & 0xFF));
+  }
+}
+
+inline void EncodeString(const char *data, uint32_t len, std::string *out) {
+  out->reserve(out->size() + len + 2);
+  for (uint32_t i = 0; i < len; i++) {
+    out->push_back(data[i]);
+    if (data[i] == '\0') out->push_back(static_cast<char>(0xFF));
+  }
+  out->push_back('\0');
+  out->push_back('\0');
+}
+
+inline void Invert(std::string *out, std::size_t from) {
+  for (std::size_t i = from; i < out->size(); i++) {
+    (*out)[i] = static_cast<char>(~(*out)[i]);
+  }
+}
+}  // namespace
+
+KeyEncoder::KeyEncoder(const Schema *schema, std::vector<uint32_t> key_attrs,
+                       std::vector<bool> descending)
+    : schema_(schema),
+      key_attrs_(std::move(key_attrs)),
+      descending_(std::move(descending)) {
+  descending_.resize(key_attrs_.size(), false);
+}
+
+void KeyEncoder::EncodeNull(std::string *out, bool descending) {
+  out->push_back(descending ? static_cast<char>(~kNullMarker) : kNullMarker);
+}
+
+void KeyEncoder::EncodeRaw(TypeId type_id, const char *storage,
+                           std::string *out, bool descending) {
+  std::size_t start = out->size();
+  out->push_back(kValueMarker);
+  switch (type_id) {
+    case TypeId::INTEGER:
+    case TypeId::DATE: {
+      uint32_t bits;
+      std::memcpy(&bits, storage, sizeof(bits));
+      AppendBigEndian(bits ^ 0x80000000U, sizeof(bits), out);
+      break;
+    }
+    case TypeId::BIGINT:
+    case TypeId::TIMESTAMP: {
+      uint64_t bits;
+      std::memcpy(&bits, storage, sizeof(bits));
+      AppendBigEndian(bits ^ 0x8000000000000000ULL, sizeof(bits), out);
+      break;
+    }
+    case TypeId::DOUBLE: {
+      double val;
+      std::memcpy(&val, storage, sizeof(val));
+      if (val == 0) val = 0;  // -0.0 和 0.0 相等
+      uint64_t bits;
+      std::memcpy(&bits, &val, sizeof(bits));
+      bits = (bits & 0x8000000000000000ULL) ? ~bits
+                                             : bits ^ 0x8000000000000000ULL;
+      AppendBigEndian(bits, sizeof(bits), out);
+      break;
+    }
+    case TypeId::BOOLEAN:
+      out->push_back(*storage != 0 ? 1 : 0);
+      break;
+    case TypeId::VARCHAR: {
+      uint32_t len;
+      std::memcpy(&len, storage, sizeof(len));
+      EncodeString(storage + sizeof(len), len, out);
+      break;
+    }
+    default:
+      throw Exception(ExceptionType::UNKNOWN_TYPE,
+                      "cannot build a key from type " +
+                          Type::TypeIdToString(type_id));
+  }
+  if (descending) Invert(out, start);
+}
+
+void KeyEncoder::EncodeValue(const Value &val, std::string *out,
+                             bool descending) {
+  if (val.IsNull()) {
+    EncodeNull(out, descending);
+    return;
+  }
+  if (val.GetTypeId() == TypeId::VARCHAR) {
+    std::size_t start = out->size();
+    out->push_back(kValueMarker);
+    EncodeString(val.GetAsVarChar(), val.GetLogicLength(), out);
+    if (descending) Invert(out, start);
+    return;
+  }
+  // 定长值先按存储格式写出来，和 tuple 里读到的字节走同一条路
+  char storage[sizeof(int64_t)];
+  val.SerializeTo(storage);
+  EncodeRaw(val.GetTypeId(), storage, out, descending);
+}
+
+void KeyEncoder::EncodeValues(const std::vector<Value> &values,
+                              std::string *out) const {
+  for (std::size_t i = 0; i < key_attrs_.size(); i++) {
+    EncodeValue(values[i], out, descending_[i]);
+  }
+}
+
+void KeyEncoder::EncodeTuple(const Tuple &tuple, std::string *out,
+                             BufferPoolManager *bpm) const {
+  const char *data = tuple.GetData();
+  uint32_t bitmap_size = (schema_->GetColumnCount() + 7) / 8;
+  for (std::size_t i = 0; i < key_attrs_.size(); i++) {
+    uint32_t col_idx = key_attrs_[i];
+    const Column &col = schema_->GetColumn(col_idx);
+    if (data[col_idx >> 3] & (1 << (col_idx % 8))) {
+      EncodeNull(out, descending_[i]);
+      continue;
+    }
+    const char *val_ptr = data + bitmap_size + col.GetOffset();
+    if (col.IsDictEncoded()) {
+      // 字典编码不保持字符串顺序，按解码出的字符串编码
+      uint32_t code;
+      std::memcpy(&code, val_ptr, sizeof(code));
+      std::string_view str = col.GetDictionary()->Decode(code);
+      std::size_t start = out->size();
+      out->push_back(kValueMarker);
+      EncodeString(str.data(), static_cast<uint32_t>(str.size()), out);
+      if (descending_[i]) Invert(out, start);
+      continue;
+    }
+    if (!col.IsInlined()) {
+      uint32_t heap_offset;
+      std::memcpy(&heap_offset, val_ptr, sizeof(heap_offset));
+      if (heap_offset & Tuple::EXTERNAL_FLAG) {
+        // 溢出列少见，读出整个值再编码
+        EncodeValue(tuple.GetValue(schema_, col_idx, bpm), out,
+                    descending_[i]);
+        continue;
+      }
+      val_ptr = data + heap_offset;
+    }
+    EncodeRaw(col.GetType(), val_ptr, out, descending_[i]);
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,104 @@
+#include "type/timestamp_type.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "type/date_type.h"
+#include "type/type_kernels.h"
+
+namespace bustub {
+
+// constructor
+TimestampType::TimestampType() : Type(TypeId::TIMESTAMP) {
+  // nothing
+}
+
+void TimestampType::SerializeTo(const Value &val, char *storage) const {
+  TypeKernel<TypeId::TIMESTAMP>::Serialize(val, storage);
+}
+
+Value TimestampType::DeserializeFrom(const char *storage) const {
+  int64_t raw_val;
+  std::memcpy(&raw_val, storage, sizeof(raw_val));
+  return Value(TypeId::TIMESTAMP, raw_val);
+}
+
+bool TimestampType::CompareEquals(const Value &left, const Value &right) const {
+  return TypeKernel<TypeId::TIMESTAMP>::Equals(left, right);
+}
+
+bool TimestampType::CompareLessThan(const Value &left, const Value &right) const {
+  return TypeKernel<TypeId::TIMESTAMP>::LessThan(left, right);
+}
+
+uint64_t TimestampType::Hash(const Value &val) const {
+  return TypeKernel<TypeId::TIMESTAMP>::Hash(val);
+}
+
+std::string TimestampType::ToString(const Value &val) const {
+  return Format(val.GetAsBigInt());
+}
+
+namespace {
+constexpr int64_t kMicrosPerSecond = 1000000;
+constexpr int64_t kMicrosPerDay = 86400 * kMicrosPerSecond;
+}  // namespace
+
+bool TimestampType::Parse(const std::string &str, int64_t *micros) {
+  // 日期部分
+  std::size_t date_end = str.find_first_of(" T");
+  int32_t days;
+  if (!DateType::Parse(str.substr(0, date_end), &days)) return false;
+  *micros = days * kMicrosPerDay;
+  if (date_end == std::string::npos) return true;
+
+  // 时间部分 HH:MM:SS[.ffffff]
+  unsigned hour, minute, second;
+  int consumed = 0;
+  const char *time = str.c_str() + date_end + 1;
+  if (std::sscanf(time, "%u:%u:%u%n", &hour, &minute, &second, &consumed) !=
+          3 ||
+      hour > 23 || minute > 59 || second > 59) {
+    return false;
+  }
+  int64_t fraction = 0;
+  const char *rest = time + consumed;
+  if (*rest == '.') {
+    // 小数秒最多 6 位，不足的补 0
+    int digits = 0;
+    for (rest++; *rest >= '0' && *rest <= '9'; rest++) {
+      if (digits++ < 6) fraction = fraction * 10 + (*rest - '0');
+    }
+    if (digits == 0) return false;
+    for (; digits < 6; digits++) fraction *= 10;
+  }
+  if (*rest != '\0') return false;
+  *micros += (hour * 3600 + minute * 60 + second) * kMicrosPerSecond + fraction;
+  return true;
+}
+
+std::string TimestampType::Format(int64_t micros) {
+  // 向下取整到天，负数时间戳也能得到正确的时分秒
+  int64_t days = micros / kMicrosPerDay;
+  int64_t rem = micros % kMicrosPerDay;
+  if (rem < 0) {
+    rem += kMicrosPerDay;
+    days--;
+  }
+  int64_t seconds = rem / kMicrosPerSecond;
+  int64_t fraction = rem % kMicrosPerSecond;
+
+  char buf[48];
+  int len = std::snprintf(buf, sizeof(buf), "%s %02d:%02d:%02d",
+                          DateType::Format(static_cast<int32_t>(days)).c_str(),
+                          static_cast<int>(seconds / 3600),
+                          static_cast<int>(seconds / 60 % 60),
+                          static_cast<int>(seconds % 60));
+  if (fraction != 0) {
+    std::snprintf(buf + len, sizeof(buf) - len, ".%06d",
+                  static_cast<int>(fraction));
+  }
+  return buf;
+}
+
+}  // namespace bustub
@@ -1,6 +1,11 @@
 #include "type/type.h"
 
+#include "type/bigint_type.h"
+#include "type/boolean_type.h"
+#include "type/date_type.h"
+#include "type/double_type.h"
 #include "type/integer_type.h"
+#include "type/timestamp_type.h"
 #include "type/type_id.h"
 #include "type/varchar_type.h"
 
@@ -9,14 +14,50 @@ namespace bustub {
 Type* Type::GetInstance(TypeId type_id) {
   static IntegerType kIntegerType;
   static VarCharType kVarcharType;
+  static BigIntType kBigIntType;
+  static DoubleType kDoubleType;
+  static BooleanType kBooleanType;
+  static DateType kDateType;
+  static TimestampType kTimestampType;
 
   switch (type_id) {
     case TypeId::INTEGER:
       return &kIntegerType;
     case TypeId::VARCHAR:
       return &kVarcharType;
+    case TypeId::BIGINT:
+      return &kBigIntType;
+    case TypeId::DOUBLE:
+      return &kDoubleType;
+    case TypeId::BOOLEAN:
+      return &kBooleanType;
+    case TypeId::DATE:
+      return &kDateType;
+    case TypeId::TIMESTAMP:
+      return &kTimestampType;
     default:
       return nullptr;
   }
 }
+
+std::string Type::TypeIdToString(TypeId type_id) {
+  switch (type_id) {
+    case TypeId::INTEGER:
+      return "INT";
+    case TypeId::VARCHAR:
+      return "VARCHAR";
+    case TypeId::BIGINT:
+      return "BIGINT";
+    case TypeId::DOUBLE:
+      return "DOUBLE";
+    case TypeId::BOOLEAN:
+      return "BOOLEAN";
+    case TypeId::DATE:
+      return "DATE";
+    case TypeId::TIMESTAMP:
+      return "TIMESTAMP";
+    default:
+      return "UNKNOWN";
+  }
+}
 }  // namespace bustub
@@ -0,0 +1,45 @@
+#include "type/type_kernels.h"
+
+namespace bustub {
+
+namespace {
+template <TypeId type_id>
+constexpr ValueKernels MakeKernels() {
+  return ValueKernels{&TypeKernel<type_id>::Equals,
+                      &TypeKernel<type_id>::LessThan,
+                      &TypeKernel<type_id>::Serialize,
+                      &TypeKernel<type_id>::Hash,
+                      &TypeKernel<type_id>::HashRaw};
+}
+
+constexpr ValueKernels kIntegerKernels = MakeKernels<TypeId::INTEGER>();
+constexpr ValueKernels kVarcharKernels = MakeKernels<TypeId::VARCHAR>();
+constexpr ValueKernels kBigIntKernels = MakeKernels<TypeId::BIGINT>();
+constexpr ValueKernels kDoubleKernels = MakeKernels<TypeId::DOUBLE>();
+constexpr ValueKernels kBooleanKernels = MakeKernels<TypeId::BOOLEAN>();
+constexpr ValueKernels kDateKernels = MakeKernels<TypeId::DATE>();
+constexpr ValueKernels kTimestampKernels = MakeKernels<TypeId::TIMESTAMP>();
+}  // namespace
+
+const ValueKernels *ValueKernels::Get(TypeId type_id) {
+  switch (type_id) {
+    case TypeId::INTEGER:
+      return &kIntegerKernels;
+    case TypeId::VARCHAR:
+      return &kVarcharKernels;
+    case TypeId::BIGINT:
+      return &kBigIntKernels;
+    case TypeId::DOUBLE:
+      return &kDoubleKernels;
+    case TypeId::BOOLEAN:
+      return &kBooleanKernels;
+    case TypeId::DATE:
+      return &kDateKernels;
+    case TypeId::TIMESTAMP:
+      return &kTimestampKernels;
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace bustub
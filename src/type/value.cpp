@@ -1,76 +1,133 @@
 #include "type/value.h"
 
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <utility>
 
+#include "common/exception.h"
+#include "common/hash_util.h"
+#include "type/boolean_type.h"
+#include "type/date_type.h"
+#include "type/timestamp_type.h"
 #include "type/type_id.h"
+#include "type/type_kernels.h"
 
 namespace bustub {
 
 // 构造
+Value::Value(TypeId type_id)
+    : type_id_(type_id), storage_size_(0), logic_len_(0), is_null_(true) {
+  value_.integer_ = 0;
+}
 Value::Value(const int32_t integer)
-    : value_({integer}),
-      storage_size_(4),
-      type_id_(TypeId::INTEGER),
-      logic_len_(0) {}
-Value::Value(const std::string str)
-    : type_id_(TypeId::VARCHAR), logic_len_(str.size()) {
-  value_.varchar_ = new char[logic_len_ + 1];
-  std::memcpy(value_.varchar_, str.c_str(), logic_len_);
-  value_.varchar_[logic_len_] = '\0';
-  storage_size_ = logic_len_ + 4;  // 4 bytes union area + allocated heap data
+    : type_id_(TypeId::INTEGER), storage_size_(4), logic_len_(0) {
+  value_.integer_ = integer;
 }
-
-// 深拷贝
-Value::Value(const Value &other) {
-  if (this == &other) {
-    return;
+Value::Value(TypeId type_id, int64_t raw)
+    : type_id_(type_id), storage_size_(GetFixedTypeSize(type_id)),
+      logic_len_(0) {
+  value_.bigint_ = 0;
+  switch (type_id_) {
+    case TypeId::INTEGER:
+    case TypeId::DATE:
+      value_.integer_ = static_cast<int32_t>(raw);
+      break;
+    case TypeId::BOOLEAN:
+      value_.boolean_ = raw != 0;
+      break;
+    default:  // BIGINT / TIMESTAMP
+      value_.bigint_ = raw;
   }
+}
+Value::Value(const double decimal)
+    : type_id_(TypeId::DOUBLE), storage_size_(8), logic_len_(0) {
+  value_.decimal_ = decimal;
+}
+Value::Value(const std::string &str) : Value(str.data(), str.size()) {}
+Value::Value(const char *data, uint32_t len)
+    : type_id_(TypeId::VARCHAR), logic_len_(len) {
+  // 短字符串放进 union，长字符串才分配堆内存
+  char *dst = IsInlineVarChar() ? value_.inline_
+                                : (value_.varchar_ = new char[logic_len_ + 1]);
+  std::memcpy(dst, data, logic_len_);
+  dst[logic_len_] = '\0';
+  storage_size_ = logic_len_ + 4;  // 4 bytes length header + string data
+}
+
+void Value::CopyFrom(const Value &other) {
   type_id_ = other.type_id_;
   storage_size_ = other.storage_size_;
   logic_len_ = other.logic_len_;
-  if (type_id_ == VARCHAR) {
+  is_null_ = other.is_null_;
+  if (other.OwnsHeap()) {
     value_.varchar_ = new char[logic_len_ + 1];
-    memcpy(value_.varchar_, other.value_.varchar_, logic_len_ + 1);
+    std::memcpy(value_.varchar_, other.value_.varchar_, logic_len_ + 1);
   } else {
-    value_.integer_ = other.value_.integer_;
+    value_ = other.value_;  // 整数或内联字符串，按字节复制即可
+  }
+}
+
+void Value::MoveFrom(Value &&other) {
+  type_id_ = other.type_id_;
+  storage_size_ = other.storage_size_;
+  logic_len_ = other.logic_len_;
+  is_null_ = other.is_null_;
+  value_ = other.value_;
+  if (other.OwnsHeap()) {
+    // 堆内存归自己了，对方变成空串，析构时不会再释放
+    other.logic_len_ = 0;
+    other.storage_size_ = 4;
+    other.value_.inline_[0] = '\0';
   }
 }
+
+void Value::Release() {
+  if (OwnsHeap()) {
+    delete[] value_.varchar_;
+  }
+}
+
+// 深拷贝
+Value::Value(const Value &other) { CopyFrom(other); }
 Value& Value::operator=(const Value &other) {
   // 防止自赋值 (a = a)
   if (this == &other) {
     return *this;
   }
-
   // 如果自己之前有堆内存，先释放！(防止内存泄漏)
-  if (type_id_ == TypeId::VARCHAR && value_.varchar_ != nullptr) {
-    delete[] value_.varchar_;
-  }
-
-  // 复制元数据
-  type_id_ = other.type_id_;
-  storage_size_ = other.storage_size_;
-  logic_len_ = other.logic_len_;
+  Release();
+  CopyFrom(other);
+  return *this;
+}
 
-  // 深拷贝数据
-  if (type_id_ == TypeId::VARCHAR) {
-    value_.varchar_ = new char[logic_len_ + 1];
-    std::memcpy(value_.varchar_, other.value_.varchar_, logic_len_ + 1);
-  } else {
-    value_.integer_ = other.value_.integer_;
+// 移动
+Value::Value(Value &&other) noexcept { MoveFrom(std::move(other)); }
+Value& Value::operator=(Value &&other) noexcept {
+  if (this == &other) {
+    return *this;
   }
+  Release();
+  MoveFrom(std::move(other));
   return *this;
 }
 
 // 析构
-Value::~Value() {
-  if (type_id_ == VARCHAR && value_.varchar_ != nullptr) {
-    delete[] value_.varchar_;
-  }
-}
+Value::~Value() { Release(); }
 
 // === 核心逻辑：分发给单例Type ===
+// 常用类型直接走特化内核 (可内联)，其他类型仍分发给 Type 单例
 void Value::SerializeTo(char *storage) const {
-  Type::GetInstance(type_id_)->SerializeTo(*this, storage);
+  switch (type_id_) {
+    case TypeId::INTEGER:
+      return TypeKernel<TypeId::INTEGER>::Serialize(*this, storage);
+    case TypeId::VARCHAR:
+      return TypeKernel<TypeId::VARCHAR>::Serialize(*this, storage);
+    default:
+      Type::GetInstance(type_id_)->SerializeTo(*this, storage);
+  }
 }
 
 Value Value::DeserializeFrom(const char *storage, TypeId type_id) {
@@ -78,15 +135,155 @@ Value Value::DeserializeFrom(const char *storage, TypeId type_id) {
 }
 
 bool Value::CompareEquals(const Value &other) const {
-  return Type::GetInstance(type_id_)->CompareEquals(*this, other);
+  if (is_null_ || other.is_null_) return false;
+  switch (type_id_) {
+    case TypeId::INTEGER:
+      return TypeKernel<TypeId::INTEGER>::Equals(*this, other);
+    case TypeId::VARCHAR:
+      return TypeKernel<TypeId::VARCHAR>::Equals(*this, other);
+    default:
+      return Type::GetInstance(type_id_)->CompareEquals(*this, other);
+  }
 }
 
 bool Value::CompareLessThan(const Value &other) const {
-  return Type::GetInstance(type_id_)->CompareLessThan(*this, other);
+  if (is_null_ || other.is_null_) return false;
+  switch (type_id_) {
+    case TypeId::INTEGER:
+      return TypeKernel<TypeId::INTEGER>::LessThan(*this, other);
+    case TypeId::VARCHAR:
+      return TypeKernel<TypeId::VARCHAR>::LessThan(*this, other);
+    default:
+      return Type::GetInstance(type_id_)->CompareLessThan(*this, other);
+  }
+}
+
+uint64_t Value::Hash() const {
+  if (is_null_) return HashUtil::NULL_HASH;
+  switch (type_id_) {
+    case TypeId::INTEGER:
+      return TypeKernel<TypeId::INTEGER>::Hash(*this);
+    case TypeId::VARCHAR:
+      return TypeKernel<TypeId::VARCHAR>::Hash(*this);
+    default:
+      return Type::GetInstance(type_id_)->Hash(*this);
+  }
 }
 
 std::string Value::ToString() const {
+  if (is_null_) return "NULL";
   return Type::GetInstance(type_id_)->ToString(*this);
 }
 
-}  // namespace bustub
\ No newline at end of file
+namespace {
+inline bool IsIntegral(TypeId type_id) {
+  return type_id == TypeId::INTEGER || type_id == TypeId::BIGINT;
+}
+}  // namespace
+
+Value Value::CastAs(TypeId type_id) const {
+  if (is_null_) return Value(type_id);
+  if (type_id == type_id_) return *this;
+
+  auto fail = [&]() -> Exception {
+    return Exception(ExceptionType::CONVERSION,
+                     "cannot convert '" + ToString() + "' to " +
+                         Type::TypeIdToString(type_id));
+  };
+
+  // 任何类型都能转成字符串
+  if (type_id == TypeId::VARCHAR) return Value(ToString());
+
+  // 字符串按目标类型的文本格式解析
+  if (type_id_ == TypeId::VARCHAR) {
+    std::string str(GetAsVarChar(), logic_len_);
+    switch (type_id) {
+      case TypeId::INTEGER:
+      case TypeId::BIGINT: {
+        errno = 0;
+        char *end = nullptr;
+        long long raw = std::strtoll(str.c_str(), &end, 10);
+        if (str.empty() || *end != '\0' || errno == ERANGE) throw fail();
+        return Value(TypeId::BIGINT, raw).CastAs(type_id);
+      }
+      case TypeId::DOUBLE: {
+        char *end = nullptr;
+        double raw = std::strtod(str.c_str(), &end);
+        if (str.empty() || *end != '\0') throw fail();
+        return Value(raw);
+      }
+      case TypeId::BOOLEAN: {
+        bool raw;
+        if (!BooleanType::Parse(str, &raw)) throw fail();
+        return Value(TypeId::BOOLEAN, raw);
+      }
+      case TypeId::DATE: {
+        int32_t days;
+        if (!DateType::Parse(str, &days)) throw fail();
+        return Value(TypeId::DATE, days);
+      }
+      case TypeId::TIMESTAMP: {
+        int64_t micros;
+        if (!TimestampType::Parse(str, &micros)) throw fail();
+        return Value(TypeId::TIMESTAMP, micros);
+      }
+      default:
+        throw fail();
+    }
+  }
+
+  // 数值之间的转换：先统一成 int64 / double
+  int64_t raw = 0;
+  double decimal = 0;
+  bool is_decimal = false;
+  switch (type_id_) {
+    case TypeId::INTEGER:
+      raw = value_.integer_;
+      break;
+    case TypeId::BIGINT:
+      raw = value_.bigint_;
+      break;
+    case TypeId::BOOLEAN:
+      raw = value_.boolean_;
+      break;
+    case TypeId::DOUBLE:
+      decimal = value_.decimal_;
+      is_decimal = true;
+      break;
+    case TypeId::DATE:
+      // 日期 -> 当天零点
+      if (type_id != TypeId::TIMESTAMP) throw fail();
+      return Value(TypeId::TIMESTAMP,
+                   static_cast<int64_t>(value_.integer_) * 86400 * 1000000);
+    default:
+      throw fail();
+  }
+
+  switch (type_id) {
+    case TypeId::DOUBLE:
+      return Value(is_decimal ? decimal : static_cast<double>(raw));
+    case TypeId::INTEGER:
+    case TypeId::BIGINT: {
+      if (is_decimal) {
+        // 截断小数部分，超出 int64 范围的拒绝
+        if (!std::isfinite(decimal) || std::fabs(decimal) >= 9.2e18) {
+          throw fail();
+        }
+        raw = static_cast<int64_t>(decimal);
+      }
+      if (type_id == TypeId::INTEGER &&
+          (raw < std::numeric_limits<int32_t>::min() ||
+           raw > std::numeric_limits<int32_t>::max())) {
+        throw Exception(ExceptionType::OUT_OF_RANGE,
+                        "value " + ToString() + " is out of range for INT");
+      }
+      return Value(type_id, raw);
+    }
+    case TypeId::BOOLEAN:
+      return Value(TypeId::BOOLEAN, is_decimal ? decimal != 0 : raw != 0);
+    default:
+      throw fail();
+  }
+}
+
+}  // namespace bustub